@@ -0,0 +1,109 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Flint/Backend/StaticModel.hpp"
+#include "Flint/Backend/CookedStaticModel.hpp"
+
+#include "Flint/Engine/Flint.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+
+/**
+ * Measure the time taken to load a model.
+ * The model is loaded multiple times and the fastest time is returned, so the file system cache and the driver warm up do not affect the results.
+ *
+ * @param pDevice The device to load the model with.
+ * @param path The model path.
+ * @param iterations The number of times to load the model.
+ * @param pModel The variable to store the last loaded model.
+ * @return The fastest load time in milliseconds.
+ */
+double MeasureLoadTime(const std::shared_ptr<Flint::Backend::Device>& pDevice, const std::filesystem::path& path, uint32_t iterations, std::shared_ptr<Flint::Backend::StaticModel>& pModel)
+{
+	auto fastest = std::chrono::duration<double, std::milli>::max();
+	for (uint32_t i = 0; i < iterations; i++)
+	{
+		pModel.reset();
+
+		const auto start = std::chrono::high_resolution_clock::now();
+		pModel = pDevice->createStaticModel(std::filesystem::path(path));
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		fastest = std::min<std::chrono::duration<double, std::milli>>(fastest, end - start);
+	}
+
+	return fastest.count();
+}
+
+/**
+ * Model loader benchmark.
+ * This imports every glTF model in the bundled glTF-Sample-Models, compiles it to the cooked format and loads the cooked file, and reports the time
+ * taken by both loaders.
+ *
+ * Usage: ModelLoaderBenchmark [iterations] [cooked output directory]
+ */
+int main(int argc, char** argv)
+{
+	const uint32_t iterations = argc > 1 ? std::stoul(argv[1]) : 3;
+	const auto cookedDirectory = std::filesystem::path(argc > 2 ? argv[2] : "CookedModels");
+	std::filesystem::create_directories(cookedDirectory);
+
+	auto pInstance = Flint::CreateInstance("ModelLoaderBenchmark", 1, false);
+	auto pDevice = pInstance->createDevice();
+
+	spdlog::info("{:<40} {:>8} {:>12} {:>14} {:>14}", "Model", "Meshes", "Vertices", "Import (ms)", "Cooked (ms)");
+
+	double totalImportTime = 0.0;
+	double totalCookedTime = 0.0;
+	for (const auto& entry : std::filesystem::directory_iterator(FLINT_GLTF_ASSET_PATH))
+	{
+		const auto name = entry.path().filename().string();
+		const auto assetPath = entry.path() / "glTF" / (name + ".gltf");
+		if (!std::filesystem::exists(assetPath))
+			continue;
+
+		try
+		{
+			std::shared_ptr<Flint::Backend::StaticModel> pModel = nullptr;
+			const auto importTime = MeasureLoadTime(pDevice, assetPath, iterations, pModel);
+
+			uint64_t vertexCount = 0;
+			for (const auto& mesh : pModel->getMeshes())
+				vertexCount += mesh.m_VertexCount;
+
+			// Cook the model and load it again.
+			const auto cookedPath = cookedDirectory / (name + Flint::Backend::CookedStaticModel::Extension);
+			{
+				const auto bytes = pModel->compile();
+				std::ofstream cookedFile(cookedPath, std::ios::out | std::ios::binary);
+				cookedFile.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+			}
+
+			const auto meshCount = pModel->getMeshes().size();
+			pModel->terminate();
+
+			const auto cookedTime = MeasureLoadTime(pDevice, cookedPath, iterations, pModel);
+			pModel->terminate();
+
+			totalImportTime += importTime;
+			totalCookedTime += cookedTime;
+
+			spdlog::info("{:<40} {:>8} {:>12} {:>14.3f} {:>14.3f}", name, meshCount, vertexCount, importTime, cookedTime);
+		}
+		catch (const std::exception& error)
+		{
+			spdlog::warn("{:<40} Failed to load: {}", name, error.what());
+		}
+	}
+
+	spdlog::info("{:<40} {:>8} {:>12} {:>14.3f} {:>14.3f}", "Total", "", "", totalImportTime, totalCookedTime);
+
+	pDevice->terminate();
+	pInstance->terminate();
+
+	return 0;
+}
\ No newline at end of file
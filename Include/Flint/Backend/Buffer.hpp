@@ -76,9 +76,18 @@ namespace Flint
 			 */
 			[[nodiscard]] BufferUsage getUsage() const { return m_Usage; }
 
+			/**
+			 * Get the bindless index of the buffer.
+			 * This is the index used to access the buffer from the bindless descriptor arrays in shaders.
+			 *
+			 * @return The bindless index. This will be InvalidBindlessIndex if the buffer is not a storage buffer or if bindless is not supported.
+			 */
+			[[nodiscard]] uint32_t getBindlessIndex() const { return m_BindlessIndex; }
+
 		protected:
 			const uint64_t m_Size;
 			const BufferUsage m_Usage;
+			uint32_t m_BindlessIndex = InvalidBindlessIndex;
 		};
 	}
 }
\ No newline at end of file
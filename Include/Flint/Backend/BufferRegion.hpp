@@ -0,0 +1,129 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Buffer.hpp"
+
+#include <map>
+#include <mutex>
+
+namespace Flint
+{
+	namespace Backend
+	{
+		/**
+		 * Buffer region structure.
+		 * This is a handle to an aligned range within a larger backing buffer, allocated by the buffer allocator.
+		 *
+		 * When a region is bound to a dynamic uniform or storage buffer binding, the offset is passed to the descriptor at draw time, which means that all the regions
+		 * of the same backing buffer can share a single descriptor set.
+		 */
+		struct BufferRegion final
+		{
+			/**
+			 * Copy data from a raw data pointer to the region.
+			 *
+			 * @param pData The data pointer.
+			 * @param size The size of the data to be copied. Make sure that it's less than or equal to the region's size.
+			 */
+			void copyFrom(const std::byte* pData, uint64_t size) const { m_pBuffer->copyFrom(pData, size, 0, m_Offset); }
+
+			/**
+			 * Check if the region is valid.
+			 *
+			 * @return Whether or not the region points to a buffer.
+			 */
+			[[nodiscard]] bool isValid() const { return m_pBuffer != nullptr && m_Size > 0; }
+
+			std::shared_ptr<Buffer> m_pBuffer = nullptr;
+			uint64_t m_Offset = 0;
+			uint64_t m_Size = 0;
+		};
+
+		/**
+		 * Buffer allocator class.
+		 * This class carves aligned buffer regions out of large backing buffers, so that many small uniform or storage buffers can live inside a few Vulkan buffers
+		 * and allocations.
+		 */
+		class BufferAllocator final : public DeviceBoundObject
+		{
+			/**
+			 * Block structure.
+			 * A block is a single backing buffer with it's free ranges (offset -> size).
+			 */
+			struct Block final
+			{
+				std::shared_ptr<Buffer> m_pBuffer = nullptr;
+				std::map<uint64_t, uint64_t> m_FreeRanges;
+			};
+
+		public:
+			/**
+			 * Explicit constructor.
+			 *
+			 * @param pDevice The device to which the allocator is bound to.
+			 * @param usage The usage of the backing buffers.
+			 * @param blockSize The size of a single backing buffer. Default is 1 MiB.
+			 */
+			explicit BufferAllocator(const std::shared_ptr<Device>& pDevice, BufferUsage usage, uint64_t blockSize = 1024 * 1024);
+
+			/**
+			 * Destructor.
+			 */
+			~BufferAllocator() override;
+
+			/**
+			 * Terminate the object.
+			 * Note that the backing buffers will live as long as there are regions referring them.
+			 */
+			void terminate() override;
+
+			/**
+			 * Allocate a new region.
+			 *
+			 * @param size The size of the region.
+			 * @return The allocated region.
+			 */
+			[[nodiscard]] BufferRegion allocate(uint64_t size);
+
+			/**
+			 * Return a region back to the allocator.
+			 *
+			 * @param region The region to free.
+			 */
+			void free(const BufferRegion& region);
+
+			/**
+			 * Get the offset alignment of the regions.
+			 *
+			 * @return The alignment.
+			 */
+			[[nodiscard]] uint64_t getAlignment() const { return m_Alignment; }
+
+			/**
+			 * Get the usage of the backing buffers.
+			 *
+			 * @return The buffer usage.
+			 */
+			[[nodiscard]] BufferUsage getUsage() const { return m_Usage; }
+
+		private:
+			/**
+			 * Create a new block.
+			 *
+			 * @param size The size of the block.
+			 * @return The created block reference.
+			 */
+			Block& createBlock(uint64_t size);
+
+		private:
+			std::vector<Block> m_Blocks;
+			std::mutex m_Mutex;
+
+			const uint64_t m_BlockSize = 0;
+			const uint64_t m_Alignment = 1;
+			const BufferUsage m_Usage = BufferUsage::Uniform;
+		};
+	}
+}
@@ -4,6 +4,8 @@
 #pragma once
 
 #include "Pipeline.hpp"
+#include "ComputeProgram.hpp"
+#include "MeshBindingTable.hpp"
 
 namespace Flint
 {
@@ -12,6 +14,10 @@ namespace Flint
 		/**
 		 * Compute pipeline class.
 		 * This class is used to perform compute operations.
+		 *
+		 * Resources are bound by registering a binding table, which returns a handle that is later used to dispatch. Dispatches are executed on the
+		 * device's compute queue, asynchronously to the rendering. Graphics work which is submitted after a dispatch waits for it, so the results can be
+		 * consumed by the next frame without any explicit synchronization.
 		 */
 		class ComputePipeline : public Pipeline
 		{
@@ -20,14 +26,54 @@ namespace Flint
 			 * Explicit constructor.
 			 *
 			 * @param pDevice The device pointer.
+			 * @param pProgram The compute program used in the pipeline.
 			 * @param pCacheHandler The pipeline cache handler used to handle the pipeline cache. Default is nullptr.
 			 */
-			explicit ComputePipeline(const std::shared_ptr<Device>& pDevice, std::unique_ptr<PipelineCacheHandler>&& pCacheHandler = nullptr) : Pipeline(pDevice, std::move(pCacheHandler)) {}
+			explicit ComputePipeline(const std::shared_ptr<Device>& pDevice, const std::shared_ptr<ComputeProgram>& pProgram, std::unique_ptr<PipelineCacheHandler>&& pCacheHandler = nullptr)
+				: Pipeline(pDevice, std::move(pCacheHandler)), m_pProgram(pProgram) {}
 
 			/**
 			 * Default virtual destructor.
 			 */
 			virtual ~ComputePipeline() = default;
+
+			/**
+			 * Register a binding table to the pipeline.
+			 * Registering the same resources and constants again returns the same handle.
+			 *
+			 * @param table The binding table containing the resources and the constants.
+			 * @return The handle used to dispatch using the table.
+			 */
+			[[nodiscard]] virtual uint64_t registerTable(const MeshBindingTable& table) = 0;
+
+			/**
+			 * Dispatch the compute shader.
+			 *
+			 * @param table The handle of the registered table to use.
+			 * @param groupCountX The number of work groups in the X dimension.
+			 * @param groupCountY The number of work groups in the Y dimension. Default is 1.
+			 * @param groupCountZ The number of work groups in the Z dimension. Default is 1.
+			 */
+			virtual void dispatch(uint64_t table, uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1) = 0;
+
+			/**
+			 * Dispatch the compute shader using the group counts stored in a buffer.
+			 *
+			 * @param table The handle of the registered table to use.
+			 * @param pBuffer The buffer containing the X, Y and Z group counts as three 32-bit unsigned integers. This must be an indirect buffer.
+			 * @param offset The byte offset of the group counts in the buffer. Default is 0.
+			 */
+			virtual void dispatchIndirect(uint64_t table, const std::shared_ptr<Buffer>& pBuffer, uint64_t offset = 0) = 0;
+
+			/**
+			 * Get the program pointer.
+			 *
+			 * @return The pointer.
+			 */
+			[[nodiscard]] const ComputeProgram* getProgram() const { return m_pProgram.get(); }
+
+		protected:
+			std::shared_ptr<ComputeProgram> m_pProgram = nullptr;
 		};
 	}
 }
\ No newline at end of file
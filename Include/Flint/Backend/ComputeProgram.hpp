@@ -0,0 +1,57 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Program.hpp"
+#include "ShaderCode.hpp"
+
+#include <array>
+
+namespace Flint
+{
+	namespace Backend
+	{
+		/**
+		 * Compute program class.
+		 * This class contains the compute pipeline's program which can be passed to compute pipelines.
+		 */
+		class ComputeProgram : public Program
+		{
+		public:
+			/**
+			 * Explicit constructor.
+			 *
+			 * @param pDevice The device to which the program is bound to.
+			 * @param computeShader The compute shader source.
+			 */
+			explicit ComputeProgram(const std::shared_ptr<Device>& pDevice, ShaderCode&& computeShader)
+				: Program(pDevice), m_ComputeShader(std::move(computeShader)) {}
+
+			/**
+			 * Virtual default destructor.
+			 */
+			virtual ~ComputeProgram() = default;
+
+			/**
+			 * Get the compute shader.
+			 *
+			 * @return The shader code.
+			 */
+			[[nodiscard]] const ShaderCode& getComputeShader() const { return m_ComputeShader; }
+
+			/**
+			 * Get the work group size declared by the compute shader.
+			 * This can be used to compute the number of groups to dispatch.
+			 *
+			 * @return The X, Y and Z sizes.
+			 */
+			[[nodiscard]] const std::array<uint32_t, 3>& getWorkGroupSize() const { return m_WorkGroupSize; }
+
+		protected:
+			ShaderCode m_ComputeShader;
+
+			std::array<uint32_t, 3> m_WorkGroupSize = { 1, 1, 1 };
+		};
+	}
+}
\ No newline at end of file
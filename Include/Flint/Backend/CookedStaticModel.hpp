@@ -0,0 +1,151 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "StaticModel.hpp"
+
+#include <type_traits>
+
+namespace Flint
+{
+	namespace Backend
+	{
+		/**
+		 * Cooked static model format.
+		 * This is the binary format produced by StaticModel::compile(). It stores the model's data exactly as they are uploaded to the GPU, so a cooked
+		 * model can be loaded by mapping the file and copying the blobs to the staging buffers without any per-vertex processing.
+		 *
+		 * The file starts with the header, and all the other sections are referenced by the header as blobs. Each blob starts at an offset aligned to
+		 * BlobAlignment. All the values are little endian.
+		 */
+		namespace CookedStaticModel
+		{
+			/**
+			 * The file extension used by cooked static models.
+			 */
+			constexpr const char* Extension = ".fsm";
+
+			/**
+			 * The magic characters at the start of the file.
+			 */
+			constexpr std::array<char, 8> Magic = { 'F', 'L', 'I', 'N', 'T', 'S', 'M', '\0' };
+
+			/**
+			 * The current version of the format. This needs to be incremented whenever the format changes.
+			 */
+			constexpr uint32_t Version = 1;
+
+			/**
+			 * The alignment of the blobs within the file.
+			 */
+			constexpr uint64_t BlobAlignment = 256;
+
+			/**
+			 * Blob structure.
+			 * This references a section of the file.
+			 */
+			struct Blob final
+			{
+				uint64_t m_Offset = 0;	// Bytes, from the start of the file.
+				uint64_t m_Size = 0;	// Bytes.
+			};
+
+			/**
+			 * Range structure.
+			 * This references a set of elements in a table.
+			 */
+			struct Range final
+			{
+				uint64_t m_First = 0;
+				uint64_t m_Count = 0;
+			};
+
+			/**
+			 * Attribute entry structure.
+			 * This is the cooked version of StaticMesh::AttributeData.
+			 */
+			struct AttributeEntry final
+			{
+				uint64_t m_Stride = 0;	// Bytes.
+				uint64_t m_Size = 0;	// Bytes.
+				uint64_t m_Offset = 0;	// Bytes, relative to the start of the attribute's blob.
+			};
+
+			/**
+			 * Level of detail entry structure.
+			 * This is the cooked version of StaticMesh::LevelOfDetail.
+			 */
+			struct LevelOfDetailEntry final
+			{
+				uint64_t m_IndexOffset = 0;
+				uint64_t m_IndexCount = 0;
+				float m_Error = 0.0f;
+				uint32_t m_Padding = 0;
+			};
+
+			/**
+			 * Mesh entry structure.
+			 * This is the cooked version of a single static mesh.
+			 */
+			struct MeshEntry final
+			{
+				std::array<AttributeEntry, EnumToInt(VertexAttribute::Max)> m_VertexData = {};
+				std::array<Range, EnumToInt(TextureType::Max)> m_TexturePaths = {};	// Ranges in the string blob.
+				Range m_Name = {};	// Range in the string blob.
+
+				std::array<float, 3> m_PositionOffset = {};
+				std::array<float, 3> m_PositionScale = {};
+				std::array<float, 3> m_BoundingCenter = {};
+				float m_BoundingRadius = 0.0f;
+
+				uint64_t m_VertexCount = 0;
+				uint64_t m_VertexOffset = 0;
+
+				uint64_t m_IndexOffset = 0;
+				uint64_t m_IndexCount = 0;
+				uint32_t m_IndexType = 0;
+				uint32_t m_Padding = 0;
+
+				VertexCacheStatistics m_UnoptimizedCacheStatistics = {};
+				VertexCacheStatistics m_CacheStatistics = {};
+
+				Range m_LevelsOfDetail = {};	// Range in the level of detail table.
+				Range m_Meshlets = {};			// Range in the meshlet table.
+			};
+
+			/**
+			 * Header structure.
+			 */
+			struct Header final
+			{
+				std::array<char, 8> m_Magic = Magic;
+				uint32_t m_Version = Version;
+				uint32_t m_MeshCount = 0;
+
+				uint64_t m_ContentHash = 0;	// The XXH64 hash of everything after the header.
+
+				uint32_t m_MemoryType = 0;
+				uint32_t m_FormatProfile = 0;
+				uint32_t m_VertexStride = 0;
+				uint32_t m_Padding = 0;
+
+				std::array<uint32_t, EnumToInt(VertexAttribute::Max)> m_AttributeOffsets = {};	// The interleaved vertex layout.
+				std::array<Blob, EnumToInt(VertexAttribute::Max)> m_AttributeBlobs = {};
+
+				Blob m_IndexBlob = {};
+				Blob m_MeshTable = {};
+				Blob m_LevelOfDetailTable = {};
+				Blob m_MeshletTable = {};
+				Blob m_StringBlob = {};
+			};
+
+			// The structures are written to the file as they are, so they must not contain any padding.
+			static_assert(std::has_unique_object_representations_v<AttributeEntry>);
+			static_assert(std::has_unique_object_representations_v<Header>);
+			static_assert(sizeof(LevelOfDetailEntry) == sizeof(uint64_t) * 2 + sizeof(float) + sizeof(uint32_t));
+			static_assert(sizeof(MeshEntry) == sizeof(AttributeEntry) * EnumToInt(VertexAttribute::Max) + sizeof(Range) * (EnumToInt(TextureType::Max) + 3) + sizeof(float) * 10 + sizeof(uint64_t) * 4 + sizeof(uint32_t) * 2 + sizeof(VertexCacheStatistics) * 2);
+			static_assert(sizeof(Meshlet) == sizeof(float) * 8 + sizeof(uint32_t) * 3);
+		}
+	}
+}
\ No newline at end of file
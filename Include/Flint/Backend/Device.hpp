@@ -6,6 +6,7 @@
 #include "Instance.hpp"
 #include "Types.hpp"
 #include "ShaderCode.hpp"
+#include "PipelineCacheHandler.hpp"
 
 #include "Flint/Core/Camera/Camera.hpp"
 
@@ -18,11 +19,19 @@ namespace Flint
 		class RayTracer;
 		class Window;
 		class RasterizingProgram;
+		class ComputeProgram;
+		class ComputePipeline;
 		class StaticModel;
 		class Texture2D;
 		class TextureSampler;
 		class CommandBuffers;
 
+		/**
+		 * Invalid bindless index.
+		 * Resources which are not registered in the bindless descriptor have this as their bindless index.
+		 */
+		constexpr uint32_t InvalidBindlessIndex = -1;
+
 		/**
 		 * Device class.
 		 * This class contains everything that's needed for a single device instance.
@@ -100,13 +109,33 @@ namespace Flint
 			 */
 			[[nodiscard]] virtual std::shared_ptr<RasterizingProgram> createRasterizingProgram(ShaderCode&& vertexShader, ShaderCode&& fragementShader) = 0;
 
+			/**
+			 * Create a new compute program.
+			 *
+			 * @param computeShader The compute shader code.
+			 * @return The compute program pointer.
+			 */
+			[[nodiscard]] virtual std::shared_ptr<ComputeProgram> createComputeProgram(ShaderCode&& computeShader) = 0;
+
+			/**
+			 * Create a new compute pipeline.
+			 *
+			 * @param pProgram The compute program used by the pipeline.
+			 * @param pCacheHandler The pipeline cache handler. Default is nullptr.
+			 * @return The compute pipeline pointer.
+			 */
+			[[nodiscard]] virtual std::shared_ptr<ComputePipeline> createComputePipeline(const std::shared_ptr<ComputeProgram>& pProgram, std::unique_ptr<PipelineCacheHandler>&& pCacheHandler = nullptr) = 0;
+
 			/**
 			 * Create a new static model.
 			 *
 			 * @param assetFile The asset file to load the data from.
+			 * @param memoryType The memory type used to store the vertex data. Default is exclusive.
+			 * @param vertexLayout The vertex inputs to pack when using the interleaved memory type, usually the program's vertex inputs. If empty, all the attributes in the asset are packed. Default is empty.
+			 * @param formatProfile The formats used to store the vertex attributes. Default is full.
 			 * @return The loaded static model.
 			 */
-			[[nodiscard]] virtual std::shared_ptr<StaticModel> createStaticModel(std::filesystem::path&& assetFile) = 0;
+			[[nodiscard]] virtual std::shared_ptr<StaticModel> createStaticModel(std::filesystem::path&& assetFile, VertexMemoryType memoryType = VertexMemoryType::Exclusive, std::vector<VertexInput>&& vertexLayout = {}, VertexFormatProfile formatProfile = VertexFormatProfile::Full) = 0;
 
 			/**
 			 * Create a new 2D texture image.
@@ -151,6 +180,38 @@ namespace Flint
 			 */
 			[[nodiscard]] virtual Multisample getMaximumMultisample() const = 0;
 
+			/**
+			 * Get the minimum offset alignment required when binding a range of a buffer.
+			 *
+			 * @param usage The buffer usage.
+			 * @return The alignment in bytes.
+			 */
+			[[nodiscard]] virtual uint64_t getBufferAlignment(BufferUsage usage) const = 0;
+
+			/**
+			 * Check if the device supports bindless resources.
+			 * If supported, texture views, samplers and storage buffers are given a stable bindless index when they are created.
+			 *
+			 * @return Whether or not bindless resources are supported.
+			 */
+			[[nodiscard]] virtual bool isBindlessSupported() const = 0;
+
+			/**
+			 * Set the shader cache handler.
+			 * The reflection results of the shaders are stored using this handler, so the programs created by the later sessions don't need to reflect
+			 * their shaders again. This should be set before creating any programs.
+			 *
+			 * @param pCacheHandler The cache handler. This can be nullptr to disable the cache.
+			 */
+			void setShaderCacheHandler(std::unique_ptr<PipelineCacheHandler>&& pCacheHandler) { m_pShaderCacheHandler = std::move(pCacheHandler); }
+
+			/**
+			 * Get the shader cache handler.
+			 *
+			 * @return The cache handler pointer. This is nullptr if the cache handler is not set.
+			 */
+			[[nodiscard]] PipelineCacheHandler* getShaderCacheHandler() const { return m_pShaderCacheHandler.get(); }
+
 			/**
 			 * Get the instance.
 			 *
@@ -167,6 +228,7 @@ namespace Flint
 
 		private:
 			std::shared_ptr<Instance> m_pInstance = nullptr;
+			std::unique_ptr<PipelineCacheHandler> m_pShaderCacheHandler = nullptr;
 		};
 	}
 }
\ No newline at end of file
@@ -8,6 +8,8 @@
 
 namespace Flint
 {
+	class Camera;
+
 	namespace Backend
 	{
 		/**
@@ -46,6 +48,16 @@ namespace Flint
 			 */
 			[[nodiscard]] virtual DrawInstance instance(const glm::vec3& position = glm::vec3(0.0f), const glm::vec3& rotation = glm::vec3(0.0f), const glm::vec3& scale = glm::vec3(1.0f)) = 0;
 
+			/**
+			 * Select the level of detail of each instance.
+			 * The lowest detailed level whose simplification error projects to at most the threshold on the screen is selected. This needs to be called
+			 * whenever the camera or the instances move.
+			 *
+			 * @param camera The camera which is used to render the instances.
+			 * @param threshold The maximum allowed error in pixels. Default is 1.
+			 */
+			virtual void selectLevelsOfDetail(const Camera& camera, float threshold = 1.0f) = 0;
+
 			/**
 			 * Get the entity pointer.
 			 *
@@ -0,0 +1,155 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Flint/Backend/Types.hpp"
+#include "Flint/Core/Containers/MappedFile.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Flint
+{
+	namespace Backend
+	{
+		/**
+		 * Native glTF 2.0 loader.
+		 * This loads .gltf and .glb files without going through an importer's scene graph. The buffers are memory mapped and the accessors point straight into
+		 * them, so the vertex and index data are only touched once, when they are decoded to the staging memory.
+		 */
+		namespace GLTF
+		{
+			/**
+			 * Invalid index.
+			 * Optional indices (like a primitive's material) which are not present have this value.
+			 */
+			constexpr uint32_t InvalidIndex = -1;
+
+			/**
+			 * Accessor structure.
+			 * This is a typed view of the elements stored in a buffer.
+			 */
+			struct Accessor final
+			{
+				/**
+				 * Check if the accessor is present.
+				 *
+				 * @return Whether the accessor points to some data.
+				 */
+				[[nodiscard]] bool isValid() const { return m_pData != nullptr; }
+
+				const std::byte* m_pData = nullptr;	// Points to the first element.
+				uint64_t m_Count = 0;
+				uint32_t m_Stride = 0;	// Bytes between two consecutive elements.
+				uint32_t m_ComponentType = 0;	// The glTF component type (5120 to 5126).
+				uint8_t m_ComponentCount = 0;
+				bool m_IsNormalized = false;
+			};
+
+			/**
+			 * Material structure.
+			 * This contains the texture paths of a material. Textures which are not present, or are embedded in a buffer, have an empty path.
+			 */
+			struct Material final
+			{
+				std::filesystem::path m_BaseColorTexture;
+				std::filesystem::path m_MetallicRoughnessTexture;
+				std::filesystem::path m_SheenColorTexture;
+				std::filesystem::path m_SheenRoughnessTexture;
+				std::filesystem::path m_ClearCoatTexture;
+				std::filesystem::path m_ClearCoatRoughnessTexture;
+				std::filesystem::path m_ClearCoatNormalTexture;
+				std::filesystem::path m_TransmissionTexture;
+				std::filesystem::path m_ThicknessTexture;
+			};
+
+			/**
+			 * Primitive structure.
+			 * Each primitive of a glTF mesh is loaded as a separate mesh, like the other importers do.
+			 */
+			struct Primitive final
+			{
+				std::string m_Name;
+
+				std::array<Accessor, EnumToInt(VertexAttribute::Max)> m_Attributes = {};	// The tangent accessor contains 4 components, the last being the bi-tangent sign. The bi-tangent accessor is never present.
+				Accessor m_Indices = {};	// This is not present for non-indexed primitives.
+
+				uint32_t m_Material = InvalidIndex;
+			};
+
+			/**
+			 * Document class.
+			 * This parses a .gltf or .glb file and maps all the buffers it references.
+			 */
+			class Document final
+			{
+			public:
+				/**
+				 * Explicit constructor.
+				 * This will throw an asset error if the file is not a valid glTF 2.0 asset.
+				 *
+				 * @param file The .gltf or .glb file path.
+				 */
+				explicit Document(const std::filesystem::path& file);
+
+				/**
+				 * Check if the document only uses the features supported by the loader.
+				 * Unsupported features include compressed geometry, sparse accessors and primitives which are not triangle lists.
+				 *
+				 * @return Whether the document is supported.
+				 */
+				[[nodiscard]] bool isSupported() const { return m_UnsupportedFeature.empty(); }
+
+				/**
+				 * Get the first unsupported feature used by the document.
+				 *
+				 * @return The feature description. This is empty if the document is supported.
+				 */
+				[[nodiscard]] const std::string& getUnsupportedFeature() const { return m_UnsupportedFeature; }
+
+				/**
+				 * Get the primitives of all the meshes.
+				 *
+				 * @return The primitives.
+				 */
+				[[nodiscard]] const std::vector<Primitive>& getPrimitives() const { return m_Primitives; }
+
+				/**
+				 * Get the materials.
+				 *
+				 * @return The materials.
+				 */
+				[[nodiscard]] const std::vector<Material>& getMaterials() const { return m_Materials; }
+
+			private:
+				std::vector<Primitive> m_Primitives;
+				std::vector<Material> m_Materials;
+
+				std::vector<MappedFile> m_Files;
+				std::vector<std::vector<std::byte>> m_EmbeddedBuffers;
+
+				std::string m_UnsupportedFeature;
+			};
+
+			/**
+			 * Decode the elements of an accessor to tightly packed floats.
+			 * Normalized integers are converted to [0, 1] or [-1, 1], and the other integers are converted as they are.
+			 *
+			 * @param accessor The accessor to decode.
+			 * @param pDestination The destination pointer. This must have space for count * components floats.
+			 * @param components The number of floats written per element. Extra source components are skipped, and missing ones are set to the fill value.
+			 * @param fillValue The value of the components which are not present in the source. Default is 0.
+			 */
+			void DecodeAccessor(const Accessor& accessor, float* pDestination, uint32_t components, float fillValue = 0.0f);
+
+			/**
+			 * Decode the elements of an index accessor to 32-bit indices.
+			 *
+			 * @param accessor The accessor to decode. The component type must be an unsigned integer.
+			 * @param pDestination The destination pointer. This must have space for count indices.
+			 */
+			void DecodeIndices(const Accessor& accessor, uint32_t* pDestination);
+		}
+	}
+}
\ No newline at end of file
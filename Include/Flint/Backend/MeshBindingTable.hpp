@@ -5,6 +5,8 @@
 
 #include "TextureView.hpp"
 #include "TextureSampler.hpp"
+#include "BufferRegion.hpp"
+#include "Program.hpp"
 
 #include <variant>
 #include <unordered_map>
@@ -19,6 +21,17 @@ namespace Flint
 		 */
 		class MeshBindingTable final
 		{
+			/**
+			 * Buffer binding structure.
+			 * This is a helper structure to bind a buffer or a region of a buffer.
+			 */
+			struct BufferBinding final
+			{
+				std::shared_ptr<Buffer> m_pBuffer;
+				uint64_t m_Offset = 0;
+				uint64_t m_Size = 0;
+			};
+
 			/**
 			 * Image binding structure.
 			 * This is a helper structure to bind image samplers.
@@ -44,6 +57,15 @@ namespace Flint
 			 */
 			void bind(uint32_t binding, const std::shared_ptr<Buffer>& pBuffer);
 
+			/**
+			 * Bind a buffer region to the required binding.
+			 * If the binding is a dynamic buffer, the region's offset is supplied at draw time and is not a part of the table's hash.
+			 *
+			 * @param binding The buffer's binding.
+			 * @param region The buffer region to bind.
+			 */
+			void bind(uint32_t binding, const BufferRegion& region);
+
 			/**
 			 * Bind an image to the required binding.
 			 *
@@ -54,6 +76,46 @@ namespace Flint
 			 */
 			void bind(uint32_t binding, const std::shared_ptr<TextureView>& pView, const std::shared_ptr<TextureSampler>& pSampler, ImageUsage currentUsage);
 
+			/**
+			 * Set the push constant data of the mesh.
+			 * This is usually used to pass bindless indices (like material indices) to the shaders. The data is pushed from offset 0 right before the mesh is drawn.
+			 *
+			 * @param pData The data pointer.
+			 * @param size The size of the data.
+			 */
+			void setConstants(const std::byte* pData, uint64_t size);
+
+			/**
+			 * Set the push constant data of the mesh.
+			 *
+			 * @tparam Type The data type.
+			 * @param data The data to set.
+			 */
+			template<class Type>
+			void setConstants(const Type& data) { setConstants(reinterpret_cast<const std::byte*>(&data), sizeof(Type)); }
+
+			/**
+			 * Set the data of a single push constant block member of the mesh.
+			 * The rest of the constant data is kept, so multiple members can be set one after the other.
+			 *
+			 * @param bindingMap The program's binding map, which contains the push constant block members.
+			 * @param name The name of the member.
+			 * @param pData The data pointer.
+			 * @param size The size of the data. This must not be larger than the member.
+			 */
+			void setConstant(const BindingMap& bindingMap, std::string_view name, const std::byte* pData, uint64_t size);
+
+			/**
+			 * Set the data of a single push constant block member of the mesh.
+			 *
+			 * @tparam Type The data type.
+			 * @param bindingMap The program's binding map, which contains the push constant block members.
+			 * @param name The name of the member.
+			 * @param data The data to set.
+			 */
+			template<class Type>
+			void setConstant(const BindingMap& bindingMap, std::string_view name, const Type& data) { setConstant(bindingMap, name, reinterpret_cast<const std::byte*>(&data), sizeof(Type)); }
+
 			/**
 			 * Generate the hash for this table.
 			 *
@@ -66,7 +128,7 @@ namespace Flint
 			 *
 			 * @return The buffer map.
 			 */
-			[[nodiscard]] const std::unordered_map<uint32_t, std::shared_ptr<Buffer>>& getBuffers() const { return m_pBuffers; }
+			[[nodiscard]] const std::unordered_map<uint32_t, BufferBinding>& getBuffers() const { return m_Buffers; }
 
 			/**
 			 * Get the bound images.
@@ -75,9 +137,17 @@ namespace Flint
 			 */
 			[[nodiscard]] const std::unordered_map<uint32_t, ImageBinding>& getImages() const { return m_Images; }
 
+			/**
+			 * Get the push constant data.
+			 *
+			 * @return The constant data.
+			 */
+			[[nodiscard]] const std::vector<std::byte>& getConstants() const { return m_Constants; }
+
 		private:
-			std::unordered_map<uint32_t, std::shared_ptr<Buffer>> m_pBuffers;
+			std::unordered_map<uint32_t, BufferBinding> m_Buffers;
 			std::unordered_map<uint32_t, ImageBinding> m_Images;
+			std::vector<std::byte> m_Constants;
 		};
 	}
 }
\ No newline at end of file
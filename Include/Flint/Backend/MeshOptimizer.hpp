@@ -0,0 +1,166 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Flint
+{
+	namespace Backend
+	{
+		/**
+		 * Vertex cache statistics structure.
+		 * This contains the result of simulating a FIFO post-transform vertex cache over an index buffer.
+		 */
+		struct VertexCacheStatistics final
+		{
+			/**
+			 * Get the average cache miss ratio (transformed vertices per triangle).
+			 * The ideal value is 0.5 for large regular meshes and the worst is 3.
+			 *
+			 * @return The ACMR.
+			 */
+			[[nodiscard]] float getACMR() const { return m_TriangleCount > 0 ? static_cast<float>(m_CacheMisses) / m_TriangleCount : 0.0f; }
+
+			/**
+			 * Get the average transform to vertex ratio (transformed vertices per unique vertex).
+			 * The ideal value is 1.
+			 *
+			 * @return The ATVR.
+			 */
+			[[nodiscard]] float getATVR() const { return m_VertexCount > 0 ? static_cast<float>(m_CacheMisses) / m_VertexCount : 0.0f; }
+
+			uint64_t m_CacheMisses = 0;
+			uint64_t m_TriangleCount = 0;
+			uint64_t m_VertexCount = 0;	// The number of unique vertices referenced by the indices.
+		};
+
+		/**
+		 * Meshlet structure.
+		 * A meshlet is a small cluster of triangles which is stored as a contiguous range of the mesh's indices, so it can be drawn using a single indexed
+		 * draw (direct or indirect) after it passes culling.
+		 *
+		 * The normal cone can be used for back-face culling. A meshlet is back facing if
+		 * "dot(center - cameraPosition, coneAxis) >= coneCutoff * length(center - cameraPosition) + radius".
+		 */
+		struct Meshlet final
+		{
+			std::array<float, 3> m_Center = {};
+			float m_Radius = 0.0f;
+
+			std::array<float, 3> m_ConeAxis = {};
+			float m_ConeCutoff = 1.0f;	// The sine of the cone's half angle. This is 1 if the triangles can not be culled using the cone.
+
+			uint32_t m_IndexOffset = 0;	// Count, relative to the mesh's first index.
+			uint32_t m_IndexCount = 0;	// Count.
+			uint32_t m_VertexCount = 0;	// The number of unique vertices in the meshlet.
+		};
+
+		/**
+		 * Mesh optimizer functions.
+		 * These work on triangle lists on the CPU, and are run per mesh after importing. All the indices must be less than the vertex count.
+		 */
+		namespace MeshOptimizer
+		{
+			/**
+			 * The default post-transform vertex cache size used for optimizing and analyzing.
+			 */
+			constexpr uint32_t DefaultCacheSize = 16;
+
+			/**
+			 * Simulate a FIFO post-transform vertex cache over the indices.
+			 *
+			 * @param indices The triangle list indices.
+			 * @param vertexCount The number of vertices.
+			 * @param cacheSize The size of the cache. Default is DefaultCacheSize.
+			 * @return The cache statistics.
+			 */
+			[[nodiscard]] VertexCacheStatistics AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint64_t vertexCount, uint32_t cacheSize = DefaultCacheSize);
+
+			/**
+			 * Reorder the triangles to improve the post-transform vertex cache hit rate.
+			 * This uses the Tipsify algorithm (Sander, Nehab and Barczak, 2007).
+			 *
+			 * @param indices The triangle list indices to reorder.
+			 * @param vertexCount The number of vertices.
+			 * @param cacheSize The size of the cache to optimize for. Default is DefaultCacheSize.
+			 */
+			void OptimizeVertexCache(std::vector<uint32_t>& indices, uint64_t vertexCount, uint32_t cacheSize = DefaultCacheSize);
+
+			/**
+			 * Reorder the triangles to reduce overdraw, without hurting the vertex cache hit rate too much.
+			 * The triangles are split into clusters at the vertex cache optimizer's boundaries, and the clusters are sorted so that the ones facing outwards
+			 * from the mesh's center are drawn first. This is camera independent, and should be run after optimizing for the vertex cache.
+			 *
+			 * @param indices The triangle list indices to reorder.
+			 * @param pPositions The vertex positions. Each position is 3 floats.
+			 * @param vertexCount The number of vertices.
+			 * @param threshold How much the ACMR is allowed to increase when splitting the clusters. Default is 1.05.
+			 * @param cacheSize The size of the cache to optimize for. Default is DefaultCacheSize.
+			 */
+			void OptimizeOverdraw(std::vector<uint32_t>& indices, const float* pPositions, uint64_t vertexCount, float threshold = 1.05f, uint32_t cacheSize = DefaultCacheSize);
+
+			/**
+			 * Compute a vertex remap table which orders the vertices by their first use in the indices, and remap the indices with it.
+			 * Vertices which are not referenced by the indices are moved to the end, so the vertex count stays the same.
+			 *
+			 * @param indices The triangle list indices to remap.
+			 * @param vertexCount The number of vertices.
+			 * @return The remap table. The new index of the vertex i is table[i].
+			 */
+			[[nodiscard]] std::vector<uint32_t> OptimizeVertexFetch(std::vector<uint32_t>& indices, uint64_t vertexCount);
+
+			/**
+			 * The default maximum number of vertices in a meshlet.
+			 */
+			constexpr uint32_t MaxMeshletVertices = 64;
+
+			/**
+			 * The default maximum number of triangles in a meshlet.
+			 */
+			constexpr uint32_t MaxMeshletTriangles = 124;
+
+			/**
+			 * Partition the triangles into meshlets.
+			 * The triangles are grouped in their current order, so the indices should be optimized for the vertex cache beforehand to get compact meshlets.
+			 *
+			 * @param indices The triangle list indices.
+			 * @param pPositions The vertex positions. Each position is 3 floats.
+			 * @param vertexCount The number of vertices.
+			 * @param maxVertices The maximum number of vertices in a meshlet. Default is MaxMeshletVertices.
+			 * @param maxTriangles The maximum number of triangles in a meshlet. Default is MaxMeshletTriangles.
+			 * @return The meshlets.
+			 */
+			[[nodiscard]] std::vector<Meshlet> BuildMeshlets(const std::vector<uint32_t>& indices, const float* pPositions, uint64_t vertexCount, uint32_t maxVertices = MaxMeshletVertices, uint32_t maxTriangles = MaxMeshletTriangles);
+
+			/**
+			 * Simplify a mesh by collapsing its edges using quadric error metrics (Garland and Heckbert, 1997).
+			 * The vertices are not modified, so the result can share the same vertex data with the original indices. Vertices on open borders and attribute
+			 * seams are never moved, which keeps the silhouette and the texture coordinates intact.
+			 *
+			 * @param indices The triangle list indices.
+			 * @param pPositions The vertex positions. Each position is 3 floats.
+			 * @param vertexCount The number of vertices.
+			 * @param targetIndexCount The number of indices to reduce to.
+			 * @param targetError The maximum error (distance in the position units) allowed when collapsing an edge.
+			 * @param pResultError The variable to store the largest error of the performed collapses. Default is nullptr.
+			 * @return The simplified indices. This might contain more indices than the target if the error or the topology does not allow further collapses.
+			 */
+			[[nodiscard]] std::vector<uint32_t> Simplify(const std::vector<uint32_t>& indices, const float* pPositions, uint64_t vertexCount, uint64_t targetIndexCount, float targetError, float* pResultError = nullptr);
+
+			/**
+			 * Project an object space error to the screen.
+			 *
+			 * @param error The error in the position units.
+			 * @param distance The distance from the camera to the object.
+			 * @param fieldOfView The camera's vertical field of view in degrees.
+			 * @param frameHeight The frame height in pixels.
+			 * @return The error in pixels.
+			 */
+			[[nodiscard]] float ProjectError(float error, float distance, float fieldOfView, uint32_t frameHeight);
+		}
+	}
+}
\ No newline at end of file
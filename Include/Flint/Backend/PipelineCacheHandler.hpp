@@ -5,6 +5,10 @@
 
 #include <vector>
 #include <filesystem>
+#include <unordered_map>
+#include <mutex>
+#include <future>
+#include <chrono>
 
 namespace Flint
 {
@@ -79,6 +83,66 @@ namespace Flint
 			private:
 				const std::filesystem::path m_CacheFilePath;
 			};
+
+			/**
+			 * Pipeline cache store class.
+			 * This is a default pipeline cache handler provided by Flint where the caches of all the pipelines are stored in a single file. The file
+			 * contains an index of the stored caches (their identifier, offset, size and checksum), followed by the cache data.
+			 *
+			 * The file is mapped and read once when the store is created, and the stored data are written back asynchronously, either periodically or when
+			 * the store is destroyed. The file is written to a temporary file first and then renamed, so a crash while writing never corrupts it.
+			 * Multiple stores can share the same file, the entries they did not store are kept when writing back.
+			 */
+			class PipelineCacheStore final : public PipelineCacheHandler
+			{
+			public:
+				/**
+				 * Explicit constructor.
+				 *
+				 * @param path The file path to store the caches. The parent directories are created if they don't exist.
+				 * @param writeBackInterval The minimum time between two periodic write backs. Default is 30 seconds.
+				 */
+				explicit PipelineCacheStore(std::filesystem::path&& path, std::chrono::milliseconds writeBackInterval = std::chrono::seconds(30));
+
+				/**
+				 * Destructor.
+				 * This writes back the data which are not written yet, and waits till the file is written.
+				 */
+				~PipelineCacheStore() override;
+
+				/**
+				 * Store the cache data.
+				 * The data are written to the file at the next write back.
+				 *
+				 * @param identifier The pipeline identifier.
+				 * @param bytes The cache data to store.
+				 */
+				void store(uint64_t identifier, const std::vector<std::byte>& bytes) override;
+
+				/**
+				 * Load cache data.
+				 *
+				 * @param identifier The pipeline identifier.
+				 * @return The loaded cache data. This is empty if the identifier is not stored or if it's data were corrupted.
+				 */
+				[[nodiscard]] std::vector<std::byte> load(uint64_t identifier) override;
+
+				/**
+				 * Write the stored data which are not written yet to the file, in the background.
+				 */
+				void writeBack();
+
+			private:
+				std::unordered_map<uint64_t, std::vector<std::byte>> m_Entries;
+				std::unordered_map<uint64_t, std::vector<std::byte>> m_PendingEntries;
+				std::mutex m_Mutex;
+
+				std::future<void> m_WriteBack;
+				std::chrono::steady_clock::time_point m_LastWriteBack;
+
+				const std::filesystem::path m_CacheFilePath;
+				const std::chrono::milliseconds m_WriteBackInterval;
+			};
 		}
 	}
 }
\ No newline at end of file
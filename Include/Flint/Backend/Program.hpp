@@ -6,6 +6,8 @@
 #include "DeviceBoundObject.hpp"
 
 #include <unordered_map>
+#include <string_view>
+#include <algorithm>
 
 namespace Flint
 {
@@ -28,6 +30,17 @@ namespace Flint
 				ResourceType m_Type = ResourceType::Undefined;
 			};
 
+			/**
+			 * Push constant structure.
+			 * This contains the information regarding a single member of the push constant block.
+			 */
+			struct PushConstant final
+			{
+				std::string m_Name;
+				uint32_t m_Offset = 0;	// The offset of the member from the start of the block.
+				uint32_t m_Size = 0;
+			};
+
 		public:
 			/**
 			 * Default constructor.
@@ -50,8 +63,42 @@ namespace Flint
 			 */
 			[[nodiscard]] const std::vector<Binding>& getBindings() const { return m_Bindings; }
 
+			/**
+			 * Register a push constant block member.
+			 * Members which are already registered (because multiple shaders declare the same block) are ignored.
+			 *
+			 * @param name The name of the member.
+			 * @param offset The offset of the member from the start of the block.
+			 * @param size The size of the member.
+			 */
+			void registerPushConstant(std::string&& name, uint32_t offset, uint32_t size)
+			{
+				if (!findPushConstant(name))
+					m_PushConstants.emplace_back(std::move(name), offset, size);
+			}
+
+			/**
+			 * Get the push constant block members.
+			 *
+			 * @return The stored push constants.
+			 */
+			[[nodiscard]] const std::vector<PushConstant>& getPushConstants() const { return m_PushConstants; }
+
+			/**
+			 * Find a push constant block member using it's name.
+			 *
+			 * @param name The name of the member.
+			 * @return The member pointer. This is nullptr if the program does not have a member with the name.
+			 */
+			[[nodiscard]] const PushConstant* findPushConstant(std::string_view name) const
+			{
+				const auto itr = std::find_if(m_PushConstants.begin(), m_PushConstants.end(), [name](const PushConstant& pushConstant) { return pushConstant.m_Name == name; });
+				return itr != m_PushConstants.end() ? &(*itr) : nullptr;
+			}
+
 		private:
 			std::vector<Binding> m_Bindings;
+			std::vector<PushConstant> m_PushConstants;
 		};
 
 		/**
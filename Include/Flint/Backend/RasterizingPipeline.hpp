@@ -5,11 +5,13 @@
 
 #include "Pipeline.hpp"
 #include "RasterizingProgram.hpp"
+#include "ComputeProgram.hpp"
 #include "StaticModel.hpp"
 #include "DrawEntry.hpp"
 #include "MeshBindingTable.hpp"
 
 #include <functional>
+#include <bit>
 
 namespace Flint
 {
@@ -240,6 +242,50 @@ namespace Flint
 
 		FLINT_DEFINE_ENUM_AND_OR(DynamicStateFlags);
 
+		/**
+		 * Pipeline compilation policy enum.
+		 * This determines what attach() does while the pipeline variations required by a model are being compiled. The variations of a model are
+		 * compiled in parallel regardless of the policy.
+		 */
+		enum class PipelineCompilationPolicy : uint8_t
+		{
+			// Wait till all the variations are compiled before returning.
+			Wait,
+
+			// Return right away and compile the variations in the background. The meshes are not drawn till their variation is ready.
+			Background
+		};
+
+		/**
+		 * Specialization constant structure.
+		 * This contains the value of a single specialization constant of a pipeline's shaders.
+		 */
+		struct SpecializationConstant final
+		{
+			std::string m_Name;			// The name of the constant in the shaders. The constant ID is used if this is empty.
+			uint32_t m_ConstantID = 0;
+			uint32_t m_Value = 0;		// The bits of the value. Booleans are stored as 0 or 1.
+		};
+
+		/**
+		 * Get the bits of a specialization constant value.
+		 *
+		 * @tparam Type The value type. This must be bool, int32_t, uint32_t or float.
+		 * @param value The value.
+		 * @return The value bits.
+		 */
+		template<class Type>
+		constexpr uint32_t GetSpecializationBits(const Type value)
+		{
+			static_assert(std::is_same_v<Type, bool> || std::is_same_v<Type, int32_t> || std::is_same_v<Type, uint32_t> || std::is_same_v<Type, float>, "Only 32-bit specialization constants are supported!");
+
+			if constexpr (std::is_same_v<Type, bool>)
+				return value ? 1 : 0;
+
+			else
+				return std::bit_cast<uint32_t>(value);
+		}
+
 		/**
 		 * Rasterizing pipeline specification structure.
 		 * This structure defines the rasterizing pipeline.
@@ -250,6 +296,7 @@ namespace Flint
 		struct RasterizingPipelineSpecification final
 		{
 			std::vector<ColorBlendAttachment> m_ColorBlendAttachments = { ColorBlendAttachment() };
+			std::vector<SpecializationConstant> m_SpecializationConstants;
 
 			float m_ColorBlendConstants[4] = {};
 			float m_DepthBiasFactor = 0.0f;
@@ -266,7 +313,8 @@ namespace Flint
 			PolygonMode m_PolygonMode = PolygonMode::Fill;
 			ColorBlendLogic m_ColorBlendLogic = ColorBlendLogic::Clear;
 			DepthCompareLogic m_DepthCompareLogic = DepthCompareLogic::LessOrEqual;
-			DynamicStateFlags m_DynamicStateFlags = DynamicStateFlags::Undefined;
+			DynamicStateFlags m_DynamicStateFlags = DynamicStateFlags::ViewPort | DynamicStateFlags::Scissor;	// The dynamic viewport and scissor are set to the rasterizer's extent when recording.
+			PipelineCompilationPolicy m_CompilationPolicy = PipelineCompilationPolicy::Wait;
 
 			bool m_EnablePrimitiveRestart : 1 = false;
 			bool m_EnableDepthBias : 1 = false;
@@ -278,8 +326,43 @@ namespace Flint
 			bool m_EnableColorBlendLogic : 1 = false;
 			bool m_EnableDepthTest : 1 = true;
 			bool m_EnableDepthWrite : 1 = true;
+
+			/**
+			 * Set the value of a specialization constant using it's name.
+			 *
+			 * @tparam Type The value type. This must be bool, int32_t, uint32_t or float.
+			 * @param name The name of the constant in the shaders.
+			 * @param value The value to set.
+			 */
+			template<class Type>
+			void setSpecialization(std::string&& name, const Type value) { setSpecialization(SpecializationConstant(std::move(name), 0, GetSpecializationBits(value))); }
+
+			/**
+			 * Set the value of a specialization constant using it's constant ID.
+			 *
+			 * @tparam Type The value type. This must be bool, int32_t, uint32_t or float.
+			 * @param constantID The constant ID of the constant in the shaders.
+			 * @param value The value to set.
+			 */
+			template<class Type>
+			void setSpecialization(uint32_t constantID, const Type value) { setSpecialization(SpecializationConstant(std::string(), constantID, GetSpecializationBits(value))); }
+
+			/**
+			 * Set a specialization constant.
+			 * This replaces the previous value if the constant was already set using the same name or ID.
+			 *
+			 * @param constant The constant to set.
+			 */
+			void setSpecialization(SpecializationConstant&& constant);
 		};
 
+		/**
+		 * The name of the push constant block member which receives the draw data.
+		 * Programs which declare a uvec4 member with this name get the entry index, mesh index, first instance and the level of detail of each draw
+		 * pushed before it's drawn. Push constants cannot change within an indirect draw, so these programs are drawn directly.
+		 */
+		constexpr std::string_view DrawDataPushConstant = "drawData";
+
 		/**
 		 * Resource binder function type.
 		 * This function is called upon all the meshes to configure their resource bindings.
@@ -323,6 +406,28 @@ namespace Flint
 			 */
 			[[nodiscard]] virtual std::shared_ptr<DrawEntry> attach(const std::shared_ptr<StaticModel>& pModel, ResourceBinder&& binder) = 0;
 
+			/**
+			 * Enable GPU culling.
+			 * Every instance of every mesh is tested against the camera frustum and a depth pyramid built from the previous frame's depth, and only the
+			 * visible ones are drawn. The culling runs on the GPU, so the per frame CPU cost does not depend on the number of instances.
+			 *
+			 * Culling is only performed if the device supports draw indirect count. Occlusion culling requires a single sampled depth attachment.
+			 *
+			 * @param pCullingProgram The program which culls the instances. Look at Shaders/Culling/Cull.comp in the Sandbox for the expected interface.
+			 * @param pDepthPyramidProgram The program which reduces the depth. Look at Shaders/Culling/DepthPyramid.comp in the Sandbox for the expected
+			 * interface.
+			 */
+			virtual void enableCulling(const std::shared_ptr<ComputeProgram>& pCullingProgram, const std::shared_ptr<ComputeProgram>& pDepthPyramidProgram) = 0;
+
+			/**
+			 * Set the view which is used to cull the instances.
+			 * This needs to be called whenever the camera moves. The projection's depth must increase with the distance, like the depth test expects.
+			 *
+			 * @param view The view matrix.
+			 * @param projection The projection matrix.
+			 */
+			virtual void setCullingView(const glm::mat4& view, const glm::mat4& projection) = 0;
+
 			/**
 			 * Get the parent rasterizer.
 			 *
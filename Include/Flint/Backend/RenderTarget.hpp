@@ -59,6 +59,13 @@ namespace Flint
 			 */
 			[[nodiscard]] virtual const RenderTargetAttachment& getAttachment(uint32_t index) const = 0;
 
+			/**
+			 * Get the number of attachments in the render target.
+			 *
+			 * @return The attachment count.
+			 */
+			[[nodiscard]] uint32_t getAttachmentCount() const { return static_cast<uint32_t>(m_AttachmentDescriptions.size()); }
+
 			/**
 			 * Get the width of the render target.
 			 *
@@ -29,6 +29,7 @@ namespace Flint
 
 			/**
 			 * Explicit constructor.
+			 * The file is mapped and copied, so it's not read twice.
 			 *
 			 * @param file The shader source file.
 			 */
@@ -56,8 +57,17 @@ namespace Flint
 			 */
 			[[nodiscard]] const std::vector<uint32_t>& get() const { return m_Code; }
 
+			/**
+			 * Get the hash of the shader code.
+			 * This is the XXH64 hash of the code, which identifies the shader in the shader caches.
+			 *
+			 * @return The hash.
+			 */
+			[[nodiscard]] uint64_t getHash() const { return m_Hash; }
+
 		private:
 			std::vector<uint32_t> m_Code;
+			uint64_t m_Hash = 0;
 		};
 	}
 }
\ No newline at end of file
@@ -5,6 +5,9 @@
 
 #include "Entity.hpp"
 #include "Texture2D.hpp"
+#include "MeshOptimizer.hpp"
+
+#include <glm/glm.hpp>
 
 namespace Flint
 {
@@ -46,17 +49,49 @@ namespace Flint
 				uint64_t m_Offset = 0;	// Bytes.
 			};
 
+			/**
+			 * Level of detail structure.
+			 * All the levels of a mesh share the same vertices, and only differ in their indices.
+			 */
+			struct LevelOfDetail
+			{
+				uint64_t m_IndexOffset = 0;		// Count, relative to the mesh's index offset.
+				uint64_t m_IndexCount = 0;		// Count.
+				float m_Error = 0.0f;			// The simplification error in the mesh's (unquantized) space.
+			};
+
 		public:
 			std::array<AttributeData, EnumToInt(VertexAttribute::Max)> m_VertexData;
 			std::array<std::filesystem::path, EnumToInt(TextureType::Max)> m_TexturePaths;
 
 			std::string m_Name;
 
+			// These are used to dequantize the positions when using the quantized vertex format profile: position = offset + quantized * scale.
+			glm::vec3 m_PositionOffset = glm::vec3(0.0f);
+			glm::vec3 m_PositionScale = glm::vec3(1.0f);
+
 			uint64_t m_VertexCount = 0;		// Count.
 			uint64_t m_VertexOffset = 0;	// Count.
 
-			uint64_t m_IndexOffset = 0;		// Bytes.
+			uint64_t m_IndexOffset = 0;		// Count, in the mesh's index type.
 			uint64_t m_IndexCount = 0;		// Count.
+
+			// Meshes with less than 65535 vertices use 16-bit indices.
+			IndexType m_IndexType = IndexType::Uint32;
+
+			// The post-transform vertex cache statistics of the mesh before and after optimizing it.
+			VertexCacheStatistics m_UnoptimizedCacheStatistics;
+			VertexCacheStatistics m_CacheStatistics;
+
+			// The levels of detail of the mesh. The first level is the full mesh, and each level has roughly half the triangles of the previous one.
+			std::vector<LevelOfDetail> m_LevelsOfDetail;
+
+			// The bounding sphere of the mesh in the mesh's (unquantized) space.
+			glm::vec3 m_BoundingCenter = glm::vec3(0.0f);
+			float m_BoundingRadius = 0.0f;
+
+			// The meshlets of the mesh. Their index ranges are relative to the mesh's index offset and bounds are in the mesh's (unquantized) space.
+			std::vector<Meshlet> m_Meshlets;
 		};
 
 		/**
@@ -80,7 +115,8 @@ namespace Flint
 			virtual ~StaticModel() = default;
 
 			/**
-			 * Compile the loaded data to a compressed binary which can be loaded easily.
+			 * Compile the loaded data to a binary which can be loaded easily.
+			 * Store the binary in a file with the cooked static model extension (.fsm) to load it without importing the asset again.
 			 *
 			 * @return The compiled binary data.
 			 */
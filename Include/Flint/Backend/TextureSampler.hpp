@@ -28,8 +28,17 @@ namespace Flint
 			 */
 			virtual ~TextureSampler() = default;
 
+			/**
+			 * Get the bindless index of the sampler.
+			 * This is the index used to access the sampler from the bindless descriptor arrays in shaders.
+			 *
+			 * @return The bindless index. This will be InvalidBindlessIndex if the sampler is not registered as a bindless resource.
+			 */
+			[[nodiscard]] uint32_t getBindlessIndex() const { return m_BindlessIndex; }
+
 		protected:
 			const TextureSamplerSpecification m_Specification = {};
+			uint32_t m_BindlessIndex = InvalidBindlessIndex;
 		};
 	}
 }
\ No newline at end of file
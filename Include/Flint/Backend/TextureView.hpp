@@ -29,8 +29,17 @@ namespace Flint
 			 */
 			virtual ~TextureView() = default;
 
+			/**
+			 * Get the bindless index of the view.
+			 * This is the index used to access the image from the bindless descriptor arrays in shaders.
+			 *
+			 * @return The bindless index. This will be InvalidBindlessIndex if the view is not registered as a bindless resource.
+			 */
+			[[nodiscard]] uint32_t getBindlessIndex() const { return m_BindlessIndex; }
+
 		protected:
 			std::shared_ptr<Texture> m_pTexture = nullptr;
+			uint32_t m_BindlessIndex = InvalidBindlessIndex;
 		};
 	}
 }
\ No newline at end of file
@@ -293,6 +293,44 @@ namespace Flint
 		VertexAttribute m_Attribute = VertexAttribute::Max;
 	};
 
+	/**
+	 * Vertex memory type enum.
+	 * This defines how to store the vertex data in a vertex storage.
+	 */
+	enum class VertexMemoryType : uint8_t
+	{
+		// This means that each and every vertex attribute gets it's own vertex buffer.
+		Exclusive,
+
+		// This means that each and every vertex attribute gets stored in a single interleaved buffer.
+		Interleaved
+	};
+
+	/**
+	 * Vertex format profile enum.
+	 * This defines the formats used to store the vertex attributes.
+	 */
+	enum class VertexFormatProfile : uint8_t
+	{
+		// This stores all the attributes as 32-bit floats.
+		Full,
+
+		// This stores the attributes in compact formats, which the shaders need to decode.
+		// Positions are stored as 4x16-bit UNORM relative to the mesh's bounding box (see StaticMesh::m_PositionOffset and StaticMesh::m_PositionScale).
+		// Normals, tangents and bi-tangents are octahedral encoded to 2x16-bit SNORM.
+		// Texture coordinates are stored as 2x16-bit half floats and colors as 4x8-bit UNORM.
+		Quantized
+	};
+
+	/**
+	 * Index type enum.
+	 */
+	enum class IndexType : uint8_t
+	{
+		Uint16,
+		Uint32
+	};
+
 	/**
 	 * Instance attribute enum.
 	 */
@@ -366,7 +404,10 @@ namespace Flint
 		General = Uniform | Storage,
 
 		// Used for data transferring purposes.
-		Staging = 1 << 6
+		Staging = 1 << 6,
+
+		// Used to store indirect draw commands. This can directly receive data, and can also be written by shaders.
+		Indirect = 1 << 7
 	};
 
 	/**
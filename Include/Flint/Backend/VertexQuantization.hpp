@@ -0,0 +1,96 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Flint
+{
+	namespace Backend
+	{
+		/**
+		 * Vertex quantization kernels.
+		 * These convert the 32-bit float vertex attributes and 32-bit indices to their compact formats at load time. All the kernels read tightly packed source elements, and write to
+		 * the destination using the given stride so the same kernels can be used for both exclusive and interleaved vertex storages.
+		 *
+		 * The kernels use SSE2 (and F16C for half floats) when the compiler targets them, and fall back to scalar code otherwise.
+		 */
+		namespace VertexQuantization
+		{
+			/**
+			 * Compute the bounding box of a set of positions.
+			 *
+			 * @param pPositions The positions. Each position is 3 floats.
+			 * @param count The number of positions.
+			 * @param minimum The variable to store the minimum corner.
+			 * @param maximum The variable to store the maximum corner.
+			 */
+			void ComputeBounds(const float* pPositions, uint64_t count, std::array<float, 3>& minimum, std::array<float, 3>& maximum);
+
+			/**
+			 * Quantize positions to 4x16-bit UNORM, relative to a bounding box.
+			 * The positions can be dequantized using "position = minimum + value * (maximum - minimum)". The fourth component is set to 0.
+			 *
+			 * @param pPositions The positions. Each position is 3 floats.
+			 * @param count The number of positions.
+			 * @param minimum The minimum corner of the bounding box.
+			 * @param maximum The maximum corner of the bounding box.
+			 * @param pDestination The destination pointer.
+			 * @param stride The destination stride in bytes.
+			 */
+			void QuantizePositions(const float* pPositions, uint64_t count, const std::array<float, 3>& minimum, const std::array<float, 3>& maximum, std::byte* pDestination, uint32_t stride);
+
+			/**
+			 * Encode unit vectors to octahedral 2x16-bit SNORM.
+			 *
+			 * @param pVectors The vectors. Each vector is 3 floats.
+			 * @param count The number of vectors.
+			 * @param pDestination The destination pointer.
+			 * @param stride The destination stride in bytes.
+			 */
+			void EncodeOctahedral(const float* pVectors, uint64_t count, std::byte* pDestination, uint32_t stride);
+
+			/**
+			 * Convert 2D coordinates to 2x16-bit half floats.
+			 *
+			 * @param pCoordinates The coordinates. Only the first 2 components of each element are converted.
+			 * @param count The number of coordinates.
+			 * @param sourceComponents The number of floats in a single source element.
+			 * @param pDestination The destination pointer.
+			 * @param stride The destination stride in bytes.
+			 */
+			void ConvertToHalf2(const float* pCoordinates, uint64_t count, uint32_t sourceComponents, std::byte* pDestination, uint32_t stride);
+
+			/**
+			 * Convert colors to 4x8-bit UNORM.
+			 *
+			 * @param pColors The colors. Each color is 4 floats.
+			 * @param count The number of colors.
+			 * @param pDestination The destination pointer.
+			 * @param stride The destination stride in bytes.
+			 */
+			void ConvertToUnorm8x4(const float* pColors, uint64_t count, std::byte* pDestination, uint32_t stride);
+
+			/**
+			 * Narrow 32-bit indices to 16-bit indices.
+			 * Make sure that all the indices fit in 16 bits.
+			 *
+			 * @param pIndices The indices.
+			 * @param count The number of indices.
+			 * @param pDestination The destination pointer.
+			 */
+			void NarrowIndices(const uint32_t* pIndices, uint64_t count, uint16_t* pDestination);
+
+			/**
+			 * Convert a single float to a half float.
+			 *
+			 * @param value The value to convert.
+			 * @return The half float bits.
+			 */
+			[[nodiscard]] uint16_t FloatToHalf(float value);
+		}
+	}
+}
\ No newline at end of file
@@ -9,19 +9,6 @@ namespace Flint
 {
 	namespace Backend
 	{
-		/**
-		 * Vertex memory type enum.
-		 * This defines how to store the vertex data in a vertex storage.
-		 */
-		enum class VertexMemoryType : uint8_t
-		{
-			// This means that each and every vertex attribute gets it's own vertex buffer.
-			Exclusive,
-
-			// This means that each and every vertex attribute gets stored in a single interleaved buffer. 
-			Interleaved
-		};
-
 		/**
 		 * Vertex storage class.
 		 * This class is used to store vertex information about a single geometry.
@@ -29,8 +16,13 @@ namespace Flint
 		class VertexStorage : public DeviceBoundObject
 		{
 		public:
-			// Using the same constructor as the super class.
-			using DeviceBoundObject::DeviceBoundObject;
+			/**
+			 * Explicit constructor.
+			 *
+			 * @param pDevice The device reference.
+			 * @param memoryType The memory type used to store the vertex data. Default is exclusive.
+			 */
+			explicit VertexStorage(const std::shared_ptr<Device>& pDevice, VertexMemoryType memoryType = VertexMemoryType::Exclusive) : DeviceBoundObject(pDevice), m_MemoryType(memoryType) {}
 
 			/**
 			 * Default virtual destructor.
@@ -46,6 +38,23 @@ namespace Flint
 			 */
 			virtual [[nodiscard]] uint64_t insert(VertexAttribute attribute, const Buffer* pStaggingBuffer) = 0;
 
+			/**
+			 * Reserve space for an attribute in the vertex storage.
+			 * This grows the attribute's buffer by the required size at once, so multiple meshes can later be copied to it without reallocating it every time.
+			 *
+			 * @param attribute The attribute type of the data.
+			 * @param size The number of bytes to reserve.
+			 * @return The offset at which the reserved region starts.
+			 */
+			virtual [[nodiscard]] uint64_t reserve(VertexAttribute attribute, uint64_t size) = 0;
+
+			/**
+			 * Get the memory type of the storage.
+			 *
+			 * @return The memory type.
+			 */
+			[[nodiscard]] VertexMemoryType getMemoryType() const { return m_MemoryType; }
+
 		protected:
 			const VertexMemoryType m_MemoryType = VertexMemoryType::Exclusive;
 		};
@@ -0,0 +1,85 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+namespace Flint
+{
+	/**
+	 * Mapped file class.
+	 * This maps a file to the process' address space as read only, so the file's contents can be accessed without copying them to a buffer first.
+	 * The pages are loaded by the operating system on demand.
+	 */
+	class MappedFile final
+	{
+	public:
+		/**
+		 * Default constructor.
+		 */
+		MappedFile() = default;
+
+		/**
+		 * Explicit constructor.
+		 * This will throw an asset error if the file could not be mapped.
+		 *
+		 * @param path The file path.
+		 */
+		explicit MappedFile(const std::filesystem::path& path);
+
+		/**
+		 * Move constructor.
+		 *
+		 * @param other The other file.
+		 */
+		MappedFile(MappedFile&& other) noexcept;
+
+		/**
+		 * Destructor.
+		 */
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		/**
+		 * Move assignment operator.
+		 *
+		 * @param other The other file.
+		 * @return The moved file reference.
+		 */
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		/**
+		 * Unmap the file.
+		 */
+		void unmap();
+
+		/**
+		 * Get the mapped data.
+		 *
+		 * @return The data pointer. This is nullptr if the file is not mapped or is empty.
+		 */
+		[[nodiscard]] const std::byte* getData() const noexcept { return m_pData; }
+
+		/**
+		 * Get the size of the file.
+		 *
+		 * @return The size in bytes.
+		 */
+		[[nodiscard]] uint64_t getSize() const noexcept { return m_Size; }
+
+		/**
+		 * Check if the file is empty (or not mapped).
+		 *
+		 * @return Whether the file is empty.
+		 */
+		[[nodiscard]] bool isEmpty() const noexcept { return m_Size == 0; }
+
+	private:
+		const std::byte* m_pData = nullptr;
+		uint64_t m_Size = 0;
+	};
+}
\ No newline at end of file
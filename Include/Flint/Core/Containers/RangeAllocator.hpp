@@ -0,0 +1,144 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <map>
+
+namespace Flint
+{
+	/**
+	 * Range allocator class.
+	 * This sub-allocates ranges from a fixed capacity (like a buffer) using a free list. The free ranges are kept sorted by their offset, so freed ranges are
+	 * merged with their neighbors and the free list does not fragment over time.
+	 *
+	 * The allocator does not own any memory, it only keeps track of the offsets. The units (bytes, vertices, ...) are up to the user.
+	 */
+	class RangeAllocator final
+	{
+	public:
+		/**
+		 * Invalid offset.
+		 * This is returned when a range could not be allocated.
+		 */
+		static constexpr uint64_t InvalidOffset = -1;
+
+	public:
+		/**
+		 * Default constructor.
+		 */
+		RangeAllocator() = default;
+
+		/**
+		 * Explicit constructor.
+		 *
+		 * @param capacity The number of units which can be allocated.
+		 */
+		explicit RangeAllocator(uint64_t capacity) : m_Capacity(capacity)
+		{
+			if (capacity > 0)
+				m_FreeRanges[0] = capacity;
+		}
+
+		/**
+		 * Allocate a range.
+		 * This uses the first free range which can fit the requested size.
+		 *
+		 * @param size The size of the range.
+		 * @param alignment The alignment of the range's offset. This must be a power of two. Default is 1.
+		 * @return The offset of the range. This is InvalidOffset if there is no free range which can fit the size.
+		 */
+		[[nodiscard]] uint64_t allocate(uint64_t size, uint64_t alignment = 1)
+		{
+			// Empty ranges do not occupy anything.
+			if (size == 0)
+				return 0;
+
+			for (auto itr = m_FreeRanges.begin(); itr != m_FreeRanges.end(); ++itr)
+			{
+				const auto [offset, freeSize] = *itr;
+				const auto alignedOffset = (offset + alignment - 1) & ~(alignment - 1);
+				const auto padding = alignedOffset - offset;
+				if (padding >= freeSize || freeSize - padding < size)
+					continue;
+
+				// Remove the range and put back what's left on either side of the allocation.
+				m_FreeRanges.erase(itr);
+				if (padding > 0)
+					m_FreeRanges[offset] = padding;
+
+				if (freeSize - padding > size)
+					m_FreeRanges[alignedOffset + size] = freeSize - padding - size;
+
+				m_UsedSize += size;
+				return alignedOffset;
+			}
+
+			return InvalidOffset;
+		}
+
+		/**
+		 * Free a previously allocated range.
+		 *
+		 * @param offset The offset of the range.
+		 * @param size The size of the range. This must be the same as the allocated size.
+		 */
+		void free(uint64_t offset, uint64_t size)
+		{
+			if (size == 0 || offset == InvalidOffset)
+				return;
+
+			m_UsedSize -= size;
+
+			// Merge with the next range if it starts right after this one.
+			auto next = m_FreeRanges.lower_bound(offset);
+			if (next != m_FreeRanges.end() && next->first == offset + size)
+			{
+				size += next->second;
+				next = m_FreeRanges.erase(next);
+			}
+
+			// Merge with the previous range if it ends right before this one.
+			if (next != m_FreeRanges.begin())
+			{
+				const auto previous = std::prev(next);
+				if (previous->first + previous->second == offset)
+				{
+					previous->second += size;
+					return;
+				}
+			}
+
+			m_FreeRanges.emplace_hint(next, offset, size);
+		}
+
+		/**
+		 * Get the capacity of the allocator.
+		 *
+		 * @return The capacity.
+		 */
+		[[nodiscard]] uint64_t getCapacity() const { return m_Capacity; }
+
+		/**
+		 * Get the number of allocated units.
+		 *
+		 * @return The used size.
+		 */
+		[[nodiscard]] uint64_t getUsedSize() const { return m_UsedSize; }
+
+		/**
+		 * Check if nothing is allocated.
+		 *
+		 * @return Whether the allocator is empty.
+		 */
+		[[nodiscard]] bool isEmpty() const { return m_UsedSize == 0; }
+
+	private:
+		std::map<uint64_t, uint64_t> m_FreeRanges;	// Offset to size.
+
+		uint64_t m_Capacity = 0;
+		uint64_t m_UsedSize = 0;
+	};
+}
\ No newline at end of file
@@ -3,17 +3,88 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <thread>
+#include <atomic>
+#include <exception>
+#include <algorithm>
 
 namespace Flint
 {
 	/**
 	 * Worker group class.
-	 * This is a group of reactors, where work is loaded to them depending on their work load.
+	 * This is a bounded group of worker threads which split a range of independent work items between them. The items are claimed using an atomic
+	 * counter, so the workers never lock, and the caller is responsible for making sure that each item only writes to its own data.
 	 */
 	class WorkerGroup final
 	{
+	public:
+		/**
+		 * Explicit constructor.
+		 *
+		 * @param workerCount The maximum number of threads used to execute the work, including the calling thread. Default is the hardware concurrency.
+		 */
+		explicit WorkerGroup(uint32_t workerCount = std::thread::hardware_concurrency()) : m_WorkerCount(std::max(workerCount, 1u)) {}
 
+		/**
+		 * Execute a function for each index in the range [0, count).
+		 * The calling thread participates in the work, and the function returns once all the items are executed. If an item throws, the remaining
+		 * items are skipped and the first exception is rethrown on the calling thread.
+		 *
+		 * @tparam Function The function type. It should take the item index as an uint64_t.
+		 * @param count The number of items.
+		 * @param function The function to execute.
+		 */
+		template<class Function>
+		void parallelFor(uint64_t count, const Function& function) const
+		{
+			std::atomic<uint64_t> nextIndex = 0;
+			std::atomic_flag hasFailed = ATOMIC_FLAG_INIT;
+			std::exception_ptr exception = nullptr;
+
+			const auto worker = [count, &function, &nextIndex, &hasFailed, &exception]
+			{
+				for (auto index = nextIndex++; index < count; index = nextIndex++)
+				{
+					try
+					{
+						function(index);
+					}
+					catch (...)
+					{
+						// Store the first exception, and make the other workers stop.
+						if (!hasFailed.test_and_set())
+							exception = std::current_exception();
+
+						nextIndex = count;
+					}
+				}
+			};
+
+			// Spawn the additional workers. We don't need more workers than the items.
+			{
+				std::vector<std::jthread> workers;
+				workers.reserve(std::min<uint64_t>(m_WorkerCount, count));
+
+				for (uint64_t i = 1; i < std::min<uint64_t>(m_WorkerCount, count); i++)
+					workers.emplace_back(worker);
+
+				worker();
+			}
+
+			if (exception)
+				std::rethrow_exception(exception);
+		}
+
+		/**
+		 * Get the maximum number of threads used by the group.
+		 *
+		 * @return The worker count.
+		 */
+		[[nodiscard]] uint32_t getWorkerCount() const noexcept { return m_WorkerCount; }
+
+	private:
+		uint32_t m_WorkerCount = 1;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,156 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Flint/Backend/Types.hpp"
+
+#include <volk.h>
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+namespace Flint
+{
+	namespace Backend
+	{
+		class VulkanDevice;
+
+		/**
+		 * The descriptor set index of the bindless descriptor set.
+		 * Shaders which want to use bindless resources should declare them in this set.
+		 */
+		constexpr uint32_t BindlessDescriptorSet = 1;
+
+		/**
+		 * Bindless resource type enum.
+		 * The value of each type is the binding index of it's array in the bindless descriptor set.
+		 *
+		 * layout (set = 1, binding = 0) uniform texture2D textures[];
+		 * layout (set = 1, binding = 1) uniform sampler samplers[];
+		 * layout (set = 1, binding = 2) buffer Buffers { ... } buffers[];
+		 */
+		enum class BindlessResourceType : uint8_t
+		{
+			SampledImage,
+			Sampler,
+			StorageBuffer,
+
+			Max
+		};
+
+		/**
+		 * Vulkan bindless descriptor class.
+		 * This object contains a single update-after-bind descriptor set per device, with one large array per resource type. Resources get a stable slot in the
+		 * array when they are created and keep it till they are terminated, so shaders can index them using plain integers (passed through push constants or
+		 * instance data) and the set only needs to be bound once per command buffer.
+		 *
+		 * This requires descriptor indexing (VK_EXT_descriptor_indexing or Vulkan 1.2) support.
+		 */
+		class VulkanBindlessDescriptor final
+		{
+			/**
+			 * Slot array structure.
+			 * This keeps track of the used and free slots of a single resource array.
+			 */
+			struct SlotArray final
+			{
+				std::vector<uint32_t> m_FreeSlots;
+				uint32_t m_NextSlot = 0;
+				uint32_t m_Capacity = 0;
+			};
+
+		public:
+			/**
+			 * Explicit constructor.
+			 *
+			 * @param device The device to which the descriptor is bound to.
+			 */
+			explicit VulkanBindlessDescriptor(VulkanDevice& device);
+
+			/**
+			 * Destroy the descriptor.
+			 */
+			void destroy();
+
+			/**
+			 * Register a sampled image.
+			 *
+			 * @param view The image view.
+			 * @param layout The layout of the image when it's sampled.
+			 * @return The slot index of the image.
+			 */
+			[[nodiscard]] uint32_t registerImage(VkImageView view, VkImageLayout layout);
+
+			/**
+			 * Register a sampler.
+			 *
+			 * @param sampler The sampler.
+			 * @return The slot index of the sampler.
+			 */
+			[[nodiscard]] uint32_t registerSampler(VkSampler sampler);
+
+			/**
+			 * Register a storage buffer.
+			 *
+			 * @param buffer The buffer.
+			 * @param size The size of the buffer.
+			 * @return The slot index of the buffer.
+			 */
+			[[nodiscard]] uint32_t registerStorageBuffer(VkBuffer buffer, uint64_t size);
+
+			/**
+			 * Release a slot so it can be reused by another resource.
+			 * Note that the descriptor is not cleared, so make sure that the shaders do not access it afterwards.
+			 *
+			 * @param type The resource type.
+			 * @param index The slot index to release.
+			 */
+			void release(BindlessResourceType type, uint32_t index);
+
+			/**
+			 * Get the descriptor set layout.
+			 *
+			 * @return The descriptor set layout.
+			 */
+			[[nodiscard]] VkDescriptorSetLayout getDescriptorSetLayout() const { return m_DescriptorSetLayout; }
+
+			/**
+			 * Get the descriptor set.
+			 *
+			 * @return The descriptor set.
+			 */
+			[[nodiscard]] VkDescriptorSet getDescriptorSet() const { return m_DescriptorSet; }
+
+		private:
+			/**
+			 * Acquire a new slot from an array.
+			 *
+			 * @param type The resource type.
+			 * @return The slot index.
+			 */
+			[[nodiscard]] uint32_t acquireSlot(BindlessResourceType type);
+
+			/**
+			 * Write a single descriptor to the set.
+			 *
+			 * @param type The resource type.
+			 * @param index The slot index.
+			 * @param pImageInfo The image info pointer. Can be nullptr.
+			 * @param pBufferInfo The buffer info pointer. Can be nullptr.
+			 */
+			void write(BindlessResourceType type, uint32_t index, const VkDescriptorImageInfo* pImageInfo, const VkDescriptorBufferInfo* pBufferInfo);
+
+		private:
+			std::array<SlotArray, EnumToInt(BindlessResourceType::Max)> m_SlotArrays;
+			std::mutex m_Mutex;
+
+			VulkanDevice& m_Device;
+
+			VkDescriptorSetLayout m_DescriptorSetLayout = VK_NULL_HANDLE;
+			VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
+			VkDescriptorSet m_DescriptorSet = VK_NULL_HANDLE;
+		};
+	}
+}
\ No newline at end of file
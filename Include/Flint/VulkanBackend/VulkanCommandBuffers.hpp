@@ -13,6 +13,7 @@ namespace Flint
 		class VulkanWindow;
 		class VulkanRasterizer;
 		class VulkanRasterizingPipeline;
+		class VulkanComputeProgram;
 		class VulkanVertexStorage;
 
 		/**
@@ -40,8 +41,9 @@ namespace Flint
 			 * @param device The device to which the command buffer is bound to.
 			 * @param bufferCount The number of command buffers.
 			 * @param level The command buffer level. Default is primary.
+			 * @param queue The queue to which the command buffers are submitted to. This must be graphics, compute or transfer. Default is graphics.
 			 */
-			explicit VulkanCommandBuffers(const std::shared_ptr<VulkanDevice>& pDevice, uint32_t bufferCount, VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+			explicit VulkanCommandBuffers(const std::shared_ptr<VulkanDevice>& pDevice, uint32_t bufferCount, VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY, VkQueueFlagBits queue = VK_QUEUE_GRAPHICS_BIT);
 
 			/**
 			 * Explicit constructor.
@@ -176,6 +178,22 @@ namespace Flint
 			 */
 			void bindRasterizingPipeline(VkPipeline pipeline) const noexcept;
 
+			/**
+			 * Set the viewport of the bound pipeline.
+			 * The pipeline must be created with a dynamic viewport.
+			 *
+			 * @param viewport The viewport to set.
+			 */
+			void setViewport(const VkViewport& viewport) const noexcept;
+
+			/**
+			 * Set the scissor of the bound pipeline.
+			 * The pipeline must be created with a dynamic scissor.
+			 *
+			 * @param scissor The scissor to set.
+			 */
+			void setScissor(const VkRect2D& scissor) const noexcept;
+
 			/**
 			 * Bind vertex buffers to this command buffer.
 			 *
@@ -188,8 +206,9 @@ namespace Flint
 			 * Bind a n index buffer to this command buffer.
 			 *
 			 * @param buffer The buffer to bind.
+			 * @param indexType The type of the indices. Default is 32-bit.
 			 */
-			void bindIndexBuffer(const VkBuffer buffer) const noexcept;
+			void bindIndexBuffer(const VkBuffer buffer, IndexType indexType = IndexType::Uint32) const noexcept;
 
 			/**
 			 * Draw using an index buffer.
@@ -198,16 +217,127 @@ namespace Flint
 			 * @param indexOffset The index offset of the mesh.
 			 * @param instanceCount The number of instances to draw.
 			 * @param vertexOffset The vertex offset to draw in.
+			 * @param firstInstance The first instance's ID. Default is 0.
+			 */
+			void drawIndexed(uint64_t indexCount, uint64_t indexOffset, uint64_t instanceCount, uint64_t vertexOffset, uint64_t firstInstance = 0) const noexcept;
+
+			/**
+			 * Draw using an index buffer and indirect draw commands.
+			 *
+			 * @param buffer The buffer containing the VkDrawIndexedIndirectCommand structures.
+			 * @param offset The byte offset of the first command in the buffer.
+			 * @param drawCount The number of commands to draw.
+			 */
+			void drawIndexedIndirect(const VkBuffer buffer, uint64_t offset, uint64_t drawCount) const noexcept;
+
+			/**
+			 * Draw using an index buffer and indirect draw commands, with the draw count sourced from a buffer.
+			 * This requires the device to support draw indirect count.
+			 *
+			 * @param buffer The buffer containing the VkDrawIndexedIndirectCommand structures.
+			 * @param offset The byte offset of the first command in the buffer.
+			 * @param countBuffer The buffer containing the draw count.
+			 * @param countOffset The byte offset of the draw count in the count buffer.
+			 * @param maxDrawCount The maximum number of commands to draw.
 			 */
-			void drawIndexed(uint64_t indexCount, uint64_t indexOffset, uint64_t instanceCount, uint64_t vertexOffset) const noexcept;
+			void drawIndexedIndirectCount(const VkBuffer buffer, uint64_t offset, const VkBuffer countBuffer, uint64_t countOffset, uint64_t maxDrawCount) const noexcept;
 
 			/**
 			 * Bind a graphics descriptor to the command buffer.
 			 *
 			 * @param pPipeline The pipeline to which the descriptor is bound to.
 			 * @param descriptorSet The descriptor set to bind.
+			 * @param dynamicOffsets The dynamic buffer offsets, ordered by binding. Default is empty.
+			 */
+			void bindDescriptor(const VulkanRasterizingPipeline* pPipeline, VkDescriptorSet descriptorSet, const std::vector<uint32_t>& dynamicOffsets = {}) const noexcept;
+
+			/**
+			 * Bind the device's bindless descriptor set to the command buffer.
+			 * Since the bindless descriptor set is shared by all the resources, this only needs to be bound once per command buffer.
+			 *
+			 * @param pPipeline The pipeline to which the descriptor is bound to.
+			 */
+			void bindBindlessDescriptor(const VulkanRasterizingPipeline* pPipeline) const noexcept;
+
+			/**
+			 * Push constants to the command buffer.
+			 *
+			 * @param pPipeline The pipeline to which the constants are pushed to.
+			 * @param pData The data pointer.
+			 * @param size The size of the data.
+			 * @param offset The offset of the data in the push constant block. Default is 0.
+			 */
+			void pushConstants(const VulkanRasterizingPipeline* pPipeline, const std::byte* pData, uint32_t size, uint32_t offset = 0) const noexcept;
+
+			/**
+			 * Bind a compute pipeline to the command buffer.
+			 *
+			 * @param pipeline The pipeline to bind.
+			 */
+			void bindComputePipeline(VkPipeline pipeline) const noexcept;
+
+			/**
+			 * Bind a compute descriptor to the command buffer.
+			 *
+			 * @param pProgram The program whose pipeline layout the descriptor is bound with.
+			 * @param descriptorSet The descriptor set to bind.
+			 * @param dynamicOffsets The dynamic buffer offsets, ordered by binding. Default is empty.
+			 */
+			void bindComputeDescriptor(const VulkanComputeProgram* pProgram, VkDescriptorSet descriptorSet, const std::vector<uint32_t>& dynamicOffsets = {}) const noexcept;
+
+			/**
+			 * Bind the device's bindless descriptor set to the compute bind point.
+			 *
+			 * @param pProgram The program whose pipeline layout the descriptor is bound with.
+			 */
+			void bindComputeBindlessDescriptor(const VulkanComputeProgram* pProgram) const noexcept;
+
+			/**
+			 * Push compute constants to the command buffer.
+			 *
+			 * @param pProgram The program to which the constants are pushed to.
+			 * @param pData The data pointer.
+			 * @param size The size of the data.
+			 * @param offset The offset of the data in the push constant block. Default is 0.
+			 */
+			void pushComputeConstants(const VulkanComputeProgram* pProgram, const std::byte* pData, uint32_t size, uint32_t offset = 0) const noexcept;
+
+			/**
+			 * Dispatch the bound compute pipeline.
+			 *
+			 * @param groupCountX The number of work groups in the X dimension.
+			 * @param groupCountY The number of work groups in the Y dimension.
+			 * @param groupCountZ The number of work groups in the Z dimension.
+			 */
+			void dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) const noexcept;
+
+			/**
+			 * Dispatch the bound compute pipeline using the group counts stored in a buffer.
+			 *
+			 * @param buffer The buffer containing the VkDispatchIndirectCommand structure.
+			 * @param offset The byte offset of the command in the buffer.
+			 */
+			void dispatchIndirect(const VkBuffer buffer, uint64_t offset) const noexcept;
+
+			/**
+			 * Fill a buffer region with a 32-bit value.
+			 *
+			 * @param buffer The buffer to fill.
+			 * @param offset The byte offset of the region. This must be a multiple of 4.
+			 * @param size The byte size of the region. This must be a multiple of 4.
+			 * @param data The value to fill the region with.
+			 */
+			void fillBuffer(const VkBuffer buffer, uint64_t offset, uint64_t size, uint32_t data) const noexcept;
+
+			/**
+			 * Insert a global memory barrier.
+			 *
+			 * @param srcStageMask The stages which must finish before the barrier.
+			 * @param srcAccessMask The memory accesses which are made available.
+			 * @param dstStageMask The stages which wait for the barrier.
+			 * @param dstAccessMask The memory accesses which the written memory is made visible to.
 			 */
-			void bindDescriptor(const VulkanRasterizingPipeline* pPipeline, VkDescriptorSet descriptorSet) const noexcept;
+			void memoryBarrier(VkPipelineStageFlags srcStageMask, VkAccessFlags srcAccessMask, VkPipelineStageFlags dstStageMask, VkAccessFlags dstAccessMask) const noexcept;
 
 			/**
 			 * Execute the current commands on the parent command buffer if available.
@@ -221,6 +351,7 @@ namespace Flint
 
 			/**
 			 * Submit the command buffer to the GPU to be executed.
+			 * Graphics submissions wait for all the compute work which was submitted before them.
 			 *
 			 * @param renderFinishedSemaphore The render finished semaphore to be signaled.
 			 * @param inFlightSemaphore The in flight semaphore.
@@ -230,7 +361,7 @@ namespace Flint
 
 			/**
 			 * Submit the command buffer to the GPU to be executed.
-			 * This does not do any signaling operations.
+			 * This does not do any signaling operations. Like the other graphics submissions, this waits for all the compute work which was submitted before it.
 			 *
 			 * @param waitStageMask The wait stage mask to wait till completion. Default is color attachment output.
 			 */
@@ -243,6 +374,8 @@ namespace Flint
 
 			/**
 			 * Submit compute commands.
+			 * The command buffers must have been created for the compute queue. The submission signals the device's compute semaphore, which the following
+			 * graphics submissions wait for.
 			 */
 			void submitCompute();
 
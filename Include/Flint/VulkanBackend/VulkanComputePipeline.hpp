@@ -0,0 +1,145 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Flint/Backend/ComputePipeline.hpp"
+#include "VulkanDevice.hpp"
+#include "VulkanDescriptorSetManager.hpp"
+
+#include <mutex>
+
+namespace Flint
+{
+	namespace Backend
+	{
+		class VulkanComputeProgram;
+		class VulkanCommandBuffers;
+
+		/**
+		 * Vulkan compute pipeline class.
+		 * Each dispatch is recorded to a command buffer allocated from the compute queue's family and is submitted right away. The submission signals the
+		 * device's compute semaphore, which the following graphics submissions wait on.
+		 */
+		class VulkanComputePipeline final : public ComputePipeline
+		{
+			/**
+			 * Table structure.
+			 * This contains everything which is needed to bind a registered table.
+			 */
+			struct Table final
+			{
+				std::vector<uint32_t> m_DynamicOffsets;
+				std::vector<std::byte> m_Constants;
+
+				uint64_t m_ResourceHash = 0;
+			};
+
+		public:
+			/**
+			 * The number of command buffers used to record the dispatches.
+			 * A dispatch only waits for the CPU if all of them are still executing.
+			 */
+			static constexpr uint32_t CommandBufferCount = 3;
+
+		public:
+			/**
+			 * Explicit constructor.
+			 *
+			 * @param pDevice The device to which the pipeline is bound to.
+			 * @param pProgram The compute program used in the pipeline.
+			 * @param pCacheHandler The pipeline cache handler. Default is nullptr.
+			 */
+			explicit VulkanComputePipeline(const std::shared_ptr<VulkanDevice>& pDevice, const std::shared_ptr<VulkanComputeProgram>& pProgram, std::unique_ptr<PipelineCacheHandler>&& pCacheHandler = nullptr);
+
+			/**
+			 * Destructor.
+			 */
+			~VulkanComputePipeline() override;
+
+			/**
+			 * Terminate the object.
+			 */
+			void terminate() override;
+
+			/**
+			 * Register a binding table to the pipeline.
+			 * Registering the same resources and constants again returns the same handle.
+			 *
+			 * @param table The binding table containing the resources and the constants.
+			 * @return The handle used to dispatch using the table.
+			 */
+			[[nodiscard]] uint64_t registerTable(const MeshBindingTable& table) override;
+
+			/**
+			 * Dispatch the compute shader.
+			 *
+			 * @param table The handle of the registered table to use.
+			 * @param groupCountX The number of work groups in the X dimension.
+			 * @param groupCountY The number of work groups in the Y dimension. Default is 1.
+			 * @param groupCountZ The number of work groups in the Z dimension. Default is 1.
+			 */
+			void dispatch(uint64_t table, uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1) override;
+
+			/**
+			 * Dispatch the compute shader using the group counts stored in a buffer.
+			 *
+			 * @param table The handle of the registered table to use.
+			 * @param pBuffer The buffer containing the X, Y and Z group counts as three 32-bit unsigned integers. This must be an indirect buffer.
+			 * @param offset The byte offset of the group counts in the buffer. Default is 0.
+			 */
+			void dispatchIndirect(uint64_t table, const std::shared_ptr<Buffer>& pBuffer, uint64_t offset = 0) override;
+
+			/**
+			 * Bind the pipeline, the table's resources and it's constants to a command buffer.
+			 * This can be used to record dispatches to command buffers which are not owned by the pipeline.
+			 *
+			 * @param commandBuffers The command buffers to record the commands.
+			 * @param table The handle of the registered table to bind.
+			 */
+			void bind(const VulkanCommandBuffers& commandBuffers, uint64_t table) const;
+
+			/**
+			 * Load the pipeline cache from the handler if possible.
+			 *
+			 * @param identifier The pipeline identifier.
+			 * @return The loaded pipeline cache.
+			 */
+			[[nodiscard]] VkPipelineCache loadCache(uint64_t identifier) const;
+
+			/**
+			 * Save the pipeline cache from the handler if possible.
+			 *
+			 * @param identifier The pipeline identifier.
+			 * @param cache The pipeline cache to save.
+			 */
+			void saveCache(uint64_t identifier, VkPipelineCache cache) const;
+
+			/**
+			 * Get the pipeline handle.
+			 *
+			 * @return The Vulkan pipeline handle.
+			 */
+			[[nodiscard]] VkPipeline getPipeline() const { return m_Pipeline; }
+
+		private:
+			/**
+			 * Create the pipeline.
+			 */
+			void createPipeline();
+
+		private:
+			std::unordered_map<uint64_t, Table> m_Tables;
+			VulkanDescriptorSetManager m_DescriptorSetManager;
+
+			std::unique_ptr<VulkanCommandBuffers> m_pCommandBuffers = nullptr;
+
+			VkPipeline m_Pipeline = VK_NULL_HANDLE;
+			VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+
+			uint64_t m_Identifier = 0;
+
+			std::mutex m_Mutex;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Flint/Backend/ComputeProgram.hpp"
+#include "VulkanProgramLayout.hpp"
+
+namespace Flint
+{
+	namespace Backend
+	{
+		/**
+		 * Vulkan compute program class.
+		 */
+		class VulkanComputeProgram final : public ComputeProgram, public VulkanProgramLayout
+		{
+		public:
+			/**
+			 * Explicit constructor.
+			 *
+			 * @param pDevice The device to which the program is bound to.
+			 * @param computeShader The compute shader source.
+			 */
+			explicit VulkanComputeProgram(const std::shared_ptr<VulkanDevice>& pDevice, ShaderCode&& computeShader);
+
+			/**
+			 * Destructor.
+			 */
+			~VulkanComputeProgram() override;
+
+			/**
+			 * Terminate the object.
+			 */
+			void terminate() override;
+		};
+	}
+}
\ No newline at end of file
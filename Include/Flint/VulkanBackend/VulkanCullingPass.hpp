@@ -0,0 +1,258 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "VulkanDevice.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+
+namespace Flint
+{
+	namespace Backend
+	{
+		class VulkanRasterizingPipeline;
+		class VulkanComputeProgram;
+		class VulkanCommandBuffers;
+		class VulkanBuffer;
+
+		/**
+		 * Culling item structure.
+		 * There is one item for each instance of each indirect draw. The layout matches the culling shader's item buffer (std430).
+		 */
+		struct CullingItem final
+		{
+			glm::vec4 m_BoundingSphere = glm::vec4(0.0f);	// The world space center and the radius of the instance.
+
+			uint32_t m_Draw = 0;			// The index of the draw command in the pipeline's indirect command buffer.
+			uint32_t m_Instance = 0;		// The index of the instance in the draw entry.
+			uint32_t m_Batch = 0;			// The index of the draw count which is incremented. Large draw batches use multiple draw counts.
+			uint32_t m_FirstOutput = 0;		// The index of the first command which uses the item's draw count in the culled command buffer.
+		};
+
+		/**
+		 * Culling view structure.
+		 * The layout matches the culling shader's view uniform (std140).
+		 */
+		struct CullingView final
+		{
+			glm::mat4 m_View = glm::mat4(1.0f);
+			glm::mat4 m_Projection = glm::mat4(1.0f);
+
+			std::array<glm::vec4, 6> m_FrustumPlanes = {};	// World space planes. The normals point inside the frustum.
+
+			glm::vec2 m_PyramidSize = glm::vec2(0.0f);
+			uint32_t m_ItemCount = 0;
+			uint32_t m_EnableOcclusion = 0;
+		};
+
+		/**
+		 * Vulkan culling pass class.
+		 * This culls the indirect draws of a rasterizing pipeline on the GPU. Each instance of each draw is tested against the view frustum and against
+		 * a depth pyramid built from the previous frame's depth, and the visible ones are appended to a culled command buffer. Each batch has it's own
+		 * draw count which is consumed by an indirect count draw, so nothing is read back by the CPU.
+		 *
+		 * The commands are recorded to the rasterizer's command buffers, so they only need to be recorded again when the draws change. Moving the camera
+		 * only updates the view uniform.
+		 */
+		class VulkanCullingPass final
+		{
+			/**
+			 * Frame structure.
+			 * Each frame has it's own buffers so that they can be updated while the other frames are in flight.
+			 */
+			struct Frame final
+			{
+				std::shared_ptr<VulkanBuffer> m_pViewBuffer = nullptr;		// CullingView.
+				std::shared_ptr<VulkanBuffer> m_pItemBuffer = nullptr;		// CullingItem per item.
+				std::shared_ptr<VulkanBuffer> m_pCommandBuffer = nullptr;	// VkDrawIndexedIndirectCommand per item.
+				std::shared_ptr<VulkanBuffer> m_pDrawDataBuffer = nullptr;	// IndirectDrawData per item.
+				std::shared_ptr<VulkanBuffer> m_pCountBuffer = nullptr;		// Draw count per batch.
+
+				const VulkanBuffer* m_pSourceCommandBuffer = nullptr;
+				const VulkanBuffer* m_pSourceDrawDataBuffer = nullptr;
+
+				std::vector<VkDescriptorSet> m_PyramidDescriptorSets;	// One per pyramid level.
+				VkDescriptorSet m_CullingDescriptorSet = VK_NULL_HANDLE;
+
+				uint32_t m_ItemCount = 0;
+				uint32_t m_BatchCount = 0;
+			};
+
+		public:
+			/**
+			 * Explicit constructor.
+			 *
+			 * @param pipeline The pipeline which is culled.
+			 * @param pCullingProgram The program which culls the items.
+			 * @param pDepthPyramidProgram The program which reduces the depth to build the pyramid.
+			 */
+			explicit VulkanCullingPass(VulkanRasterizingPipeline& pipeline, const std::shared_ptr<VulkanComputeProgram>& pCullingProgram, const std::shared_ptr<VulkanComputeProgram>& pDepthPyramidProgram);
+
+			/**
+			 * Destructor.
+			 */
+			~VulkanCullingPass();
+
+			/**
+			 * Destroy the pass.
+			 */
+			void destroy();
+
+			/**
+			 * Recreate the depth pyramid.
+			 * This needs to be called when the rasterizer's attachments are recreated.
+			 */
+			void recreatePyramid();
+
+			/**
+			 * Update the items of a frame.
+			 * The frame must not be executing when this is called.
+			 *
+			 * @param frameIndex The frame index.
+			 * @param items The culling items. The items of a batch must be consecutive.
+			 * @param batchCount The number of draw counts, which is at least the number of draw batches.
+			 * @param pCommandBuffer The buffer containing the pipeline's draw commands. This can be nullptr if there are no items.
+			 * @param pDrawDataBuffer The buffer containing the pipeline's indirect draw data. This can be nullptr if there are no items.
+			 */
+			void update(uint32_t frameIndex, const std::vector<CullingItem>& items, uint32_t batchCount, const VulkanBuffer* pCommandBuffer, const VulkanBuffer* pDrawDataBuffer);
+
+			/**
+			 * Set the view which is used to cull the items.
+			 *
+			 * @param view The view matrix.
+			 * @param projection The projection matrix.
+			 */
+			void setView(const glm::mat4& view, const glm::mat4& projection);
+
+			/**
+			 * Copy the view to a frame's view uniform.
+			 * This needs to be called every frame, after the frame has finished executing.
+			 *
+			 * @param frameIndex The frame index.
+			 */
+			void uploadView(uint32_t frameIndex);
+
+			/**
+			 * Record the culling commands.
+			 * This must be recorded outside of a render pass, before the draws which consume the culled commands.
+			 *
+			 * @param commandBuffers The command buffers to record the commands.
+			 * @param frameIndex The frame index.
+			 */
+			void cull(const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex) const;
+
+			/**
+			 * Record the commands which build the depth pyramid from the frame's depth attachment.
+			 * This must be recorded after the render pass, so the next frame can use the pyramid.
+			 *
+			 * @param commandBuffers The command buffers to record the commands.
+			 * @param frameIndex The frame index.
+			 */
+			void buildDepthPyramid(const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex) const;
+
+			/**
+			 * Get the culled command buffer of a frame.
+			 *
+			 * @param frameIndex The frame index.
+			 * @return The buffer containing a VkDrawIndexedIndirectCommand per item. This is nullptr if there are no items.
+			 */
+			[[nodiscard]] const VulkanBuffer* getCommandBuffer(uint32_t frameIndex) const { return m_Frames[frameIndex].m_pCommandBuffer.get(); }
+
+			/**
+			 * Get the culled draw data buffer of a frame.
+			 * The draw data are written in the same order as the culled commands.
+			 *
+			 * @param frameIndex The frame index.
+			 * @return The buffer containing an IndirectDrawData per item. This is nullptr if there are no items.
+			 */
+			[[nodiscard]] const VulkanBuffer* getDrawDataBuffer(uint32_t frameIndex) const { return m_Frames[frameIndex].m_pDrawDataBuffer.get(); }
+
+			/**
+			 * Get the draw count buffer of a frame.
+			 *
+			 * @param frameIndex The frame index.
+			 * @return The buffer containing a 32-bit draw count per batch. This is nullptr if there are no items.
+			 */
+			[[nodiscard]] const VulkanBuffer* getCountBuffer(uint32_t frameIndex) const { return m_Frames[frameIndex].m_pCountBuffer.get(); }
+
+		private:
+			/**
+			 * Create a compute pipeline for a program.
+			 *
+			 * @param pProgram The program.
+			 * @return The pipeline handle.
+			 */
+			[[nodiscard]] VkPipeline createPipeline(const VulkanComputeProgram* pProgram) const;
+
+			/**
+			 * Create a descriptor pool which can allocate a number of sets of a program.
+			 *
+			 * @param pProgram The program.
+			 * @param setCount The number of sets.
+			 * @return The descriptor pool.
+			 */
+			[[nodiscard]] VkDescriptorPool createDescriptorPool(const VulkanComputeProgram* pProgram, uint32_t setCount) const;
+
+			/**
+			 * Allocate descriptor sets of a program.
+			 *
+			 * @param pProgram The program.
+			 * @param pool The pool to allocate from.
+			 * @param count The number of sets to allocate.
+			 * @return The descriptor sets.
+			 */
+			[[nodiscard]] std::vector<VkDescriptorSet> allocateDescriptorSets(const VulkanComputeProgram* pProgram, VkDescriptorPool pool, uint32_t count) const;
+
+			/**
+			 * Create the depth pyramid image, it's views and descriptor sets.
+			 */
+			void createPyramid();
+
+			/**
+			 * Destroy the depth pyramid image, it's views and descriptor sets.
+			 */
+			void destroyPyramid();
+
+			/**
+			 * Write the culling descriptor set of a frame.
+			 *
+			 * @param frameIndex The frame index.
+			 */
+			void writeCullingDescriptorSet(uint32_t frameIndex) const;
+
+		private:
+			std::vector<Frame> m_Frames;
+			std::vector<VkImageView> m_PyramidLevelViews;
+			std::vector<uint32_t> m_CullingDynamicOffsets;	// One (zero) offset per dynamic binding of the culling program.
+
+			VulkanRasterizingPipeline& m_Pipeline;
+			VulkanDevice& m_Device;
+
+			std::shared_ptr<VulkanComputeProgram> m_pCullingProgram = nullptr;
+			std::shared_ptr<VulkanComputeProgram> m_pDepthPyramidProgram = nullptr;
+
+			CullingView m_View = {};
+
+			VkPipeline m_CullingPipeline = VK_NULL_HANDLE;
+			VkPipeline m_DepthPyramidPipeline = VK_NULL_HANDLE;
+
+			VkDescriptorPool m_CullingDescriptorPool = VK_NULL_HANDLE;
+			VkDescriptorPool m_PyramidDescriptorPool = VK_NULL_HANDLE;
+
+			VkSampler m_Sampler = VK_NULL_HANDLE;
+
+			VkImage m_PyramidImage = VK_NULL_HANDLE;
+			VkImageView m_PyramidView = VK_NULL_HANDLE;
+			VmaAllocation m_PyramidAllocation = nullptr;
+
+			uint32_t m_PyramidWidth = 0;
+			uint32_t m_PyramidHeight = 0;
+
+			bool m_SupportsOcclusion = false;
+			bool m_HasPyramid = false;
+		};
+	}
+}
\ No newline at end of file
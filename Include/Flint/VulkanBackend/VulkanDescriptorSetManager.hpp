@@ -4,7 +4,9 @@
 #pragma once
 
 #include "Flint/Backend/MeshBindingTable.hpp"
-#include "VulkanDevice.hpp"
+#include "VulkanProgramLayout.hpp"
+
+#include <span>
 
 namespace Flint
 {
@@ -16,6 +18,9 @@ namespace Flint
 		 *
 		 * This works by using the hash of the resource binding table to find the corresponding descriptor set. If a descriptor set for the binding table does not exist, it creates a new one for it
 		 * and registers the table.
+		 *
+		 * Descriptor sets are allocated from a chain of fixed size descriptor pools. When the current pool is full, a new pool is added to the chain, so the existing
+		 * descriptor sets are never moved or copied.
 		 */
 		class VulkanDescriptorSetManager
 		{
@@ -32,12 +37,10 @@ namespace Flint
 				/**
 				 * Explicit constructor.
 				 *
-				 * @param copies The descriptor set copies.
 				 * @param sets The descriptor sets.
 				 */
-				explicit DescriptorSet(std::vector<VkCopyDescriptorSet>&& copies, std::vector<VkDescriptorSet>&& sets) : m_CopyDescriptorSets(std::move(copies)), m_DescriptorSets(sets) {}
+				explicit DescriptorSet(std::vector<VkDescriptorSet>&& sets) : m_DescriptorSets(std::move(sets)) {}
 
-				std::vector<VkCopyDescriptorSet> m_CopyDescriptorSets;
 				std::vector<VkDescriptorSet> m_DescriptorSets;
 			};
 
@@ -57,18 +60,40 @@ namespace Flint
 			/**
 			 * Setup the manager.
 			 *
+			 * @param layoutBindings The descriptor set layout bindings.
 			 * @param poolSizes The descriptor pool sizes.
 			 * @param layout The descriptor set layout to use.
+			 * @param updateTemplate The descriptor update template of the layout. This can be VK_NULL_HANDLE.
+			 * @param templateBindings The binding indices of the update template entries, in order.
 			 */
-			void setup(const std::vector<VkDescriptorSetLayoutBinding>& layoutBindings, const std::vector<VkDescriptorPoolSize>& poolSizes, VkDescriptorSetLayout layout);
+			void setup(const std::vector<VkDescriptorSetLayoutBinding>& layoutBindings, const std::vector<VkDescriptorPoolSize>& poolSizes, VkDescriptorSetLayout layout, VkDescriptorUpdateTemplate updateTemplate, const std::vector<uint32_t>& templateBindings);
 
 			/**
 			 * Register a table to the manager.
 			 * If a descriptor set exists for the table, it will not do anything.
 			 *
 			 * @param table The table to register.
+			 * @return The hash used to identify the table's descriptor set.
+			 */
+			uint64_t registerTable(const MeshBindingTable& table);
+
+			/**
+			 * Register multiple tables to the manager.
+			 * All the new descriptor sets are allocated and written in a single batch.
+			 *
+			 * @param tables The tables to register.
+			 * @return The hashes used to identify the tables' descriptor sets, in the same order as the tables.
+			 */
+			std::vector<uint64_t> registerTables(std::span<const MeshBindingTable> tables);
+
+			/**
+			 * Get the dynamic offsets of a table.
+			 * The offsets are ordered by the binding index as required by Vulkan.
+			 *
+			 * @param table The table to get the offsets from.
+			 * @return The dynamic offsets.
 			 */
-			void registerTable(const MeshBindingTable& table);
+			[[nodiscard]] std::vector<uint32_t> getDynamicOffsets(const MeshBindingTable& table) const;
 
 			/**
 			 * Get the descriptor set from the manager.
@@ -80,14 +105,60 @@ namespace Flint
 			 */
 			[[nodiscard]] VkDescriptorSet getDescriptorSet(uint64_t hash, uint32_t frameIndex) const;
 
+		private:
+			/**
+			 * Generate the descriptor set hash of a table.
+			 * Offsets of buffers bound to non-dynamic bindings are baked into the descriptor set, so they are a part of the hash.
+			 *
+			 * @param table The table to generate the hash of.
+			 * @return The hash.
+			 */
+			[[nodiscard]] uint64_t generateHash(const MeshBindingTable& table) const;
+
+			/**
+			 * Check if a table can be written using the descriptor update template.
+			 * The template writes every binding, so the table needs to bind all of them.
+			 *
+			 * @param table The table to check.
+			 * @return Whether or not the template can be used.
+			 */
+			[[nodiscard]] bool isTemplateCompatible(const MeshBindingTable& table) const;
+
+			/**
+			 * Pack the descriptors of a table in the update template's order.
+			 *
+			 * @param table The table to pack.
+			 * @return The packed template data.
+			 */
+			[[nodiscard]] std::vector<DescriptorUpdateData> getTemplateData(const MeshBindingTable& table) const;
+
+			/**
+			 * Allocate descriptor sets from the pool chain.
+			 * This will create new pools if the current pool does not have enough space.
+			 *
+			 * @param count The number of descriptor sets to allocate.
+			 * @return The allocated descriptor sets.
+			 */
+			[[nodiscard]] std::vector<VkDescriptorSet> allocateDescriptorSets(uint32_t count);
+
+			/**
+			 * Create a new descriptor pool and add it to the chain.
+			 */
+			void createDescriptorPool();
+
 		protected:
 			std::vector<VkDescriptorPoolSize> m_PoolSizes;
 
 			std::unordered_map<uint32_t, VkDescriptorType> m_DescriptorTypeMap;
 			std::unordered_map<uint64_t, DescriptorSet> m_DescriptorSets;
+			std::vector<uint32_t> m_DynamicBindings;
+			std::vector<uint32_t> m_TemplateBindings;
+
+			std::vector<VkDescriptorPool> m_DescriptorPools;
 
 			VkDescriptorSetLayout m_DescriptorSetLayout = VK_NULL_HANDLE;
-			VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
+			VkDescriptorUpdateTemplate m_DescriptorUpdateTemplate = VK_NULL_HANDLE;
+			uint32_t m_AvailableSets = 0;
 
 		private:
 			std::shared_ptr<VulkanDevice> m_pDevice = nullptr;
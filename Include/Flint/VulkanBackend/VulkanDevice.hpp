@@ -7,10 +7,14 @@
 #include "Flint/Backend/Types.hpp"
 #include "Flint/Core/Containers/SparseArray.hpp"
 #include "VulkanInstance.hpp"
+#include "VulkanBindlessDescriptor.hpp"
+#include "VulkanGeometryPool.hpp"
+#include "VulkanShaderCache.hpp"
 
 #include <vk_mem_alloc.h>
 
 #include <unordered_map>
+#include <atomic>
 
 namespace Flint
 {
@@ -96,13 +100,33 @@ namespace Flint
 			 */
 			[[nodiscard]] std::shared_ptr<RasterizingProgram> createRasterizingProgram(ShaderCode&& vertexShader, ShaderCode&& fragementShader) override;
 
+			/**
+			 * Create a new compute program.
+			 *
+			 * @param computeShader The compute shader code.
+			 * @return The compute program pointer.
+			 */
+			[[nodiscard]] std::shared_ptr<ComputeProgram> createComputeProgram(ShaderCode&& computeShader) override;
+
+			/**
+			 * Create a new compute pipeline.
+			 *
+			 * @param pProgram The compute program used by the pipeline.
+			 * @param pCacheHandler The pipeline cache handler. Default is nullptr.
+			 * @return The compute pipeline pointer.
+			 */
+			[[nodiscard]] std::shared_ptr<ComputePipeline> createComputePipeline(const std::shared_ptr<ComputeProgram>& pProgram, std::unique_ptr<PipelineCacheHandler>&& pCacheHandler = nullptr) override;
+
 			/**
 			 * Create a new static model.
 			 *
 			 * @param assetFile The asset file to load the data from.
+			 * @param memoryType The memory type used to store the vertex data. Default is exclusive.
+			 * @param vertexLayout The vertex inputs to pack when using the interleaved memory type, usually the program's vertex inputs. If empty, all the attributes in the asset are packed. Default is empty.
+			 * @param formatProfile The formats used to store the vertex attributes. Default is full.
 			 * @return The loaded static model.
 			 */
-			[[nodiscard]] std::shared_ptr<StaticModel> createStaticModel(std::filesystem::path&& assetFile) override;
+			[[nodiscard]] std::shared_ptr<StaticModel> createStaticModel(std::filesystem::path&& assetFile, VertexMemoryType memoryType = VertexMemoryType::Exclusive, std::vector<VertexInput>&& vertexLayout = {}, VertexFormatProfile formatProfile = VertexFormatProfile::Full) override;
 
 			/**
 			 * Create a new 2D texture image.
@@ -158,6 +182,22 @@ namespace Flint
 			 */
 			[[nodiscard]] Multisample getMaximumMultisample() const override;
 
+			/**
+			 * Get the minimum offset alignment required when binding a range of a buffer.
+			 *
+			 * @param usage The buffer usage.
+			 * @return The alignment in bytes.
+			 */
+			[[nodiscard]] uint64_t getBufferAlignment(BufferUsage usage) const override;
+
+			/**
+			 * Check if the device supports bindless resources.
+			 * If supported, texture views, samplers and storage buffers are given a stable bindless index when they are created.
+			 *
+			 * @return Whether or not bindless resources are supported.
+			 */
+			[[nodiscard]] bool isBindlessSupported() const override { return m_pBindlessDescriptor != nullptr; }
+
 		public:
 			/**
 			 * Get the physical device properties.
@@ -166,6 +206,31 @@ namespace Flint
 			 */
 			[[nodiscard]] const VkPhysicalDeviceProperties& getPhysicalDeviceProperties() const { return m_PhysicalDeviceProperties; }
 
+			/**
+			 * Check if the device supports multi draw indirect, with a non-zero first instance.
+			 *
+			 * @return Whether or not multi draw indirect is supported.
+			 */
+			[[nodiscard]] bool isMultiDrawIndirectSupported() const { return m_SupportsMultiDrawIndirect; }
+
+			/**
+			 * Check if the device supports draw indirect count.
+			 * This is only supported if multi draw indirect is supported.
+			 *
+			 * @return Whether or not draw indirect count is supported.
+			 */
+			[[nodiscard]] bool isDrawIndirectCountSupported() const { return m_SupportsDrawIndirectCount; }
+
+			/**
+			 * Check if pipeline cache data were created by this device and driver.
+			 * The data start with a VkPipelineCacheHeaderVersionOne, whose vendor ID, device ID and cache UUID must match the device's. Data which were
+			 * created by another driver version must not be given to the driver.
+			 *
+			 * @param data The pipeline cache data.
+			 * @return Whether or not the data can be used to create a pipeline cache.
+			 */
+			[[nodiscard]] bool isPipelineCacheCompatible(const std::vector<std::byte>& data) const;
+
 			/**
 			 * Get the Vulkan functions from the internal device table.
 			 *
@@ -229,6 +294,36 @@ namespace Flint
 			 */
 			[[nodiscard]] const Synchronized<VulkanQueue>& getTransferQueue() const { return m_TransferQueue; }
 
+			/**
+			 * Check if the compute queue is in a different family than the graphics queue.
+			 * If so, resources which are written by the compute queue and read by the graphics queue need to be shared between the two families.
+			 *
+			 * @return Whether or not the compute queue has it's own family.
+			 */
+			[[nodiscard]] bool hasDedicatedComputeQueue() const { return m_ComputeQueue.getUnsafe().m_Family != m_GraphicsQueue.getUnsafe().m_Family; }
+
+			/**
+			 * Get the compute timeline semaphore.
+			 * Compute submissions signal this semaphore and graphics submissions wait for the last signaled value.
+			 *
+			 * @return The semaphore.
+			 */
+			[[nodiscard]] VkSemaphore getComputeSemaphore() const { return m_ComputeSemaphore; }
+
+			/**
+			 * Get the value of the compute semaphore which is signaled by the last compute submission.
+			 *
+			 * @return The value. This is 0 if nothing was submitted to the compute queue.
+			 */
+			[[nodiscard]] uint64_t getComputeSignalValue() const { return m_ComputeSignalValue; }
+
+			/**
+			 * Get the next value for a compute submission to signal.
+			 *
+			 * @return The value.
+			 */
+			[[nodiscard]] uint64_t acquireComputeSignalValue() { return ++m_ComputeSignalValue; }
+
 			/**
 			 * Get the VMA allocator.
 			 *
@@ -243,6 +338,29 @@ namespace Flint
 			 */
 			[[nodiscard]] const Synchronized<VmaAllocator>& getAllocator() const { return m_Allocator; }
 
+			/**
+			 * Get the bindless descriptor.
+			 *
+			 * @return The bindless descriptor pointer. This will be nullptr if bindless resources are not supported.
+			 */
+			[[nodiscard]] VulkanBindlessDescriptor* getBindlessDescriptor() const { return m_pBindlessDescriptor.get(); }
+
+			/**
+			 * Get the geometry pool.
+			 * All the static models store their vertex and index data in this pool.
+			 *
+			 * @return The geometry pool.
+			 */
+			[[nodiscard]] VulkanGeometryPool& getGeometryPool() const { return *m_pGeometryPool; }
+
+			/**
+			 * Get the shader cache.
+			 * All the programs get their shader modules and reflections from this cache.
+			 *
+			 * @return The shader cache.
+			 */
+			[[nodiscard]] VulkanShaderCache& getShaderCache() const { return *m_pShaderCache; }
+
 		private:
 			/**
 			 * Select the best physical device for the engine.
@@ -271,6 +389,9 @@ namespace Flint
 
 		private:
 			std::unordered_map<uint64_t, std::shared_ptr<VulkanTextureSampler>> m_Samplers;
+			std::unique_ptr<VulkanBindlessDescriptor> m_pBindlessDescriptor = nullptr;
+			std::unique_ptr<VulkanGeometryPool> m_pGeometryPool = nullptr;
+			std::unique_ptr<VulkanShaderCache> m_pShaderCache = nullptr;
 
 			VkPhysicalDeviceProperties m_PhysicalDeviceProperties = {};
 
@@ -278,6 +399,9 @@ namespace Flint
 
 			std::vector<const char*> m_DeviceExtensions;
 
+			bool m_SupportsMultiDrawIndirect = false;
+			bool m_SupportsDrawIndirectCount = false;
+
 			Synchronized<VulkanQueue> m_GraphicsQueue;
 			Synchronized<VulkanQueue> m_ComputeQueue;
 			Synchronized<VulkanQueue> m_TransferQueue;
@@ -285,6 +409,9 @@ namespace Flint
 			VkPhysicalDevice m_PhysicalDevice = VK_NULL_HANDLE;
 			VkDevice m_LogicalDevice = VK_NULL_HANDLE;
 
+			VkSemaphore m_ComputeSemaphore = VK_NULL_HANDLE;
+			std::atomic<uint64_t> m_ComputeSignalValue = 0;
+
 			Synchronized<VmaAllocator> m_Allocator = nullptr;
 		};
 
@@ -0,0 +1,168 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Flint/Backend/Types.hpp"
+#include "Flint/Core/Containers/RangeAllocator.hpp"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Flint
+{
+	namespace Backend
+	{
+		class VulkanDevice;
+		class VulkanBuffer;
+		class VulkanVertexStorage;
+
+		/**
+		 * Vulkan geometry pool class.
+		 * This object owns the vertex and index buffers of all the static models of a device. Models only get a range of a shared buffer, so models with the
+		 * same vertex layout can be drawn without rebinding the vertex and index buffers, and loading or unloading a model does not allocate or free any
+		 * device memory once the pool has warmed up.
+		 *
+		 * Vertex data are stored in arenas, one per vertex memory type and attribute strides. Each arena contains a list of blocks which have a fixed
+		 * capacity. When all the blocks of an arena are full a new block is created instead of growing the existing ones, so the buffer handles which are
+		 * recorded in command buffers stay valid.
+		 */
+		class VulkanGeometryPool final
+		{
+			/**
+			 * Vertex block structure.
+			 * The attribute buffers are created when the first range which uses the attribute is allocated.
+			 */
+			struct VertexBlock final
+			{
+				std::unique_ptr<VulkanVertexStorage> m_pStorage = nullptr;
+				RangeAllocator m_Allocator;	// In vertices.
+			};
+
+			/**
+			 * Vertex arena structure.
+			 */
+			struct VertexArena final
+			{
+				std::array<uint32_t, EnumToInt(VertexAttribute::Max)> m_Strides = {};
+				std::vector<VertexBlock> m_Blocks;
+			};
+
+			/**
+			 * Index block structure.
+			 */
+			struct IndexBlock final
+			{
+				std::shared_ptr<VulkanBuffer> m_pBuffer = nullptr;
+				RangeAllocator m_Allocator;	// In bytes.
+			};
+
+		public:
+			/**
+			 * The default number of vertices in a vertex block.
+			 */
+			static constexpr uint64_t DefaultBlockVertexCount = 1 << 20;
+
+			/**
+			 * The default size of an index block in bytes.
+			 */
+			static constexpr uint64_t DefaultIndexBlockSize = 64 << 20;
+
+			/**
+			 * Vertex range structure.
+			 * This is a contiguous range of vertices in a single vertex block.
+			 */
+			struct VertexRange final
+			{
+				VulkanVertexStorage* m_pStorage = nullptr;
+
+				std::array<uint64_t, EnumToInt(VertexAttribute::Max)> m_Offsets = {};	// The byte offset of the first vertex in each attribute's buffer.
+
+				uint64_t m_ArenaHash = 0;
+				uint64_t m_Block = 0;
+
+				uint64_t m_FirstVertex = 0;
+				uint64_t m_VertexCount = 0;
+			};
+
+			/**
+			 * Index range structure.
+			 * This is a contiguous range of bytes in a single index block.
+			 */
+			struct IndexRange final
+			{
+				VulkanBuffer* m_pBuffer = nullptr;
+
+				uint64_t m_Block = 0;
+
+				uint64_t m_Offset = 0;	// Bytes.
+				uint64_t m_Size = 0;	// Bytes.
+			};
+
+		public:
+			/**
+			 * Explicit constructor.
+			 *
+			 * @param device The device to which the pool is bound to.
+			 */
+			explicit VulkanGeometryPool(VulkanDevice& device);
+
+			/**
+			 * Destructor.
+			 */
+			~VulkanGeometryPool();
+
+			/**
+			 * Destroy the pool.
+			 * This terminates all the buffers, so make sure that all the models are terminated beforehand.
+			 */
+			void destroy();
+
+			/**
+			 * Allocate a range of vertices.
+			 *
+			 * @param memoryType The vertex memory type.
+			 * @param strides The stride of each attribute. All the attributes which can be stored in the format profile should have their stride set, even if
+			 * they are not used, so models with different attributes can share the same arena. If the memory type is interleaved, only the first stride is used.
+			 * @param usedAttributes The attributes which need to have a buffer. This is ignored if the memory type is interleaved.
+			 * @param vertexCount The number of vertices.
+			 * @return The vertex range.
+			 */
+			[[nodiscard]] VertexRange allocateVertices(VertexMemoryType memoryType, const std::array<uint32_t, EnumToInt(VertexAttribute::Max)>& strides, const std::array<bool, EnumToInt(VertexAttribute::Max)>& usedAttributes, uint64_t vertexCount);
+
+			/**
+			 * Free a range of vertices.
+			 *
+			 * @param range The range to free.
+			 */
+			void freeVertices(const VertexRange& range);
+
+			/**
+			 * Allocate a range of index memory.
+			 * The range's offset is aligned to 4 bytes so that it's a multiple of both index sizes.
+			 *
+			 * @param size The size of the range in bytes.
+			 * @return The index range.
+			 */
+			[[nodiscard]] IndexRange allocateIndices(uint64_t size);
+
+			/**
+			 * Free a range of index memory.
+			 *
+			 * @param range The range to free.
+			 */
+			void freeIndices(const IndexRange& range);
+
+		private:
+			std::unordered_map<uint64_t, VertexArena> m_VertexArenas;
+			std::vector<IndexBlock> m_IndexBlocks;
+
+			VulkanDevice& m_Device;
+
+			std::mutex m_Mutex;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,210 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Flint/Backend/Program.hpp"
+#include "Flint/Backend/ShaderCode.hpp"
+#include "VulkanDevice.hpp"
+
+#include <array>
+#include <unordered_map>
+
+namespace Flint
+{
+	namespace Backend
+	{
+		/**
+		 * Descriptor update data union.
+		 * The descriptor update template reads one of these per binding, so a table's descriptors can be packed into a single array.
+		 */
+		union DescriptorUpdateData
+		{
+			VkDescriptorImageInfo m_ImageInfo;
+			VkDescriptorBufferInfo m_BufferInfo;
+		};
+
+		/**
+		 * Vulkan program layout class.
+		 * This contains the shader modules, descriptor set layout and the pipeline layout of a program, which are created by reflecting the program's
+		 * shaders. Both the rasterizing and the compute programs derive from this so the reflection code is shared between them.
+		 */
+		class VulkanProgramLayout
+		{
+		public:
+			/**
+			 * Shader interface structure.
+			 * This contains the reflected information which is specific to a single shader stage.
+			 */
+			struct ShaderInterface final
+			{
+				std::vector<VertexInput> m_VertexInputs;		// Only set for vertex shaders.
+				std::vector<InstanceInput> m_InstanceInputs;	// Only set for vertex shaders.
+
+				std::array<uint32_t, 3> m_WorkGroupSize = { 1, 1, 1 };	// Only set for compute shaders.
+			};
+
+			/**
+			 * Specialization constant information structure.
+			 * This contains the reflected information of a single specialization constant.
+			 */
+			struct SpecializationConstantInfo final
+			{
+				uint32_t m_ConstantID = 0;
+				uint32_t m_Size = 0;
+			};
+
+		public:
+			/**
+			 * Explicit constructor.
+			 *
+			 * @param device The device to which the layout is bound to.
+			 */
+			explicit VulkanProgramLayout(VulkanDevice& device) : m_Device(device) {}
+
+			/**
+			 * Get the pipeline layout.
+			 *
+			 * @return The pipeline layout.
+			 */
+			[[nodiscard]] VkPipelineLayout getPipelineLayout() const { return m_PipelineLayout; }
+
+			/**
+			 * Get the descriptor set layout.
+			 *
+			 * @return The descriptor set layout.
+			 */
+			[[nodiscard]] VkDescriptorSetLayout getDescriptorSetLayout() const { return m_DescriptorSetLayout; }
+
+			/**
+			 * Get the descriptor update template.
+			 * The template expects an array of DescriptorUpdateData, one per template binding.
+			 *
+			 * @return The descriptor update template. This will be VK_NULL_HANDLE if the program does not have any bindings.
+			 */
+			[[nodiscard]] VkDescriptorUpdateTemplate getDescriptorUpdateTemplate() const { return m_DescriptorUpdateTemplate; }
+
+			/**
+			 * Get the binding indices of the descriptor update template entries, in order.
+			 *
+			 * @return The binding indices.
+			 */
+			[[nodiscard]] const std::vector<uint32_t>& getTemplateBindings() const { return m_TemplateBindings; }
+
+			/**
+			 * Get the shader stage create info structures.
+			 *
+			 * @return The structure vector.
+			 */
+			[[nodiscard]] const std::vector<VkPipelineShaderStageCreateInfo>& getPipelineShaderStageCreateInfos() const { return m_ShaderStageCreateInfos; }
+
+			/**
+			 * Get the descriptor layout bindings.
+			 *
+			 * @return The bindings.
+			 */
+			[[nodsicard]] const std::vector<VkDescriptorSetLayoutBinding>& getLayoutBindings() const { return m_LayoutBindings; }
+
+			/**
+			 * Get the descriptor pool sizes.
+			 *
+			 * @return The sizes.
+			 */
+			[[nodsicard]] const std::vector<VkDescriptorPoolSize>& getPoolSizes() const { return m_PoolSizes; }
+
+			/**
+			 * Get the shader stages which use push constants.
+			 *
+			 * @return The stage flags.
+			 */
+			[[nodiscard]] VkShaderStageFlags getPushConstantStageFlags() const { return m_PushConstantStageFlags; }
+
+			/**
+			 * Get the part of the push constant range which a block of constants covers.
+			 * The constants are laid out from offset 0, but only the bytes within the range shared by all the stages can be pushed.
+			 *
+			 * @param size The size of the constants in bytes.
+			 * @return The range to push. The size is 0 if the constants do not reach the range.
+			 */
+			[[nodiscard]] VkPushConstantRange getPushConstantRange(uint64_t size) const;
+
+			/**
+			 * Get the specialization constants of all the shaders, by their names.
+			 * Constants which are not named in the SPIR-V can only be set using their constant IDs, and are not in this map.
+			 *
+			 * @return The specialization constants.
+			 */
+			[[nodiscard]] const std::unordered_map<std::string, SpecializationConstantInfo>& getSpecializationConstants() const { return m_SpecializationConstants; }
+
+			/**
+			 * Check if the program uses the device's bindless descriptor set.
+			 * This is true if any of the shaders declare resources in the BindlessDescriptorSet set.
+			 *
+			 * @return Whether or not the bindless descriptor set is used.
+			 */
+			[[nodiscard]] bool usesBindless() const { return m_UsesBindless; }
+
+		protected:
+			/**
+			 * Reflect a shader and get it's shader module.
+			 * The reflection and the module are taken from the device's shader cache. The shader's resource bindings are registered in the binding map
+			 * and it's push constants are collected for the pipeline layout.
+			 *
+			 * @param shader The shader source.
+			 * @param stage The shader stage.
+			 * @param bindingMap The binding map to register the resources to.
+			 * @return The stage specific information of the shader.
+			 */
+			[[nodiscard]] ShaderInterface createShaderModule(const ShaderCode& shader, VkShaderStageFlagBits stage, BindingMap& bindingMap);
+
+			/**
+			 * Create the descriptor set layout, the descriptor update template and the pipeline layout.
+			 * This must be called after all the shader modules are created.
+			 *
+			 * @param bindingMap The binding map of the program.
+			 */
+			void createLayout(const BindingMap& bindingMap);
+
+			/**
+			 * Release the shader modules and destroy the layouts.
+			 */
+			void destroyLayout();
+
+		private:
+			/**
+			 * Create the descriptor set layout.
+			 */
+			void createDescriptorSetLayout();
+
+			/**
+			 * Create the descriptor update template using the binding map.
+			 *
+			 * @param bindingMap The binding map of the program.
+			 */
+			void createDescriptorUpdateTemplate(const BindingMap& bindingMap);
+
+			/**
+			 * Create the pipeline layout.
+			 */
+			void createPipelineLayout();
+
+		private:
+			std::vector<uint64_t> m_ShaderHashes;	// The shader modules are owned by the device's shader cache.
+			std::vector<VkPipelineShaderStageCreateInfo> m_ShaderStageCreateInfos;
+			std::vector<VkDescriptorSetLayoutBinding> m_LayoutBindings;
+			std::vector<VkDescriptorPoolSize> m_PoolSizes;
+			std::vector<VkPushConstantRange> m_PushConstants;
+			std::vector<uint32_t> m_TemplateBindings;
+			std::unordered_map<std::string, SpecializationConstantInfo> m_SpecializationConstants;
+
+			VulkanDevice& m_Device;
+
+			VkDescriptorSetLayout m_DescriptorSetLayout = VK_NULL_HANDLE;
+			VkDescriptorUpdateTemplate m_DescriptorUpdateTemplate = VK_NULL_HANDLE;
+			VkPipelineLayout m_PipelineLayout = VK_NULL_HANDLE;
+
+			VkShaderStageFlags m_PushConstantStageFlags = 0;
+			bool m_UsesBindless = false;
+		};
+	}
+}
\ No newline at end of file
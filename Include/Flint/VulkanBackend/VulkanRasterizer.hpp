@@ -71,6 +71,14 @@ namespace Flint
 			 */
 			[[nodiscard]] const VulkanRenderTargetAttachment& getAttachment(uint32_t index) const override;
 
+			/**
+			 * Get the depth attachment which is used by a frame.
+			 *
+			 * @param frameIndex The frame index.
+			 * @return The depth attachment. This is nullptr if the rasterizer does not have a depth attachment.
+			 */
+			[[nodiscard]] const VulkanRenderTargetAttachment* getDepthAttachment(uint32_t frameIndex) const;
+
 			/**
 			 * Create a new rasterizing pipeline.
 			 *
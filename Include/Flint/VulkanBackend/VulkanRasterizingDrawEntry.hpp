@@ -23,8 +23,13 @@ namespace Flint
 			 */
 			struct MeshDrawer final
 			{
+				std::vector<uint32_t> m_DynamicOffsets;
+				std::vector<std::byte> m_Constants;
+
 				uint64_t m_PipelineHash = 0;
 				uint64_t m_ResourceHash = 0;
+
+				std::vector<uint8_t> m_InstanceLevels;	// The selected level of detail of each instance. Empty if all the instances use the full mesh.
 			};
 
 		public:
@@ -46,13 +51,25 @@ namespace Flint
 			 */
 			[[nodiscard]] DrawInstance instance(const glm::vec3& position = glm::vec3(0.0f), const glm::vec3& rotation = glm::vec3(0.0f), const glm::vec3& scale = glm::vec3(1.0f)) override;
 
+			/**
+			 * Select the level of detail of each instance.
+			 * The lowest detailed level whose simplification error projects to at most the threshold on the screen is selected. This needs to be called
+			 * whenever the camera or the instances move.
+			 *
+			 * @param camera The camera which is used to render the instances.
+			 * @param threshold The maximum allowed error in pixels. Default is 1.
+			 */
+			void selectLevelsOfDetail(const Camera& camera, float threshold = 1.0f) override;
+
 			/**
 			 * Register a mesh to the entry.
 			 *
 			 * @param pipelineHash The pipeline hash used to render.
 			 * @param resourceHash The resource hash used to properly bind the requested resources.
+			 * @param dynamicOffsets The dynamic buffer offsets used when binding the resources. Default is empty.
+			 * @param constants The push constant data of the mesh. Default is empty.
 			 */
-			void registerMesh(uint64_t pipelineHash, uint64_t resourceHash);
+			void registerMesh(uint64_t pipelineHash, uint64_t resourceHash, std::vector<uint32_t>&& dynamicOffsets = {}, std::vector<std::byte>&& constants = {});
 
 			/**
 			 * Get the mesh drawers.
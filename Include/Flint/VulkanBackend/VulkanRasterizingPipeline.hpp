@@ -9,6 +9,8 @@
 
 #include <thread>
 #include <condition_variable>
+#include <future>
+#include <optional>
 
 namespace Flint
 {
@@ -17,6 +19,22 @@ namespace Flint
 		class VulkanRasterizer;
 		class VulkanRasterizingProgram;
 		class VulkanCommandBuffers;
+		class VulkanBuffer;
+		class VulkanVertexStorage;
+		class VulkanCullingPass;
+
+		/**
+		 * Indirect draw data structure.
+		 * When the meshes are drawn indirectly, one of these is stored for each draw command, in the same order as the commands. Passes which process the
+		 * draw commands on the GPU (like culling) use this to find which instances a command draws.
+		 */
+		struct IndirectDrawData final
+		{
+			uint32_t m_EntryIndex = 0;		// The index of the draw entry in the pipeline. This selects the model and the instance transforms.
+			uint32_t m_MeshIndex = 0;		// The index of the mesh in the model. This selects the mesh's material.
+			uint32_t m_FirstInstance = 0;	// The index of the first instance in the draw entry.
+			uint32_t m_LevelOfDetail = 0;
+		};
 
 		/**
 		 * Vulkan rasterizing pipeline class.
@@ -33,8 +51,7 @@ namespace Flint
 				std::vector<VkVertexInputBindingDescription> m_InputBindings;
 				std::vector<VkVertexInputAttributeDescription> m_InputAttributes;
 
-				VkPipeline m_Pipeline = VK_NULL_HANDLE;
-				VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+				VkPipeline m_Pipeline = VK_NULL_HANDLE;	// This is VK_NULL_HANDLE till the variation is compiled.
 			};
 
 			/**
@@ -46,6 +63,45 @@ namespace Flint
 			 */
 			using DrawCall = std::function<void(const VulkanCommandBuffers&, uint32_t)>;
 
+			/**
+			 * Draw batch structure.
+			 * A batch contains the draws which share the same pipeline, resources, vertex storage and index buffer. All the draws of a batch are issued
+			 * using a single indirect draw.
+			 */
+			struct DrawBatch final
+			{
+				std::vector<uint32_t> m_DynamicOffsets;
+				std::vector<std::byte> m_Constants;
+
+				const VulkanVertexStorage* m_pVertexStorage = nullptr;
+				VkBuffer m_IndexBuffer = VK_NULL_HANDLE;
+				IndexType m_IndexType = IndexType::Uint32;
+
+				uint64_t m_PipelineHash = 0;
+				uint64_t m_ResourceHash = 0;
+
+				uint64_t m_FirstDraw = 0;
+				uint64_t m_DrawCount = 0;
+
+				uint64_t m_FirstCulledDraw = 0;	// The index of the batch's first command in the culled command buffer.
+				uint64_t m_CulledDrawCount = 0;	// The maximum number of culled commands, which is the number of instances in the batch.
+				uint64_t m_FirstCountSlot = 0;	// The index of the batch's first draw count. Each count covers at most maxDrawIndirectCount culled commands.
+			};
+
+			/**
+			 * Indirect draws structure.
+			 * Each frame has it's own buffers so that they can be regenerated while the other frames are in flight.
+			 */
+			struct IndirectDraws final
+			{
+				std::vector<DrawBatch> m_Batches;
+
+				std::shared_ptr<VulkanBuffer> m_pCommandBuffer = nullptr;	// VkDrawIndexedIndirectCommand per draw.
+				std::shared_ptr<VulkanBuffer> m_pDrawDataBuffer = nullptr;	// IndirectDrawData per draw.
+
+				uint64_t m_Version = 0;
+			};
+
 			/**
 			 * Worker payload structure.
 			 */
@@ -79,6 +135,7 @@ namespace Flint
 
 			/**
 			 * Recreate the pipeline.
+			 * This is called when the rasterizer's extent changes. The variations are only recreated if the viewport or the scissor is not dynamic.
 			 */
 			void recreate();
 
@@ -91,6 +148,37 @@ namespace Flint
 			 */
 			[[nodiscard]] std::shared_ptr<DrawEntry> attach(const std::shared_ptr<StaticModel>& pModel, ResourceBinder&& binder) override;
 
+			/**
+			 * Check if any variations were compiled in the background since the last call, and if so, notify the render target so the meshes which use
+			 * them are drawn.
+			 * This needs to be called every frame, from the thread which updates the rasterizer.
+			 */
+			void updateVariations();
+
+			/**
+			 * Wait till all the variations which are compiled in the background are ready.
+			 * This rethrows the first error thrown while compiling.
+			 */
+			void waitForCompilations();
+
+			/**
+			 * Enable GPU culling.
+			 * Every instance of every mesh is tested against the camera frustum and a depth pyramid built from the previous frame's depth, and only the
+			 * visible ones are drawn.
+			 *
+			 * @param pCullingProgram The program which culls the instances.
+			 * @param pDepthPyramidProgram The program which reduces the depth.
+			 */
+			void enableCulling(const std::shared_ptr<ComputeProgram>& pCullingProgram, const std::shared_ptr<ComputeProgram>& pDepthPyramidProgram) override;
+
+			/**
+			 * Set the view which is used to cull the instances.
+			 *
+			 * @param view The view matrix.
+			 * @param projection The projection matrix.
+			 */
+			void setCullingView(const glm::mat4& view, const glm::mat4& projection) override;
+
 			/**
 			 * Load the pipeline cache from the handler if possible.
 			 *
@@ -109,6 +197,7 @@ namespace Flint
 
 			/**
 			 * Notify the render target to update.
+			 * This also marks the indirect draws as out of date, so they are regenerated when the frames are recorded again.
 			 */
 			void notifyRenderTarget();
 
@@ -137,19 +226,64 @@ namespace Flint
 
 			/**
 			 * Issue all the draw calls.
+			 * If the device supports multi draw indirect, the draws are issued indirectly with a single draw per batch, else each mesh is drawn directly.
 			 *
 			 * @param commandBuffers The command buffers to record the commands.
 			 * @param frameIndex The current frame index.
 			 */
-			void issueDrawCalls(const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex) const;
+			void issueDrawCalls(const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex);
+
+			/**
+			 * Copy the culling view to a frame.
+			 * This needs to be called every frame, after the frame has finished executing.
+			 *
+			 * @param frameIndex The current frame index.
+			 */
+			void uploadCullingView(uint32_t frameIndex);
+
+			/**
+			 * Record the culling commands.
+			 * This regenerates the indirect draws if needed, so it must be called before the draw calls are issued, outside of the render pass.
+			 *
+			 * @param commandBuffers The command buffers to record the commands.
+			 * @param frameIndex The current frame index.
+			 */
+			void cull(const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex);
+
+			/**
+			 * Record the commands which build the depth pyramid used to cull the next frame.
+			 * This must be called after the render pass.
+			 *
+			 * @param commandBuffers The command buffers to record the commands.
+			 * @param frameIndex The current frame index.
+			 */
+			void buildDepthPyramid(const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex) const;
+
+			/**
+			 * Get the indirect draw data buffer of a frame.
+			 * If the draws are culled, this is the culled draw data buffer which is in the same order as the culled commands.
+			 *
+			 * @param frameIndex The frame index.
+			 * @return The buffer containing an IndirectDrawData per draw. This is nullptr if there is nothing to draw indirectly.
+			 */
+			[[nodiscard]] const VulkanBuffer* getDrawDataBuffer(uint32_t frameIndex) const;
+
+			/**
+			 * Get the pipeline cache.
+			 * All the pipelines created by this pipeline (the variations and the culling pipelines) share this cache, so a single cache is stored for
+			 * the whole pipeline.
+			 *
+			 * @return The pipeline cache.
+			 */
+			[[nodiscard]] VkPipelineCache getPipelineCache() const { return m_PipelineCache; }
 
 			/**
 			 * Get the pipeline handle.
 			 *
 			 * @param identifier The pipeline identifier.
-			 * @return The Vulkan pipeline handle.
+			 * @return The Vulkan pipeline handle. This is VK_NULL_HANDLE if the variation is still being compiled.
 			 */
-			[[nodiscard]] VkPipeline getPipelineHandle(uint64_t identifier) const { return m_Pipelines.at(identifier).m_Pipeline; }
+			[[nodiscard]] VkPipeline getPipelineHandle(uint64_t identifier) const;
 
 		private:
 			/**
@@ -168,6 +302,56 @@ namespace Flint
 			 */
 			[[nodiscard]] VkPipeline createVariation(VkPipelineVertexInputStateCreateInfo&& inputState, VkPipelineCache cache);
 
+			/**
+			 * Compile the registered pipeline variations in parallel.
+			 *
+			 * @param identifiers The identifiers of the variations to compile.
+			 */
+			void compileVariations(const std::vector<uint64_t>& identifiers);
+
+			/**
+			 * Load the variation manifest from the cache handler and compile it's variations in the background.
+			 * The manifest contains the vertex layouts of all the variations which were used by the previous sessions with the same program,
+			 * specification and render pass, so they are ready before the models which need them are attached.
+			 */
+			void warmUp();
+
+			/**
+			 * Store the variation manifest using the cache handler.
+			 */
+			void saveManifest() const;
+
+			/**
+			 * Regenerate the indirect draws of a frame if the draw entries have changed since they were generated.
+			 *
+			 * @param frameIndex The frame index.
+			 */
+			void updateIndirectDraws(uint32_t frameIndex);
+
+			/**
+			 * Issue the indirect draws of a frame.
+			 *
+			 * @param commandBuffers The command buffers to record the commands.
+			 * @param frameIndex The frame index.
+			 */
+			void issueIndirectDrawCalls(const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex) const;
+
+			/**
+			 * Check if the draws are issued indirectly.
+			 * This requires the device to support multi draw indirect, and the program not to use the draw data push constant.
+			 *
+			 * @return Whether or not the draws are indirect.
+			 */
+			[[nodiscard]] bool isDrawnIndirectly() const;
+
+			/**
+			 * Check if the draws are culled on the GPU.
+			 * This requires culling to be enabled, the draws to be indirect and the device to support draw indirect count.
+			 *
+			 * @return Whether or not the draws are culled.
+			 */
+			[[nodiscard]] bool isCulling() const;
+
 			/**
 			 * Worker function.
 			 * This function is used to bind resources to secondary command buffers.
@@ -187,6 +371,12 @@ namespace Flint
 			std::atomic<bool> m_Updated = false;
 
 			std::unordered_map<uint64_t, Pipeline> m_Pipelines;
+			mutable std::mutex m_PipelineMutex;
+			mutable std::mutex m_CacheMutex;
+
+			std::vector<std::future<void>> m_CompilationTasks;
+			std::atomic<bool> m_HasCompiledVariations = false;
+
 			VulkanDescriptorSetManager m_DescriptorSetManager;
 
 			VkPipelineInputAssemblyStateCreateInfo m_InputAssemblyStateCreateInfo = {};
@@ -196,6 +386,7 @@ namespace Flint
 			VkPipelineMultisampleStateCreateInfo m_MultisampleStateCreateInfo = {};
 			VkPipelineDepthStencilStateCreateInfo m_DepthStencilStateCreateInfo = {};
 			VkPipelineDynamicStateCreateInfo m_DynamicStateCreateInfo = {};
+			VkSpecializationInfo m_SpecializationInfo = {};
 
 			WorkerPayload m_WorkerPayload = {};
 			std::shared_ptr<VulkanCommandBuffers> m_pSecondaryCommandBuffers = nullptr;
@@ -203,9 +394,22 @@ namespace Flint
 			std::vector<VkPipelineColorBlendAttachmentState> m_CBASS = {};
 			std::vector<VkPipelineShaderStageCreateInfo> m_ShaderStageCreateInfo = {};
 			std::vector<VkDynamicState> m_DynamicStates = {};
+			std::vector<VkSpecializationMapEntry> m_SpecializationMapEntries = {};
+			std::vector<uint32_t> m_SpecializationData = {};
 
 			std::vector<std::shared_ptr<DrawEntry>> m_pDrawEntries;
 			std::vector<DrawCall> m_DrawCalls;
+
+			std::vector<IndirectDraws> m_IndirectDraws;
+			std::atomic<uint64_t> m_DrawVersion = 1;
+
+			std::unique_ptr<VulkanCullingPass> m_pCullingPass = nullptr;
+
+			VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+			uint64_t m_Identifier = 0;
+			uint64_t m_ManifestIdentifier = 0;
+
+			std::optional<uint32_t> m_DrawDataOffset = std::nullopt;
 		};
 	}
 }
\ No newline at end of file
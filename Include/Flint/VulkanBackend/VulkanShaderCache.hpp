@@ -0,0 +1,143 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Flint/Backend/Types.hpp"
+#include "Flint/Backend/Program.hpp"
+#include "Flint/Backend/ShaderCode.hpp"
+
+#include <volk.h>
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Flint
+{
+	namespace Backend
+	{
+		class VulkanDevice;
+
+		/**
+		 * Shader reflection structure.
+		 * This contains everything a program needs from a shader's reflection. It does not depend on the device, so it can be stored and reused by the
+		 * later sessions.
+		 */
+		struct ShaderReflection final
+		{
+			/**
+			 * Descriptor binding structure.
+			 */
+			struct DescriptorBinding final
+			{
+				std::string m_Name;
+				uint32_t m_Set = 0;
+				uint32_t m_Binding = 0;
+				uint32_t m_Count = 0;
+				VkDescriptorType m_Type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;	// The reflected type. This is never dynamic.
+			};
+
+			/**
+			 * Push constant block structure.
+			 */
+			struct PushConstantBlock final
+			{
+				std::vector<BindingMap::PushConstant> m_Members;
+				uint32_t m_Offset = 0;
+				uint32_t m_Size = 0;
+			};
+
+			/**
+			 * Specialization constant structure.
+			 * Only the named constants are reflected.
+			 */
+			struct SpecializationConstant final
+			{
+				std::string m_Name;
+				uint32_t m_ConstantID = 0;
+				uint32_t m_Size = 0;
+			};
+
+			std::vector<VertexInput> m_VertexInputs;		// Only set for vertex shaders.
+			std::vector<InstanceInput> m_InstanceInputs;	// Only set for vertex shaders.
+
+			std::vector<DescriptorBinding> m_Bindings;
+			std::vector<PushConstantBlock> m_PushConstantBlocks;
+			std::vector<SpecializationConstant> m_SpecializationConstants;
+
+			std::array<uint32_t, 3> m_WorkGroupSize = { 1, 1, 1 };	// Only set for compute shaders.
+		};
+
+		/**
+		 * Vulkan shader cache class.
+		 * This is owned by the device and is shared by all the programs. Shader modules are identified by the hash of their code, so programs which use
+		 * the same shader share a single module. The reflection results are kept for the lifetime of the device and are stored using the device's shader
+		 * cache handler, so a shader is only reflected once, across sessions.
+		 */
+		class VulkanShaderCache final
+		{
+			/**
+			 * Shader module structure.
+			 */
+			struct ShaderModule final
+			{
+				VkShaderModule m_Module = VK_NULL_HANDLE;
+				uint32_t m_ReferenceCount = 0;
+			};
+
+		public:
+			/**
+			 * Explicit constructor.
+			 *
+			 * @param device The device reference.
+			 */
+			explicit VulkanShaderCache(VulkanDevice& device) : m_Device(device) {}
+
+			/**
+			 * Destroy the cache.
+			 * This destroys the remaining shader modules.
+			 */
+			void destroy();
+
+			/**
+			 * Get the reflection of a shader.
+			 * The shader is reflected only if it's neither in memory nor in the device's shader cache handler.
+			 *
+			 * @param shader The shader code.
+			 * @param stage The shader stage.
+			 * @return The shader reflection.
+			 */
+			[[nodiscard]] std::shared_ptr<const ShaderReflection> getReflection(const ShaderCode& shader, VkShaderStageFlagBits stage);
+
+			/**
+			 * Acquire the shader module of a shader.
+			 * The module is created if no other program uses it. Each acquired module must be released using releaseModule().
+			 *
+			 * @param shader The shader code.
+			 * @return The shader module.
+			 */
+			[[nodiscard]] VkShaderModule acquireModule(const ShaderCode& shader);
+
+			/**
+			 * Release a shader module.
+			 * The module is destroyed when no program uses it.
+			 *
+			 * @param hash The hash of the shader code.
+			 */
+			void releaseModule(uint64_t hash);
+
+		private:
+			std::unordered_map<uint64_t, ShaderModule> m_Modules;
+			std::unordered_map<uint64_t, std::shared_ptr<const ShaderReflection>> m_Reflections;
+
+			VulkanDevice& m_Device;
+
+			std::mutex m_Mutex;
+			std::mutex m_HandlerMutex;
+		};
+	}
+}
\ No newline at end of file
@@ -10,6 +10,8 @@ namespace Flint
 {
 	namespace Backend
 	{
+		class VulkanCommandBuffers;
+
 		/**
 		 * Vulkan static model class.
 		 */
@@ -21,8 +23,11 @@ namespace Flint
 			 *
 			 * @param pDevice The device reference.
 			 * @param assetFile The asset file to load the data from.
+			 * @param memoryType The memory type used to store the vertex data. Exclusive storage is useful when only a few attributes are used, like in position-only depth passes. Default is exclusive.
+			 * @param vertexLayout The vertex inputs to pack when using the interleaved memory type. If empty, all the attributes in the asset are packed. Default is empty.
+			 * @param formatProfile The formats used to store the vertex attributes. Default is full.
 			 */
-			explicit VulkanStaticModel(const std::shared_ptr<VulkanDevice>& pDevice, std::filesystem::path&& assetFile);
+			explicit VulkanStaticModel(const std::shared_ptr<VulkanDevice>& pDevice, std::filesystem::path&& assetFile, VertexMemoryType memoryType = VertexMemoryType::Exclusive, std::vector<VertexInput>&& vertexLayout = {}, VertexFormatProfile formatProfile = VertexFormatProfile::Full);
 
 			/**
 			 * Destructor.
@@ -35,7 +40,8 @@ namespace Flint
 			void terminate() override;
 
 			/**
-			 * Compile the loaded data to a compressed binary which can be loaded easily.
+			 * Compile the loaded data to the cooked static model format.
+			 * The vertex and index data are read back from the GPU, so this is meant to be used when cooking the assets, not at runtime.
 			 *
 			 * @return The compiled binary data.
 			 */
@@ -61,27 +67,112 @@ namespace Flint
 
 			/**
 			 * Get the vertex storage.
+			 * The storage is shared with the other models which were allocated in the same block of the device's geometry pool.
 			 *
 			 * @return The vertex storage.
 			 */
-			[[nodiscard]] const VulkanVertexStorage& getVertexStorage() const { return m_VertexStorage; }
+			[[nodiscard]] const VulkanVertexStorage& getVertexStorage() const { return *m_VertexRange.m_pStorage; }
+
+			/**
+			 * Get the vertex memory type.
+			 *
+			 * @return The memory type.
+			 */
+			[[nodiscard]] VertexMemoryType getMemoryType() const { return m_MemoryType; }
+
+			/**
+			 * Get the vertex format profile.
+			 *
+			 * @return The format profile.
+			 */
+			[[nodiscard]] VertexFormatProfile getFormatProfile() const { return m_FormatProfile; }
 
 			/**
 			 * Get the index buffer handle.
+			 * The buffer is shared with the other models which were allocated in the same block of the device's geometry pool. The mesh index offsets
+			 * already point to this model's range.
 			 *
 			 * @return The buffer handle.
 			 */
-			[[nodiscard]] const VkBuffer getIndexBufferHandle() const { return m_pIndexBuffer->getBuffer(); }
+			[[nodiscard]] const VkBuffer getIndexBufferHandle() const { return m_IndexRange.m_pBuffer->getBuffer(); }
 
 		private:
 			/**
-			 * Load the model data.
+			 * Load the model data using the importer.
 			 */
 			void loadData();
 
+			/**
+			 * Load the model data from a glTF 2.0 asset, without going through the importer.
+			 * The JSON is parsed on a worker thread and the buffers are memory mapped.
+			 *
+			 * @return Whether the data were loaded. This is false if the asset uses features which are not supported by the native loader, in which case
+			 * nothing is loaded and the importer should be used instead.
+			 */
+			[[nodiscard]] bool loadGLTFData();
+
+			/**
+			 * Load the model data from a cooked static model file.
+			 * The file is mapped and the vertex and index blobs are copied to the staging buffers as they are.
+			 */
+			void loadCookedData();
+
+			/**
+			 * Setup the interleaved vertex layout.
+			 * This computes the offset of each attribute within a single vertex and the vertex stride.
+			 *
+			 * @param usedAttributes The attributes used by the asset.
+			 */
+			void setupInterleavedLayout(const std::array<bool, EnumToInt(VertexAttribute::Max)>& usedAttributes);
+
+			/**
+			 * Create the staging buffers which can hold the vertex data of all the meshes.
+			 * If the data are interleaved, this also sets up the interleaved layout.
+			 *
+			 * @param usedAttributes The attributes used by the asset.
+			 * @param vertexCount The total number of vertices.
+			 * @param pAttributeMemory The variable to store the mapped staging memory of each attribute.
+			 * @return The staging buffers. If the data are interleaved, only the first buffer is created.
+			 */
+			[[nodiscard]] std::array<std::shared_ptr<Buffer>, EnumToInt(VertexAttribute::Max)> createStagingBuffers(const std::array<bool, EnumToInt(VertexAttribute::Max)>& usedAttributes, uint64_t vertexCount, std::array<std::byte*, EnumToInt(VertexAttribute::Max)>& pAttributeMemory);
+
+			/**
+			 * Allocate the vertex range of the model from the device's geometry pool.
+			 *
+			 * @param usedAttributes The attributes used by the asset.
+			 * @param vertexCount The total number of vertices.
+			 */
+			void allocateVertexRange(const std::array<bool, EnumToInt(VertexAttribute::Max)>& usedAttributes, uint64_t vertexCount);
+
+			/**
+			 * Get the number of bytes between two vertices in an attribute's buffer.
+			 *
+			 * @param attribute The attribute.
+			 * @return The stride. If the data are interleaved, this is the vertex stride.
+			 */
+			[[nodiscard]] uint32_t getBufferStride(VertexAttribute attribute) const;
+
+			/**
+			 * Upload the loaded vertex and index data to the device's geometry pool using a single transfer.
+			 * This also sets the attribute, vertex and index offsets of the meshes, relative to the pool's buffers.
+			 *
+			 * @param vCommandBuffer The command buffer to record the transfer to.
+			 * @param pStagingBuffers The mapped staging buffers containing the vertex data.
+			 * @param meshIndices The indices of each mesh, including their levels of detail.
+			 */
+			void uploadData(VulkanCommandBuffers& vCommandBuffer, const std::array<std::shared_ptr<Buffer>, EnumToInt(VertexAttribute::Max)>& pStagingBuffers, const std::vector<std::vector<uint32_t>>& meshIndices);
+
 		private:
-			VulkanVertexStorage m_VertexStorage;
-			std::shared_ptr<VulkanBuffer> m_pIndexBuffer = nullptr;
+			VulkanGeometryPool::VertexRange m_VertexRange = {};
+			VulkanGeometryPool::IndexRange m_IndexRange = {};
+			std::array<bool, EnumToInt(VertexAttribute::Max)> m_UsedAttributes = {};
+
+			std::vector<VertexInput> m_VertexLayout;
+			std::array<uint32_t, EnumToInt(VertexAttribute::Max)> m_AttributeOffsets = {};
+			uint32_t m_VertexStride = 0;
+
+			const VertexMemoryType m_MemoryType = VertexMemoryType::Exclusive;
+			const VertexFormatProfile m_FormatProfile = VertexFormatProfile::Full;
 		};
 	}
 }
\ No newline at end of file
@@ -14,6 +14,7 @@ namespace Flint
 	{
 		/**
 		 * Vulkan vertex storage class.
+		 * In the interleaved memory type, all the attributes share a single buffer, so every attribute resolves to the same buffer.
 		 */
 		class VulkanVertexStorage final : public VertexStorage
 		{
@@ -22,8 +23,9 @@ namespace Flint
 			 * Explicit constructor.
 			 *
 			 * @param pDevice The device reference.
+			 * @param memoryType The memory type used to store the vertex data. Default is exclusive.
 			 */
-			explicit VulkanVertexStorage(const std::shared_ptr<VulkanDevice>& pDevice);
+			explicit VulkanVertexStorage(const std::shared_ptr<VulkanDevice>& pDevice, VertexMemoryType memoryType = VertexMemoryType::Exclusive);
 
 			/**
 			 * Destructor.
@@ -44,6 +46,27 @@ namespace Flint
 			 */
 			[[nodiscard]] uint64_t insert(VertexAttribute attribute, const Buffer* pStaggingBuffer) override;
 
+			/**
+			 * Reserve space for an attribute in the vertex storage.
+			 * This grows the attribute's buffer by the required size at once, so multiple meshes can later be copied to it without reallocating it every time.
+			 *
+			 * @param attribute The attribute type of the data.
+			 * @param size The number of bytes to reserve.
+			 * @return The offset at which the reserved region starts.
+			 */
+			[[nodiscard]] uint64_t reserve(VertexAttribute attribute, uint64_t size) override;
+
+			/**
+			 * Insert data to a previously reserved region of the vertex storage.
+			 * The copy is only recorded to the command buffer, so the caller has to submit it once all the copies are recorded.
+			 *
+			 * @param pCommandBuffer The command buffer to record the copy to.
+			 * @param attribute The attribute type of the data.
+			 * @param pStaggingBuffer The stagging buffer pointer to copy the data from.
+			 * @param offset The offset of the reserved region to copy the data to.
+			 */
+			void insertBatched(VulkanCommandBuffers* pCommandBuffer, VertexAttribute attribute, const Buffer* pStaggingBuffer, uint64_t offset);
+
 		public:
 			/**
 			 * Get the buffer containing required data.
@@ -51,7 +74,7 @@ namespace Flint
 			 * @param attribute The attribute to access.
 			 * @return The buffer pointer.
 			 */
-			[[nodiscard]] VulkanBuffer* getBuffer(VertexAttribute attribute) { return m_pBuffers[EnumToInt(attribute)].getUnsafe().get(); }
+			[[nodiscard]] VulkanBuffer* getBuffer(VertexAttribute attribute) { return m_pBuffers[getBufferIndex(attribute)].getUnsafe().get(); }
 
 			/**
 			 * Get the buffer containing required data.
@@ -59,7 +82,16 @@ namespace Flint
 			 * @param attribute The attribute to access.
 			 * @return The buffer pointer.
 			 */
-			[[nodiscard]] const VulkanBuffer* getBuffer(VertexAttribute attribute) const { return m_pBuffers[EnumToInt(attribute)].getUnsafe().get(); }
+			[[nodiscard]] const VulkanBuffer* getBuffer(VertexAttribute attribute) const { return m_pBuffers[getBufferIndex(attribute)].getUnsafe().get(); }
+
+		private:
+			/**
+			 * Get the index of the buffer which stores an attribute.
+			 *
+			 * @param attribute The attribute.
+			 * @return The buffer index.
+			 */
+			[[nodiscard]] uint8_t getBufferIndex(VertexAttribute attribute) const { return m_MemoryType == VertexMemoryType::Interleaved ? 0 : EnumToInt(attribute); }
 
 		private:
 			std::array<Synchronized<std::shared_ptr<VulkanBuffer>>, EnumToInt(VertexAttribute::Max)> m_pBuffers;
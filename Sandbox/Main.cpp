@@ -51,6 +51,7 @@ int main()
 
 	auto instance = Flint::CreateInstance("Sandbox", 1, Validation);
 	auto device = instance->createDevice();
+	device->setShaderCacheHandler(std::make_unique<Flint::Backend::Defaults::PipelineCacheStore>("PipelineCache/Shaders.fpcs"));
 
 	auto window = device->createWindow("Sandbox", 1280, 720);
 	auto camera = Flint::MonoCamera(glm::vec3(0.0f), window->getWidth(), window->getHeight());
@@ -81,7 +82,7 @@ int main()
 
 	auto cameraBuffer = camera.createBuffer(device);
 	auto program = device->createRasterizingProgram(Flint::Backend::ShaderCode("Shaders/Debugging/Shader.vert.spv"), Flint::Backend::ShaderCode("Shaders/Debugging/Shader.frag.spv"));
-	auto defaultPipeline = rasterizer->createPipeline(program, GetDefaultSpecification(), std::make_unique<Flint::Backend::Defaults::FilePipelineCacheHandler>("PipelineCache/"));
+	auto defaultPipeline = rasterizer->createPipeline(program, GetDefaultSpecification(), std::make_unique<Flint::Backend::Defaults::PipelineCacheStore>("PipelineCache/Pipelines.fpcs"));
 	auto drawEntry = defaultPipeline->attach(model, [cameraBuffer, device](auto& model, const Flint::Backend::StaticMesh& mesh, const Flint::Backend::BindingMap& binder)
 		{
 			Flint::Backend::MeshBindingTable table;
@@ -0,0 +1,152 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Flint/Backend/BufferRegion.hpp"
+#include "Flint/Core/Errors/InvalidArgumentError.hpp"
+
+#include <Optick.h>
+
+namespace /* anonymous */
+{
+	/**
+	 * Align a value to the next multiple of the alignment.
+	 *
+	 * @param value The value to align.
+	 * @param alignment The alignment.
+	 * @return The aligned value.
+	 */
+	constexpr uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return ((value + alignment - 1) / alignment) * alignment;
+	}
+}
+
+namespace Flint
+{
+	namespace Backend
+	{
+		BufferAllocator::BufferAllocator(const std::shared_ptr<Device>& pDevice, BufferUsage usage, uint64_t blockSize /*= 1024 * 1024*/)
+			: DeviceBoundObject(pDevice)
+			, m_BlockSize(blockSize)
+			, m_Alignment(std::max<uint64_t>(pDevice->getBufferAlignment(usage), 1))
+			, m_Usage(usage)
+		{
+			if (blockSize == 0)
+				throw InvalidArgumentError("The block size should be grater than 0!");
+
+			// Make sure to set the object as valid.
+			validate();
+		}
+
+		BufferAllocator::~BufferAllocator()
+		{
+			FLINT_TERMINATE_IF_VALID;
+		}
+
+		void BufferAllocator::terminate()
+		{
+			m_Blocks.clear();
+			invalidate();
+		}
+
+		BufferRegion BufferAllocator::allocate(uint64_t size)
+		{
+			OPTICK_EVENT();
+
+			if (size == 0)
+				throw InvalidArgumentError("The region size should be grater than 0!");
+
+			const auto alignedSize = AlignUp(size, m_Alignment);
+			[[maybe_unused]] const auto lock = std::scoped_lock(m_Mutex);
+
+			// Try and find a free range in one of the existing blocks (first fit).
+			for (auto& block : m_Blocks)
+			{
+				for (auto itr = block.m_FreeRanges.begin(); itr != block.m_FreeRanges.end(); ++itr)
+				{
+					const auto [rangeOffset, rangeSize] = *itr;
+					const auto alignedOffset = AlignUp(rangeOffset, m_Alignment);
+
+					if (alignedOffset + alignedSize > rangeOffset + rangeSize)
+						continue;
+
+					// Split the free range into the leading and trailing parts.
+					block.m_FreeRanges.erase(itr);
+
+					if (alignedOffset > rangeOffset)
+						block.m_FreeRanges[rangeOffset] = alignedOffset - rangeOffset;
+
+					if (rangeOffset + rangeSize > alignedOffset + alignedSize)
+						block.m_FreeRanges[alignedOffset + alignedSize] = (rangeOffset + rangeSize) - (alignedOffset + alignedSize);
+
+					return BufferRegion{ block.m_pBuffer, alignedOffset, size };
+				}
+			}
+
+			// If we couldn't find one, create a new block. Large requests get a block of their own.
+			auto& block = createBlock(std::max(m_BlockSize, alignedSize));
+			block.m_FreeRanges.clear();
+
+			if (block.m_pBuffer->getSize() > alignedSize)
+				block.m_FreeRanges[alignedSize] = block.m_pBuffer->getSize() - alignedSize;
+
+			return BufferRegion{ block.m_pBuffer, 0, size };
+		}
+
+		void BufferAllocator::free(const BufferRegion& region)
+		{
+			OPTICK_EVENT();
+
+			if (!region.isValid())
+				return;
+
+			[[maybe_unused]] const auto lock = std::scoped_lock(m_Mutex);
+
+			for (auto& block : m_Blocks)
+			{
+				if (block.m_pBuffer != region.m_pBuffer)
+					continue;
+
+				auto offset = region.m_Offset;
+				auto size = AlignUp(region.m_Size, m_Alignment);
+
+				// Merge with the next free range if they are adjacent.
+				const auto next = block.m_FreeRanges.find(offset + size);
+				if (next != block.m_FreeRanges.end())
+				{
+					size += next->second;
+					block.m_FreeRanges.erase(next);
+				}
+
+				// Merge with the previous free range if they are adjacent.
+				auto previous = block.m_FreeRanges.lower_bound(offset);
+				if (previous != block.m_FreeRanges.begin())
+				{
+					--previous;
+					if (previous->first + previous->second == offset)
+					{
+						offset = previous->first;
+						size += previous->second;
+						block.m_FreeRanges.erase(previous);
+					}
+				}
+
+				block.m_FreeRanges[offset] = size;
+				return;
+			}
+
+			throw InvalidArgumentError("The region was not allocated by this allocator!");
+		}
+
+		BufferAllocator::Block& BufferAllocator::createBlock(uint64_t size)
+		{
+			OPTICK_EVENT();
+
+			auto& block = m_Blocks.emplace_back();
+			block.m_pBuffer = getDevice().createBuffer(size, m_Usage);
+			block.m_FreeRanges[0] = size;
+
+			return block;
+		}
+	}
+}
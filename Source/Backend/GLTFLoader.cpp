@@ -0,0 +1,1132 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Flint/Backend/GLTFLoader.hpp"
+#include "Flint/Core/Errors/AssetError.hpp"
+
+#include <Optick.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLINT_GLTF_LOADER_SSE2
+#include <emmintrin.h>
+
+#endif
+
+namespace /* anonymous */
+{
+	/**
+	 * The glTF component types.
+	 */
+	constexpr uint32_t ComponentTypeByte = 5120;
+	constexpr uint32_t ComponentTypeUnsignedByte = 5121;
+	constexpr uint32_t ComponentTypeShort = 5122;
+	constexpr uint32_t ComponentTypeUnsignedShort = 5123;
+	constexpr uint32_t ComponentTypeUnsignedInt = 5125;
+	constexpr uint32_t ComponentTypeFloat = 5126;
+
+	/**
+	 * The triangle list primitive mode.
+	 */
+	constexpr uint64_t PrimitiveModeTriangles = 4;
+
+	/**
+	 * The GLB header and chunk identifiers.
+	 */
+	constexpr uint32_t BinaryMagic = 0x46546C67;
+	constexpr uint32_t BinaryVersion = 2;
+	constexpr uint32_t ChunkTypeJSON = 0x4E4F534A;
+	constexpr uint32_t ChunkTypeBIN = 0x004E4942;
+
+	/**
+	 * The maximum nesting depth of the JSON values.
+	 */
+	constexpr uint32_t MaxJSONDepth = 256;
+
+	/**
+	 * JSON value structure.
+	 * The object members are stored as elements, with their keys in a separate vector.
+	 */
+	struct JSONValue final
+	{
+		/**
+		 * JSON value type enum.
+		 */
+		enum class Type : uint8_t
+		{
+			Null,
+			Boolean,
+			Number,
+			String,
+			Array,
+			Object
+		};
+
+		/**
+		 * Find a member of an object.
+		 *
+		 * @param key The member key.
+		 * @return The member pointer. This is nullptr if the value is not an object or the member is not present.
+		 */
+		[[nodiscard]] const JSONValue* find(std::string_view key) const
+		{
+			if (m_Type != Type::Object)
+				return nullptr;
+
+			for (uint64_t i = 0; i < m_Keys.size(); i++)
+			{
+				if (m_Keys[i] == key)
+					return &m_Elements[i];
+			}
+
+			return nullptr;
+		}
+
+		/**
+		 * Get the elements of an array member.
+		 *
+		 * @param key The member key.
+		 * @return The elements. This is empty if the member is not present or is not an array.
+		 */
+		[[nodiscard]] const std::vector<JSONValue>& getArray(std::string_view key) const
+		{
+			static const std::vector<JSONValue> empty;
+
+			const auto pMember = find(key);
+			return pMember && pMember->m_Type == Type::Array ? pMember->m_Elements : empty;
+		}
+
+		/**
+		 * Get an unsigned integer member.
+		 *
+		 * @param key The member key.
+		 * @param defaultValue The value to return if the member is not present.
+		 * @return The member value.
+		 */
+		[[nodiscard]] uint64_t getUnsigned(std::string_view key, uint64_t defaultValue) const
+		{
+			const auto pMember = find(key);
+			if (!pMember)
+				return defaultValue;
+
+			if (pMember->m_Type != Type::Number || pMember->m_Number < 0.0 || pMember->m_Number != static_cast<double>(static_cast<uint64_t>(pMember->m_Number)))
+				throw Flint::AssetError("The glTF asset contains an invalid integer!");
+
+			return static_cast<uint64_t>(pMember->m_Number);
+		}
+
+		/**
+		 * Get a string member.
+		 *
+		 * @param key The member key.
+		 * @return The member value. This is empty if the member is not present or is not a string.
+		 */
+		[[nodiscard]] std::string_view getString(std::string_view key) const
+		{
+			const auto pMember = find(key);
+			return pMember && pMember->m_Type == Type::String ? std::string_view(pMember->m_String) : std::string_view();
+		}
+
+		std::vector<JSONValue> m_Elements;
+		std::vector<std::string> m_Keys;
+		std::string m_String;
+
+		double m_Number = 0.0;
+
+		Type m_Type = Type::Null;
+		bool m_Boolean = false;
+	};
+
+	/**
+	 * JSON parser class.
+	 * This is a strict recursive descent parser, which only supports what glTF needs: UTF-8 text and numbers which fit in a double.
+	 */
+	class JSONParser final
+	{
+	public:
+		/**
+		 * Explicit constructor.
+		 *
+		 * @param text The JSON text.
+		 */
+		explicit JSONParser(std::string_view text) : m_pCurrent(text.data()), m_pEnd(text.data() + text.size()) {}
+
+		/**
+		 * Parse the text.
+		 * This will throw an asset error if the text is not valid JSON.
+		 *
+		 * @return The root value.
+		 */
+		[[nodiscard]] JSONValue parse()
+		{
+			OPTICK_EVENT();
+
+			auto value = parseValue(0);
+
+			skipWhitespace();
+			if (m_pCurrent != m_pEnd)
+				throw Flint::AssetError("The glTF asset contains trailing characters after the JSON!");
+
+			return value;
+		}
+
+	private:
+		/**
+		 * Skip the whitespace characters.
+		 */
+		void skipWhitespace()
+		{
+			while (m_pCurrent != m_pEnd && (*m_pCurrent == ' ' || *m_pCurrent == '\t' || *m_pCurrent == '\n' || *m_pCurrent == '\r'))
+				m_pCurrent++;
+		}
+
+		/**
+		 * Consume a character.
+		 *
+		 * @param character The expected character.
+		 */
+		void expect(char character)
+		{
+			skipWhitespace();
+			if (m_pCurrent == m_pEnd || *m_pCurrent != character)
+				throw Flint::AssetError("The glTF asset contains invalid JSON!");
+
+			m_pCurrent++;
+		}
+
+		/**
+		 * Consume a literal.
+		 *
+		 * @param literal The expected literal.
+		 */
+		void expectLiteral(std::string_view literal)
+		{
+			if (static_cast<uint64_t>(m_pEnd - m_pCurrent) < literal.size() || std::string_view(m_pCurrent, literal.size()) != literal)
+				throw Flint::AssetError("The glTF asset contains invalid JSON!");
+
+			m_pCurrent += literal.size();
+		}
+
+		/**
+		 * Parse a single value.
+		 *
+		 * @param depth The current nesting depth.
+		 * @return The value.
+		 */
+		[[nodiscard]] JSONValue parseValue(uint32_t depth)
+		{
+			if (depth > MaxJSONDepth)
+				throw Flint::AssetError("The glTF asset's JSON is nested too deeply!");
+
+			skipWhitespace();
+			if (m_pCurrent == m_pEnd)
+				throw Flint::AssetError("The glTF asset's JSON ended unexpectedly!");
+
+			JSONValue value;
+			switch (*m_pCurrent)
+			{
+			case '{':
+				value.m_Type = JSONValue::Type::Object;
+				m_pCurrent++;
+
+				skipWhitespace();
+				if (m_pCurrent != m_pEnd && *m_pCurrent == '}')
+				{
+					m_pCurrent++;
+					break;
+				}
+
+				do
+				{
+					skipWhitespace();
+					value.m_Keys.emplace_back(parseString());
+					expect(':');
+					value.m_Elements.emplace_back(parseValue(depth + 1));
+					skipWhitespace();
+				} while (m_pCurrent != m_pEnd && *m_pCurrent == ',' && m_pCurrent++);
+
+				expect('}');
+				break;
+
+			case '[':
+				value.m_Type = JSONValue::Type::Array;
+				m_pCurrent++;
+
+				skipWhitespace();
+				if (m_pCurrent != m_pEnd && *m_pCurrent == ']')
+				{
+					m_pCurrent++;
+					break;
+				}
+
+				do
+				{
+					value.m_Elements.emplace_back(parseValue(depth + 1));
+					skipWhitespace();
+				} while (m_pCurrent != m_pEnd && *m_pCurrent == ',' && m_pCurrent++);
+
+				expect(']');
+				break;
+
+			case '"':
+				value.m_Type = JSONValue::Type::String;
+				value.m_String = parseString();
+				break;
+
+			case 't':
+				value.m_Type = JSONValue::Type::Boolean;
+				value.m_Boolean = true;
+				expectLiteral("true");
+				break;
+
+			case 'f':
+				value.m_Type = JSONValue::Type::Boolean;
+				expectLiteral("false");
+				break;
+
+			case 'n':
+				expectLiteral("null");
+				break;
+
+			default:
+			{
+				value.m_Type = JSONValue::Type::Number;
+
+				// from_chars does not accept the leading plus sign, which is not valid JSON anyway.
+				const auto [pEnd, error] = std::from_chars(m_pCurrent, m_pEnd, value.m_Number);
+				if (error != std::errc() || pEnd == m_pCurrent)
+					throw Flint::AssetError("The glTF asset contains an invalid JSON number!");
+
+				m_pCurrent = pEnd;
+				break;
+			}
+			}
+
+			return value;
+		}
+
+		/**
+		 * Parse a string and decode it's escape sequences.
+		 *
+		 * @return The string.
+		 */
+		[[nodiscard]] std::string parseString()
+		{
+			if (m_pCurrent == m_pEnd || *m_pCurrent != '"')
+				throw Flint::AssetError("The glTF asset contains invalid JSON!");
+
+			m_pCurrent++;
+
+			std::string string;
+			while (true)
+			{
+				// Copy everything up to the next quote or escape at once.
+				const auto pSpecial = std::find_if(m_pCurrent, m_pEnd, [](char character) { return character == '"' || character == '\\'; });
+				string.append(m_pCurrent, pSpecial);
+				m_pCurrent = pSpecial;
+
+				if (m_pCurrent == m_pEnd)
+					throw Flint::AssetError("The glTF asset contains an unterminated JSON string!");
+
+				if (*m_pCurrent++ == '"')
+					return string;
+
+				if (m_pCurrent == m_pEnd)
+					throw Flint::AssetError("The glTF asset contains an unterminated JSON string!");
+
+				switch (*m_pCurrent++)
+				{
+				case '"':	string.push_back('"'); break;
+				case '\\':	string.push_back('\\'); break;
+				case '/':	string.push_back('/'); break;
+				case 'b':	string.push_back('\b'); break;
+				case 'f':	string.push_back('\f'); break;
+				case 'n':	string.push_back('\n'); break;
+				case 'r':	string.push_back('\r'); break;
+				case 't':	string.push_back('\t'); break;
+				case 'u':	appendCodePoint(string, parseCodePoint()); break;
+				default:	throw Flint::AssetError("The glTF asset contains an invalid JSON escape sequence!");
+				}
+			}
+		}
+
+		/**
+		 * Parse the code point of a unicode escape sequence, including the low surrogate if the first one is a high surrogate.
+		 *
+		 * @return The code point.
+		 */
+		[[nodiscard]] uint32_t parseCodePoint()
+		{
+			const auto parseHex = [this]
+			{
+				uint32_t value = 0;
+				if (m_pEnd - m_pCurrent < 4 || std::from_chars(m_pCurrent, m_pCurrent + 4, value, 16).ptr != m_pCurrent + 4)
+					throw Flint::AssetError("The glTF asset contains an invalid JSON unicode escape sequence!");
+
+				m_pCurrent += 4;
+				return value;
+			};
+
+			const auto codePoint = parseHex();
+			if (codePoint < 0xD800 || codePoint > 0xDBFF)
+				return codePoint;
+
+			expectLiteral("\\u");
+			const auto lowSurrogate = parseHex();
+			if (lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF)
+				throw Flint::AssetError("The glTF asset contains an invalid JSON surrogate pair!");
+
+			return 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+		}
+
+		/**
+		 * Append a code point to a string as UTF-8.
+		 *
+		 * @param string The string to append to.
+		 * @param codePoint The code point.
+		 */
+		static void appendCodePoint(std::string& string, uint32_t codePoint)
+		{
+			if (codePoint < 0x80)
+			{
+				string.push_back(static_cast<char>(codePoint));
+			}
+			else if (codePoint < 0x800)
+			{
+				string.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+				string.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+			}
+			else if (codePoint < 0x10000)
+			{
+				string.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+				string.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+				string.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+			}
+			else
+			{
+				string.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+				string.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+				string.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+				string.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+			}
+		}
+
+	private:
+		const char* m_pCurrent = nullptr;
+		const char* m_pEnd = nullptr;
+	};
+
+	/**
+	 * Read a little endian 32-bit value.
+	 *
+	 * @param pData The data pointer.
+	 * @return The value.
+	 */
+	uint32_t ReadUint32(const std::byte* pData)
+	{
+		return static_cast<uint32_t>(pData[0]) | static_cast<uint32_t>(pData[1]) << 8 | static_cast<uint32_t>(pData[2]) << 16 | static_cast<uint32_t>(pData[3]) << 24;
+	}
+
+	/**
+	 * Decode the percent encoded characters of a URI.
+	 *
+	 * @param uri The URI.
+	 * @return The decoded URI.
+	 */
+	std::string DecodeURI(std::string_view uri)
+	{
+		std::string decoded;
+		decoded.reserve(uri.size());
+
+		for (uint64_t i = 0; i < uri.size(); i++)
+		{
+			uint32_t character = 0;
+			if (uri[i] == '%' && i + 2 < uri.size() && std::from_chars(uri.data() + i + 1, uri.data() + i + 3, character, 16).ptr == uri.data() + i + 3)
+			{
+				decoded.push_back(static_cast<char>(character));
+				i += 2;
+			}
+			else
+			{
+				decoded.push_back(uri[i]);
+			}
+		}
+
+		return decoded;
+	}
+
+	/**
+	 * Decode the base 64 payload of a data URI.
+	 *
+	 * @param uri The data URI.
+	 * @return The decoded bytes.
+	 */
+	std::vector<std::byte> DecodeDataURI(std::string_view uri)
+	{
+		const auto separator = uri.find(";base64,");
+		if (separator == std::string_view::npos)
+			throw Flint::AssetError("The glTF asset contains a data URI which is not base 64 encoded!");
+
+		const auto payload = uri.substr(separator + 8);
+
+		std::vector<std::byte> bytes;
+		bytes.reserve(payload.size() / 4 * 3);
+
+		uint32_t accumulator = 0;
+		uint32_t bits = 0;
+		for (const auto character : payload)
+		{
+			uint32_t value = 0;
+			if (character >= 'A' && character <= 'Z')		value = character - 'A';
+			else if (character >= 'a' && character <= 'z')	value = character - 'a' + 26;
+			else if (character >= '0' && character <= '9')	value = character - '0' + 52;
+			else if (character == '+')						value = 62;
+			else if (character == '/')						value = 63;
+			else if (character == '=')						break;
+			else											throw Flint::AssetError("The glTF asset contains an invalid base 64 character!");
+
+			accumulator = (accumulator << 6) | value;
+			bits += 6;
+
+			if (bits >= 8)
+			{
+				bits -= 8;
+				bytes.emplace_back(static_cast<std::byte>((accumulator >> bits) & 0xFF));
+			}
+		}
+
+		return bytes;
+	}
+
+	/**
+	 * Get the size of a component type.
+	 *
+	 * @param componentType The glTF component type.
+	 * @return The size in bytes.
+	 */
+	uint32_t GetComponentSize(uint64_t componentType)
+	{
+		switch (componentType)
+		{
+		case ComponentTypeByte:
+		case ComponentTypeUnsignedByte:
+			return 1;
+
+		case ComponentTypeShort:
+		case ComponentTypeUnsignedShort:
+			return 2;
+
+		case ComponentTypeUnsignedInt:
+		case ComponentTypeFloat:
+			return 4;
+
+		default:
+			throw Flint::AssetError("The glTF asset contains an invalid component type!");
+		}
+	}
+
+	/**
+	 * Get the number of components of an accessor type.
+	 *
+	 * @param type The glTF accessor type.
+	 * @return The component count. This is 0 for the matrix types, which can not be used as vertex attributes.
+	 */
+	uint8_t GetComponentCount(std::string_view type)
+	{
+		if (type == "SCALAR")
+			return 1;
+
+		if (type == "VEC2")
+			return 2;
+
+		if (type == "VEC3")
+			return 3;
+
+		if (type == "VEC4")
+			return 4;
+
+		return 0;
+	}
+
+	/**
+	 * Get the vertex attribute of a glTF attribute semantic.
+	 *
+	 * @param semantic The attribute semantic.
+	 * @return The vertex attribute. This is Max if the semantic is not supported.
+	 */
+	Flint::VertexAttribute GetVertexAttribute(std::string_view semantic)
+	{
+		if (semantic == "POSITION")
+			return Flint::VertexAttribute::Position;
+
+		if (semantic == "NORMAL")
+			return Flint::VertexAttribute::Normal;
+
+		if (semantic == "TANGENT")
+			return Flint::VertexAttribute::Tangent;
+
+		const auto getSet = [semantic](std::string_view prefix, Flint::VertexAttribute first)
+		{
+			uint32_t set = 0;
+			if (semantic.starts_with(prefix) && std::from_chars(semantic.data() + prefix.size(), semantic.data() + semantic.size(), set).ptr == semantic.data() + semantic.size() && set < 8)
+				return static_cast<Flint::VertexAttribute>(Flint::EnumToInt(first) + set);
+
+			return Flint::VertexAttribute::Max;
+		};
+
+		if (semantic.starts_with("TEXCOORD_"))
+			return getSet("TEXCOORD_", Flint::VertexAttribute::Texture0);
+
+		if (semantic.starts_with("COLOR_"))
+			return getSet("COLOR_", Flint::VertexAttribute::Color0);
+
+		return Flint::VertexAttribute::Max;
+	}
+
+	/**
+	 * Check if a required extension is supported.
+	 * Only the extensions which change how the geometry is stored matter, the rest only affect the materials.
+	 *
+	 * @param extension The extension name.
+	 * @return Whether the extension is supported.
+	 */
+	bool IsExtensionSupported(std::string_view extension)
+	{
+		return extension == "KHR_mesh_quantization" || extension == "KHR_texture_transform" || extension.starts_with("KHR_materials_");
+	}
+
+	/**
+	 * Read a single component and convert it to a float.
+	 *
+	 * @param pComponent The component pointer.
+	 * @param componentType The glTF component type.
+	 * @param isNormalized Whether the integer components are normalized.
+	 * @return The converted value.
+	 */
+	float ReadComponent(const std::byte* pComponent, uint32_t componentType, bool isNormalized)
+	{
+		switch (componentType)
+		{
+		case ComponentTypeByte:
+		{
+			const auto value = static_cast<int8_t>(pComponent[0]);
+			return isNormalized ? std::max(value / 127.0f, -1.0f) : value;
+		}
+
+		case ComponentTypeUnsignedByte:
+		{
+			const auto value = static_cast<uint8_t>(pComponent[0]);
+			return isNormalized ? value / 255.0f : value;
+		}
+
+		case ComponentTypeShort:
+		{
+			int16_t value = 0;
+			std::memcpy(&value, pComponent, sizeof(int16_t));
+			return isNormalized ? std::max(value / 32767.0f, -1.0f) : value;
+		}
+
+		case ComponentTypeUnsignedShort:
+		{
+			uint16_t value = 0;
+			std::memcpy(&value, pComponent, sizeof(uint16_t));
+			return isNormalized ? value / 65535.0f : value;
+		}
+
+		case ComponentTypeUnsignedInt:
+		{
+			uint32_t value = 0;
+			std::memcpy(&value, pComponent, sizeof(uint32_t));
+			return static_cast<float>(value);
+		}
+
+		default:
+		{
+			float value = 0.0f;
+			std::memcpy(&value, pComponent, sizeof(float));
+			return value;
+		}
+		}
+	}
+
+	/**
+	 * Read a single unsigned integer index.
+	 *
+	 * @param pIndex The index pointer.
+	 * @param componentType The glTF component type.
+	 * @return The index.
+	 */
+	uint32_t ReadIndex(const std::byte* pIndex, uint32_t componentType)
+	{
+		switch (componentType)
+		{
+		case ComponentTypeUnsignedByte:
+			return static_cast<uint8_t>(pIndex[0]);
+
+		case ComponentTypeUnsignedShort:
+		{
+			uint16_t value = 0;
+			std::memcpy(&value, pIndex, sizeof(uint16_t));
+			return value;
+		}
+
+		default:
+			return ReadUint32(pIndex);
+		}
+	}
+
+	/**
+	 * Resolve a texture info object to the texture's image path.
+	 *
+	 * @param root The root JSON object.
+	 * @param pTextureInfo The texture info object pointer. This can be nullptr.
+	 * @param basePath The base path to resolve the URIs from.
+	 * @return The image path. This is empty if the texture is not present or the image is embedded.
+	 */
+	std::filesystem::path GetTexturePath(const JSONValue& root, const JSONValue* pTextureInfo, const std::filesystem::path& basePath)
+	{
+		if (!pTextureInfo || !pTextureInfo->find("index"))
+			return {};
+
+		const auto& textures = root.getArray("textures");
+		const auto textureIndex = pTextureInfo->getUnsigned("index", 0);
+		if (textureIndex >= textures.size())
+			throw Flint::AssetError("The glTF asset contains an invalid texture index!");
+
+		const auto& images = root.getArray("images");
+		const auto imageIndex = textures[textureIndex].getUnsigned("source", Flint::Backend::GLTF::InvalidIndex);
+		if (imageIndex == Flint::Backend::GLTF::InvalidIndex)
+			return {};
+
+		if (imageIndex >= images.size())
+			throw Flint::AssetError("The glTF asset contains an invalid image index!");
+
+		const auto uri = images[imageIndex].getString("uri");
+		if (uri.empty() || uri.starts_with("data:"))
+			return {};
+
+		return basePath / DecodeURI(uri);
+	}
+}
+
+namespace Flint
+{
+	namespace Backend
+	{
+		namespace GLTF
+		{
+			Document::Document(const std::filesystem::path& file)
+			{
+				OPTICK_EVENT();
+
+				const auto basePath = file.parent_path();
+				auto& assetFile = m_Files.emplace_back(file);
+
+				// Find the JSON text and the binary chunk if the file is a GLB container.
+				auto json = std::string_view(reinterpret_cast<const char*>(assetFile.getData()), assetFile.getSize());
+				const std::byte* pBinaryChunk = nullptr;
+				uint64_t binaryChunkSize = 0;
+
+				if (assetFile.getSize() >= 12 && ReadUint32(assetFile.getData()) == BinaryMagic)
+				{
+					if (ReadUint32(assetFile.getData() + 4) != BinaryVersion)
+						throw AssetError("The GLB file uses an unsupported version!");
+
+					const auto length = std::min<uint64_t>(ReadUint32(assetFile.getData() + 8), assetFile.getSize());
+
+					uint64_t offset = 12;
+					while (offset + 8 <= length)
+					{
+						const uint64_t chunkSize = ReadUint32(assetFile.getData() + offset);
+						const auto chunkType = ReadUint32(assetFile.getData() + offset + 4);
+						offset += 8;
+
+						if (chunkSize > length - offset)
+							throw AssetError("The GLB file contains an invalid chunk!");
+
+						if (chunkType == ChunkTypeJSON && offset == 20)
+						{
+							json = std::string_view(reinterpret_cast<const char*>(assetFile.getData() + offset), chunkSize);
+						}
+						else if (chunkType == ChunkTypeBIN && !pBinaryChunk)
+						{
+							pBinaryChunk = assetFile.getData() + offset;
+							binaryChunkSize = chunkSize;
+						}
+
+						offset += (chunkSize + 3) & ~static_cast<uint64_t>(3);
+					}
+
+					if (json.data() == reinterpret_cast<const char*>(assetFile.getData()))
+						throw AssetError("The GLB file does not contain a JSON chunk!");
+				}
+
+				const auto root = JSONParser(json).parse();
+				const auto pAsset = root.find("asset");
+				if (!pAsset || !pAsset->getString("version").starts_with("2."))
+					throw AssetError("The asset is not a glTF 2.0 asset!");
+
+				for (const auto& extension : root.getArray("extensionsRequired"))
+				{
+					if (extension.m_Type == JSONValue::Type::String && !IsExtensionSupported(extension.m_String))
+					{
+						m_UnsupportedFeature = "The required extension " + extension.m_String + " is not supported.";
+						return;
+					}
+				}
+
+				// Resolve the buffers. Files are mapped, data URIs are decoded, and the buffer without a URI is the GLB binary chunk.
+				const auto& bufferObjects = root.getArray("buffers");
+				std::vector<std::pair<const std::byte*, uint64_t>> buffers;
+				buffers.reserve(bufferObjects.size());
+
+				for (const auto& buffer : bufferObjects)
+				{
+					const auto byteLength = buffer.getUnsigned("byteLength", 0);
+					const auto uri = buffer.getString("uri");
+
+					const std::byte* pData = nullptr;
+					uint64_t size = 0;
+					if (uri.empty())
+					{
+						pData = pBinaryChunk;
+						size = binaryChunkSize;
+					}
+					else if (uri.starts_with("data:"))
+					{
+						const auto& bytes = m_EmbeddedBuffers.emplace_back(DecodeDataURI(uri));
+						pData = bytes.data();
+						size = bytes.size();
+					}
+					else
+					{
+						const auto& bufferFile = m_Files.emplace_back(basePath / DecodeURI(uri));
+						pData = bufferFile.getData();
+						size = bufferFile.getSize();
+					}
+
+					if (byteLength > size)
+						throw AssetError("The glTF asset contains a buffer which is smaller than it's byte length!");
+
+					buffers.emplace_back(pData, byteLength);
+				}
+
+				// Resolve the accessors lazily, only the ones used by the primitives are needed.
+				const auto& bufferViews = root.getArray("bufferViews");
+				const auto& accessors = root.getArray("accessors");
+				const auto getAccessor = [this, &buffers, &bufferViews, &accessors](uint64_t index)
+				{
+					if (index >= accessors.size())
+						throw AssetError("The glTF asset contains an invalid accessor index!");
+
+					const auto& accessorObject = accessors[index];
+					if (accessorObject.find("sparse"))
+					{
+						m_UnsupportedFeature = "Sparse accessors are not supported.";
+						return Accessor();
+					}
+
+					const auto viewIndex = accessorObject.getUnsigned("bufferView", InvalidIndex);
+					if (viewIndex == InvalidIndex)
+					{
+						m_UnsupportedFeature = "Accessors without a buffer view are not supported.";
+						return Accessor();
+					}
+
+					if (viewIndex >= bufferViews.size())
+						throw AssetError("The glTF asset contains an invalid buffer view index!");
+
+					const auto& view = bufferViews[viewIndex];
+					const auto bufferIndex = view.getUnsigned("buffer", InvalidIndex);
+					if (bufferIndex >= buffers.size())
+						throw AssetError("The glTF asset contains an invalid buffer index!");
+
+					Accessor accessor;
+					accessor.m_Count = accessorObject.getUnsigned("count", 0);
+					accessor.m_ComponentType = static_cast<uint32_t>(accessorObject.getUnsigned("componentType", 0));
+					accessor.m_ComponentCount = GetComponentCount(accessorObject.getString("type"));
+					accessor.m_IsNormalized = accessorObject.find("normalized") && accessorObject.find("normalized")->m_Boolean;
+
+					if (accessor.m_ComponentCount == 0)
+					{
+						m_UnsupportedFeature = "Matrix accessors are not supported.";
+						return Accessor();
+					}
+
+					const auto elementSize = GetComponentSize(accessor.m_ComponentType) * accessor.m_ComponentCount;
+					accessor.m_Stride = static_cast<uint32_t>(view.getUnsigned("byteStride", elementSize));
+
+					// Make sure that all the elements are inside the buffer view, and the view is inside the buffer.
+					const auto [pBuffer, bufferSize] = buffers[bufferIndex];
+					const auto viewOffset = view.getUnsigned("byteOffset", 0);
+					const auto viewLength = view.getUnsigned("byteLength", 0);
+					const auto accessorOffset = accessorObject.getUnsigned("byteOffset", 0);
+
+					if (viewOffset > bufferSize || viewLength > bufferSize - viewOffset || accessor.m_Stride < elementSize)
+						throw AssetError("The glTF asset contains an invalid buffer view!");
+
+					if (accessorOffset > viewLength)
+						throw AssetError("The glTF asset contains an accessor which is out of it's buffer view's bounds!");
+
+					const auto availableSize = viewLength - accessorOffset;
+					if (accessor.m_Count > 0 && (elementSize > availableSize || accessor.m_Count - 1 > (availableSize - elementSize) / accessor.m_Stride))
+						throw AssetError("The glTF asset contains an accessor which is out of it's buffer view's bounds!");
+
+					accessor.m_pData = pBuffer + viewOffset + accessorOffset;
+					return accessor;
+				};
+
+				// Load the materials.
+				for (const auto& materialObject : root.getArray("materials"))
+				{
+					auto& material = m_Materials.emplace_back();
+
+					if (const auto pPBR = materialObject.find("pbrMetallicRoughness"))
+					{
+						material.m_BaseColorTexture = GetTexturePath(root, pPBR->find("baseColorTexture"), basePath);
+						material.m_MetallicRoughnessTexture = GetTexturePath(root, pPBR->find("metallicRoughnessTexture"), basePath);
+					}
+
+					if (const auto pExtensions = materialObject.find("extensions"))
+					{
+						if (const auto pSheen = pExtensions->find("KHR_materials_sheen"))
+						{
+							material.m_SheenColorTexture = GetTexturePath(root, pSheen->find("sheenColorTexture"), basePath);
+							material.m_SheenRoughnessTexture = GetTexturePath(root, pSheen->find("sheenRoughnessTexture"), basePath);
+						}
+
+						if (const auto pClearCoat = pExtensions->find("KHR_materials_clearcoat"))
+						{
+							material.m_ClearCoatTexture = GetTexturePath(root, pClearCoat->find("clearcoatTexture"), basePath);
+							material.m_ClearCoatRoughnessTexture = GetTexturePath(root, pClearCoat->find("clearcoatRoughnessTexture"), basePath);
+							material.m_ClearCoatNormalTexture = GetTexturePath(root, pClearCoat->find("clearcoatNormalTexture"), basePath);
+						}
+
+						if (const auto pTransmission = pExtensions->find("KHR_materials_transmission"))
+							material.m_TransmissionTexture = GetTexturePath(root, pTransmission->find("transmissionTexture"), basePath);
+
+						if (const auto pVolume = pExtensions->find("KHR_materials_volume"))
+							material.m_ThicknessTexture = GetTexturePath(root, pVolume->find("thicknessTexture"), basePath);
+					}
+				}
+
+				// Load the primitives of all the meshes. The node hierarchy is not used, the same as the other importers.
+				for (const auto& meshObject : root.getArray("meshes"))
+				{
+					const auto& primitives = meshObject.getArray("primitives");
+					const auto meshName = std::string(meshObject.getString("name"));
+
+					for (uint64_t p = 0; p < primitives.size(); p++)
+					{
+						const auto& primitiveObject = primitives[p];
+						if (primitiveObject.getUnsigned("mode", PrimitiveModeTriangles) != PrimitiveModeTriangles)
+						{
+							m_UnsupportedFeature = "Primitives which are not triangle lists are not supported.";
+							return;
+						}
+
+						auto& primitive = m_Primitives.emplace_back();
+						primitive.m_Name = primitives.size() > 1 ? meshName + "-" + std::to_string(p) : meshName;
+						primitive.m_Material = static_cast<uint32_t>(primitiveObject.getUnsigned("material", InvalidIndex));
+
+						if (primitive.m_Material != InvalidIndex && primitive.m_Material >= m_Materials.size())
+							throw AssetError("The glTF asset contains an invalid material index!");
+
+						if (const auto pAttributes = primitiveObject.find("attributes"))
+						{
+							for (uint64_t a = 0; a < pAttributes->m_Keys.size(); a++)
+							{
+								const auto attribute = GetVertexAttribute(pAttributes->m_Keys[a]);
+								if (attribute != VertexAttribute::Max)
+									primitive.m_Attributes[EnumToInt(attribute)] = getAccessor(pAttributes->getUnsigned(pAttributes->m_Keys[a], 0));
+							}
+						}
+
+						if (primitiveObject.find("indices"))
+							primitive.m_Indices = getAccessor(primitiveObject.getUnsigned("indices", 0));
+
+						if (!m_UnsupportedFeature.empty())
+							return;
+
+						// Validate the primitive, all the attributes must have the same number of elements.
+						const auto& position = primitive.m_Attributes[EnumToInt(VertexAttribute::Position)];
+						if (!position.isValid())
+						{
+							m_UnsupportedFeature = "Primitives without positions are not supported.";
+							return;
+						}
+
+						for (const auto& accessor : primitive.m_Attributes)
+						{
+							if (accessor.isValid() && accessor.m_Count != position.m_Count)
+								throw AssetError("The glTF asset contains a primitive with mismatching attribute counts!");
+						}
+
+						if (primitive.m_Indices.isValid() && (primitive.m_Indices.m_ComponentCount != 1 || primitive.m_Indices.m_ComponentType == ComponentTypeByte || primitive.m_Indices.m_ComponentType == ComponentTypeShort || primitive.m_Indices.m_ComponentType == ComponentTypeFloat))
+							throw AssetError("The glTF asset contains invalid indices!");
+					}
+				}
+			}
+
+			void DecodeAccessor(const Accessor& accessor, float* pDestination, uint32_t components, float fillValue /*= 0.0f*/)
+			{
+				OPTICK_EVENT();
+
+				const auto copyComponents = std::min<uint32_t>(accessor.m_ComponentCount, components);
+				const auto componentSize = GetComponentSize(accessor.m_ComponentType);
+
+				// Floats which are not converted can be copied directly.
+				if (accessor.m_ComponentType == ComponentTypeFloat && copyComponents == components)
+				{
+					if (accessor.m_Stride == components * sizeof(float))
+					{
+						std::memcpy(pDestination, accessor.m_pData, accessor.m_Count * accessor.m_Stride);
+						return;
+					}
+
+					for (uint64_t i = 0; i < accessor.m_Count; i++)
+						std::memcpy(pDestination + i * components, accessor.m_pData + i * accessor.m_Stride, components * sizeof(float));
+
+					return;
+				}
+
+				uint64_t i = 0;
+
+#ifdef FLINT_GLTF_LOADER_SSE2
+				// Convert a whole element at a time. A 16 byte (or 8 or 4 byte for the small integers) load can read past the element, so the last elements
+				// are converted using the scalar path to make sure that we never read past the end of the buffer view.
+				const uint32_t loadSize = componentSize == 1 ? 4 : componentSize * 4;
+				const uint64_t accessorSize = accessor.m_Count > 0 ? (accessor.m_Count - 1) * accessor.m_Stride + componentSize * accessor.m_ComponentCount : 0;
+				const uint64_t vectorCount = accessor.m_ComponentType == ComponentTypeUnsignedInt ? 0 : std::min(accessor.m_Count, accessorSize >= loadSize ? (accessorSize - loadSize) / accessor.m_Stride + 1 : 0);
+
+				float scale = 1.0f;
+				if (accessor.m_IsNormalized)
+				{
+					switch (accessor.m_ComponentType)
+					{
+					case ComponentTypeByte:				scale = 1.0f / 127.0f; break;
+					case ComponentTypeUnsignedByte:		scale = 1.0f / 255.0f; break;
+					case ComponentTypeShort:			scale = 1.0f / 32767.0f; break;
+					case ComponentTypeUnsignedShort:	scale = 1.0f / 65535.0f; break;
+					default:							break;
+					}
+				}
+
+				const auto scaleVector = _mm_set1_ps(scale);
+				const auto minimum = _mm_set1_ps(accessor.m_IsNormalized ? -1.0f : -std::numeric_limits<float>::max());
+				const auto zero = _mm_setzero_si128();
+
+				alignas(16) std::array<float, 4> lanes = {};
+				for (; i < vectorCount; i++)
+				{
+					const auto pElement = accessor.m_pData + i * accessor.m_Stride;
+
+					__m128 values = {};
+					switch (accessor.m_ComponentType)
+					{
+					case ComponentTypeByte:
+					{
+						const auto bytes = _mm_cvtsi32_si128(static_cast<int32_t>(ReadUint32(pElement)));
+						const auto words = _mm_srai_epi16(_mm_unpacklo_epi8(bytes, bytes), 8);
+						values = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16));
+						break;
+					}
+
+					case ComponentTypeUnsignedByte:
+					{
+						const auto bytes = _mm_cvtsi32_si128(static_cast<int32_t>(ReadUint32(pElement)));
+						values = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero));
+						break;
+					}
+
+					case ComponentTypeShort:
+					{
+						const auto words = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pElement));
+						values = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16));
+						break;
+					}
+
+					case ComponentTypeUnsignedShort:
+						values = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pElement)), zero));
+						break;
+
+					default:
+						values = _mm_loadu_ps(reinterpret_cast<const float*>(pElement));
+						break;
+					}
+
+					_mm_store_ps(lanes.data(), _mm_max_ps(_mm_mul_ps(values, scaleVector), minimum));
+
+					const auto pOutput = pDestination + i * components;
+					std::copy_n(lanes.data(), copyComponents, pOutput);
+					std::fill(pOutput + copyComponents, pOutput + components, fillValue);
+				}
+
+#endif
+
+				// Convert the remaining elements.
+				for (; i < accessor.m_Count; i++)
+				{
+					const auto pElement = accessor.m_pData + i * accessor.m_Stride;
+					const auto pOutput = pDestination + i * components;
+
+					for (uint32_t c = 0; c < copyComponents; c++)
+						pOutput[c] = ReadComponent(pElement + c * componentSize, accessor.m_ComponentType, accessor.m_IsNormalized);
+
+					std::fill(pOutput + copyComponents, pOutput + components, fillValue);
+				}
+			}
+
+			void DecodeIndices(const Accessor& accessor, uint32_t* pDestination)
+			{
+				OPTICK_EVENT();
+
+				const auto componentSize = GetComponentSize(accessor.m_ComponentType);
+				if (accessor.m_ComponentType == ComponentTypeUnsignedInt && accessor.m_Stride == sizeof(uint32_t))
+				{
+					std::memcpy(pDestination, accessor.m_pData, accessor.m_Count * sizeof(uint32_t));
+					return;
+				}
+
+				uint64_t i = 0;
+
+#ifdef FLINT_GLTF_LOADER_SSE2
+				// Widen 8 indices at a time if they are tightly packed.
+				if (accessor.m_Stride == componentSize && componentSize < sizeof(uint32_t))
+				{
+					const auto zero = _mm_setzero_si128();
+
+					if (componentSize == sizeof(uint16_t))
+					{
+						for (; i + 8 <= accessor.m_Count; i += 8)
+						{
+							const auto words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accessor.m_pData + i * sizeof(uint16_t)));
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i), _mm_unpacklo_epi16(words, zero));
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i + 4), _mm_unpackhi_epi16(words, zero));
+						}
+					}
+					else
+					{
+						for (; i + 8 <= accessor.m_Count; i += 8)
+						{
+							const auto words = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(accessor.m_pData + i)), zero);
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i), _mm_unpacklo_epi16(words, zero));
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i + 4), _mm_unpackhi_epi16(words, zero));
+						}
+					}
+				}
+
+#endif
+
+				// Widen the remaining indices.
+				for (; i < accessor.m_Count; i++)
+					pDestination[i] = ReadIndex(accessor.m_pData + i * accessor.m_Stride, accessor.m_ComponentType);
+			}
+		}
+	}
+}
\ No newline at end of file
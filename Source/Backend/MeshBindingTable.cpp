@@ -15,7 +15,16 @@ namespace Flint
 	{
 		void MeshBindingTable::bind(uint32_t binding, const std::shared_ptr<Buffer>& pBuffer)
 		{
-			m_pBuffers[binding] = pBuffer;
+			m_Buffers[binding] = BufferBinding{ pBuffer, 0, pBuffer->getSize() };
+		}
+
+		void MeshBindingTable::bind(uint32_t binding, const BufferRegion& region)
+		{
+			// Validate the region.
+			if (!region.isValid())
+				throw InvalidArgumentError("The buffer region should point to a valid buffer!");
+
+			m_Buffers[binding] = BufferBinding{ region.m_pBuffer, region.m_Offset, region.m_Size };
 		}
 
 		void MeshBindingTable::bind(uint32_t binding, const std::shared_ptr<TextureView>& pView, const std::shared_ptr<TextureSampler>& pSampler, ImageUsage currentUsage)
@@ -27,17 +36,39 @@ namespace Flint
 			m_Images[binding] = ImageBinding{ pView, pSampler, currentUsage };
 		}
 
+		void MeshBindingTable::setConstants(const std::byte* pData, uint64_t size)
+		{
+			m_Constants.assign(pData, pData + size);
+		}
+
+		void MeshBindingTable::setConstant(const BindingMap& bindingMap, std::string_view name, const std::byte* pData, uint64_t size)
+		{
+			const auto pPushConstant = bindingMap.findPushConstant(name);
+			if (!pPushConstant)
+				throw InvalidArgumentError("The program does not have a push constant with the given name!");
+
+			if (size > pPushConstant->m_Size)
+				throw InvalidArgumentError("The push constant data should not be larger than the push constant!");
+
+			if (m_Constants.size() < pPushConstant->m_Offset + size)
+				m_Constants.resize(pPushConstant->m_Offset + size);
+
+			std::copy_n(pData, size, m_Constants.begin() + pPushConstant->m_Offset);
+		}
+
 		uint64_t MeshBindingTable::generateHash() const
 		{
 			OPTICK_EVENT();
 
 			std::vector<uint64_t> hashes;
-			hashes.reserve((m_pBuffers.size() * 2) + (m_Images.size() * 4));
+			hashes.reserve((m_Buffers.size() * 3) + (m_Images.size() * 4));
 
-			for (const auto& [index, pBuffer] : m_pBuffers)
+			// Note that the buffer offsets are not hashed, dynamic offsets are supplied at draw time.
+			for (const auto& [index, buffer] : m_Buffers)
 			{
 				hashes.emplace_back(index);
-				hashes.emplace_back(reinterpret_cast<uint64_t>(pBuffer.get()));
+				hashes.emplace_back(reinterpret_cast<uint64_t>(buffer.m_pBuffer.get()));
+				hashes.emplace_back(buffer.m_Size);
 			}
 
 			for (const auto& [index, image] : m_Images)
@@ -0,0 +1,917 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Flint/Backend/MeshOptimizer.hpp"
+
+#include <Optick.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace /* anonymous */
+{
+	/**
+	 * Invalid vertex index.
+	 */
+	constexpr uint32_t InvalidIndex = -1;
+
+	/**
+	 * Triangle adjacency structure.
+	 * This contains the triangles which use each vertex.
+	 */
+	struct TriangleAdjacency final
+	{
+		std::vector<uint32_t> m_Offsets;
+		std::vector<uint32_t> m_Counts;
+		std::vector<uint32_t> m_Triangles;
+	};
+
+	/**
+	 * FIFO vertex cache class.
+	 * This uses a timestamp per vertex, so a vertex is in the cache if it was inserted within the last cache size insertions.
+	 */
+	class VertexCache final
+	{
+	public:
+		/**
+		 * Explicit constructor.
+		 *
+		 * @param vertexCount The number of vertices.
+		 * @param cacheSize The cache size.
+		 */
+		explicit VertexCache(uint64_t vertexCount, uint32_t cacheSize) : m_Timestamps(vertexCount, 0), m_Timestamp(cacheSize + 1), m_CacheSize(cacheSize) {}
+
+		/**
+		 * Access a vertex.
+		 *
+		 * @param vertex The vertex index.
+		 * @return Whether the access was a cache miss.
+		 */
+		bool access(uint32_t vertex)
+		{
+			if (m_Timestamp - m_Timestamps[vertex] <= m_CacheSize)
+				return false;
+
+			m_Timestamps[vertex] = m_Timestamp++;
+			return true;
+		}
+
+		/**
+		 * Access a triangle.
+		 *
+		 * @param pTriangle The triangle's indices.
+		 * @return The number of cache misses.
+		 */
+		uint32_t access(const uint32_t* pTriangle)
+		{
+			return static_cast<uint32_t>(access(pTriangle[0])) + static_cast<uint32_t>(access(pTriangle[1])) + static_cast<uint32_t>(access(pTriangle[2]));
+		}
+
+		/**
+		 * Get the age of a vertex in the cache.
+		 * If the age is greater than the cache size, the vertex is not in the cache.
+		 *
+		 * @param vertex The vertex index.
+		 * @return The age.
+		 */
+		[[nodiscard]] uint32_t getAge(uint32_t vertex) const { return m_Timestamp - m_Timestamps[vertex]; }
+
+		/**
+		 * Evict all the vertices from the cache.
+		 */
+		void clear() { m_Timestamp += m_CacheSize + 1; }
+
+	private:
+		std::vector<uint32_t> m_Timestamps;
+		uint32_t m_Timestamp = 0;
+		uint32_t m_CacheSize = 0;
+	};
+
+	/**
+	 * Build the triangle adjacency of the vertices.
+	 *
+	 * @param indices The triangle list indices.
+	 * @param vertexCount The number of vertices.
+	 * @return The adjacency.
+	 */
+	TriangleAdjacency BuildAdjacency(const std::vector<uint32_t>& indices, uint64_t vertexCount)
+	{
+		TriangleAdjacency adjacency;
+		adjacency.m_Counts.resize(vertexCount, 0);
+		adjacency.m_Offsets.resize(vertexCount, 0);
+		adjacency.m_Triangles.resize(indices.size());
+
+		for (const auto index : indices)
+			adjacency.m_Counts[index]++;
+
+		uint32_t offset = 0;
+		for (uint64_t v = 0; v < vertexCount; v++)
+		{
+			adjacency.m_Offsets[v] = offset;
+			offset += adjacency.m_Counts[v];
+		}
+
+		// Fill the triangles. We use a copy of the offsets as the insert positions.
+		auto insertOffsets = adjacency.m_Offsets;
+		for (uint32_t i = 0; i < indices.size(); i++)
+			adjacency.m_Triangles[insertOffsets[indices[i]]++] = i / 3;
+
+		return adjacency;
+	}
+
+	/**
+	 * Compute the bounding sphere and the normal cone of a meshlet.
+	 *
+	 * @param meshlet The meshlet to compute the bounds of.
+	 * @param indices The triangle list indices.
+	 * @param pPositions The vertex positions.
+	 */
+	void ComputeMeshletBounds(Flint::Backend::Meshlet& meshlet, const std::vector<uint32_t>& indices, const float* pPositions)
+	{
+		const auto pIndices = indices.data() + meshlet.m_IndexOffset;
+
+		// Compute the center of the bounding box, and use it as the center of the sphere.
+		std::array<float, 3> minimum = { pPositions[pIndices[0] * 3], pPositions[pIndices[0] * 3 + 1], pPositions[pIndices[0] * 3 + 2] };
+		std::array<float, 3> maximum = minimum;
+		for (uint32_t i = 1; i < meshlet.m_IndexCount; i++)
+		{
+			const auto pPosition = pPositions + pIndices[i] * 3;
+			for (uint8_t c = 0; c < 3; c++)
+			{
+				minimum[c] = std::min(minimum[c], pPosition[c]);
+				maximum[c] = std::max(maximum[c], pPosition[c]);
+			}
+		}
+
+		float radiusSquared = 0.0f;
+		for (uint8_t c = 0; c < 3; c++)
+			meshlet.m_Center[c] = (minimum[c] + maximum[c]) * 0.5f;
+
+		for (uint32_t i = 0; i < meshlet.m_IndexCount; i++)
+		{
+			const auto pPosition = pPositions + pIndices[i] * 3;
+			const auto x = pPosition[0] - meshlet.m_Center[0];
+			const auto y = pPosition[1] - meshlet.m_Center[1];
+			const auto z = pPosition[2] - meshlet.m_Center[2];
+
+			radiusSquared = std::max(radiusSquared, x * x + y * y + z * z);
+		}
+
+		meshlet.m_Radius = std::sqrt(radiusSquared);
+
+		// Compute the unit normals of the triangles and average them to get the cone axis.
+		std::vector<std::array<float, 3>> normals;
+		normals.reserve(meshlet.m_IndexCount / 3);
+
+		std::array<float, 3> axis = { 0.0f, 0.0f, 0.0f };
+		for (uint32_t t = 0; t < meshlet.m_IndexCount; t += 3)
+		{
+			const auto pA = pPositions + pIndices[t + 0] * 3;
+			const auto pB = pPositions + pIndices[t + 1] * 3;
+			const auto pC = pPositions + pIndices[t + 2] * 3;
+
+			const std::array<float, 3> edgeA = { pB[0] - pA[0], pB[1] - pA[1], pB[2] - pA[2] };
+			const std::array<float, 3> edgeB = { pC[0] - pA[0], pC[1] - pA[1], pC[2] - pA[2] };
+			std::array<float, 3> normal = {
+				edgeA[1] * edgeB[2] - edgeA[2] * edgeB[1],
+				edgeA[2] * edgeB[0] - edgeA[0] * edgeB[2],
+				edgeA[0] * edgeB[1] - edgeA[1] * edgeB[0]
+			};
+
+			// Degenerate triangles are never visible so they don't affect the cone.
+			const auto length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+			if (length == 0.0f)
+				continue;
+
+			for (uint8_t c = 0; c < 3; c++)
+			{
+				normal[c] /= length;
+				axis[c] += normal[c];
+			}
+
+			normals.emplace_back(normal);
+		}
+
+		const auto axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+		if (axisLength == 0.0f)
+			return;
+
+		for (uint8_t c = 0; c < 3; c++)
+			meshlet.m_ConeAxis[c] = axis[c] / axisLength;
+
+		// The cone's half angle is the largest angle between the axis and a normal. If it's larger than 90 degrees the cone cannot be used for culling.
+		float minimumDot = 1.0f;
+		for (const auto& normal : normals)
+			minimumDot = std::min(minimumDot, normal[0] * meshlet.m_ConeAxis[0] + normal[1] * meshlet.m_ConeAxis[1] + normal[2] * meshlet.m_ConeAxis[2]);
+
+		meshlet.m_ConeCutoff = minimumDot <= 0.0f ? 1.0f : std::sqrt(1.0f - minimumDot * minimumDot);
+	}
+
+	/**
+	 * Error quadric structure.
+	 * This stores a symmetric 4x4 matrix which is used to compute the weighted sum of the squared distances from a point to a set of planes.
+	 */
+	struct Quadric final
+	{
+		double m_A2 = 0.0, m_B2 = 0.0, m_C2 = 0.0, m_D2 = 0.0;
+		double m_AB = 0.0, m_AC = 0.0, m_AD = 0.0;
+		double m_BC = 0.0, m_BD = 0.0;
+		double m_CD = 0.0;
+		double m_Weight = 0.0;
+	};
+
+	/**
+	 * Edge collapse structure.
+	 * This moves the source vertex to the destination vertex's position.
+	 */
+	struct EdgeCollapse final
+	{
+		double m_Cost = 0.0;
+		uint32_t m_Source = 0;
+		uint32_t m_Destination = 0;
+	};
+
+	/**
+	 * Add a plane to a quadric.
+	 *
+	 * @param quadric The quadric to add to.
+	 * @param a The plane's normal X.
+	 * @param b The plane's normal Y.
+	 * @param c The plane's normal Z.
+	 * @param d The plane's distance.
+	 * @param weight The weight of the plane.
+	 */
+	void AddPlane(Quadric& quadric, double a, double b, double c, double d, double weight)
+	{
+		quadric.m_A2 += a * a * weight;
+		quadric.m_B2 += b * b * weight;
+		quadric.m_C2 += c * c * weight;
+		quadric.m_D2 += d * d * weight;
+		quadric.m_AB += a * b * weight;
+		quadric.m_AC += a * c * weight;
+		quadric.m_AD += a * d * weight;
+		quadric.m_BC += b * c * weight;
+		quadric.m_BD += b * d * weight;
+		quadric.m_CD += c * d * weight;
+		quadric.m_Weight += weight;
+	}
+
+	/**
+	 * Add a quadric to another.
+	 *
+	 * @param quadric The quadric to add to.
+	 * @param other The quadric to add.
+	 */
+	void AddQuadric(Quadric& quadric, const Quadric& other)
+	{
+		quadric.m_A2 += other.m_A2;
+		quadric.m_B2 += other.m_B2;
+		quadric.m_C2 += other.m_C2;
+		quadric.m_D2 += other.m_D2;
+		quadric.m_AB += other.m_AB;
+		quadric.m_AC += other.m_AC;
+		quadric.m_AD += other.m_AD;
+		quadric.m_BC += other.m_BC;
+		quadric.m_BD += other.m_BD;
+		quadric.m_CD += other.m_CD;
+		quadric.m_Weight += other.m_Weight;
+	}
+
+	/**
+	 * Evaluate a quadric at a point.
+	 *
+	 * @param quadric The quadric.
+	 * @param pPosition The point's position.
+	 * @return The weighted mean of the squared distances to the quadric's planes.
+	 */
+	double EvaluateQuadric(const Quadric& quadric, const float* pPosition)
+	{
+		if (quadric.m_Weight == 0.0)
+			return 0.0;
+
+		const double x = pPosition[0], y = pPosition[1], z = pPosition[2];
+		const auto error =
+			quadric.m_A2 * x * x + quadric.m_B2 * y * y + quadric.m_C2 * z * z + quadric.m_D2 +
+			2.0 * (quadric.m_AB * x * y + quadric.m_AC * x * z + quadric.m_AD * x + quadric.m_BC * y * z + quadric.m_BD * y + quadric.m_CD * z);
+
+		return std::max(error, 0.0) / quadric.m_Weight;
+	}
+
+	/**
+	 * Compute the (unnormalized) normal of a triangle.
+	 *
+	 * @param pA The first vertex position.
+	 * @param pB The second vertex position.
+	 * @param pC The third vertex position.
+	 * @return The normal. Its length is twice the triangle's area.
+	 */
+	std::array<float, 3> ComputeTriangleNormal(const float* pA, const float* pB, const float* pC)
+	{
+		const std::array<float, 3> edgeA = { pB[0] - pA[0], pB[1] - pA[1], pB[2] - pA[2] };
+		const std::array<float, 3> edgeB = { pC[0] - pA[0], pC[1] - pA[1], pC[2] - pA[2] };
+
+		return {
+			edgeA[1] * edgeB[2] - edgeA[2] * edgeB[1],
+			edgeA[2] * edgeB[0] - edgeA[0] * edgeB[2],
+			edgeA[0] * edgeB[1] - edgeA[1] * edgeB[0]
+		};
+	}
+
+	/**
+	 * Find the vertices which must not be moved when simplifying.
+	 * These are the vertices on open borders, and the vertices on attribute seams (vertices which share a position with another vertex).
+	 *
+	 * @param indices The triangle list indices.
+	 * @param pPositions The vertex positions.
+	 * @param vertexCount The number of vertices.
+	 * @return Whether each vertex is locked.
+	 */
+	std::vector<bool> FindLockedVertices(const std::vector<uint32_t>& indices, const float* pPositions, uint64_t vertexCount)
+	{
+		// Weld the vertices by their positions. Vertices with the same position are seams.
+		auto sortedVertices = std::vector<uint32_t>(vertexCount);
+		std::iota(sortedVertices.begin(), sortedVertices.end(), 0);
+		std::sort(sortedVertices.begin(), sortedVertices.end(), [pPositions](uint32_t lhs, uint32_t rhs)
+			{
+				return std::lexicographical_compare(pPositions + lhs * 3, pPositions + lhs * 3 + 3, pPositions + rhs * 3, pPositions + rhs * 3 + 3);
+			}
+		);
+
+		auto isLocked = std::vector<bool>(vertexCount, false);
+		auto positionRemap = std::vector<uint32_t>(vertexCount);
+		for (uint64_t i = 0; i < vertexCount;)
+		{
+			uint64_t end = i + 1;
+			while (end < vertexCount && std::equal(pPositions + sortedVertices[i] * 3, pPositions + sortedVertices[i] * 3 + 3, pPositions + sortedVertices[end] * 3))
+				end++;
+
+			for (uint64_t j = i; j < end; j++)
+			{
+				positionRemap[sortedVertices[j]] = sortedVertices[i];
+				isLocked[sortedVertices[j]] = end - i > 1;
+			}
+
+			i = end;
+		}
+
+		// Find the border edges. These are the (welded) edges which are only used by a single triangle.
+		std::vector<uint64_t> edges;
+		edges.reserve(indices.size());
+		for (uint64_t i = 0; i < indices.size(); i += 3)
+		{
+			for (uint8_t e = 0; e < 3; e++)
+			{
+				const auto a = positionRemap[indices[i + e]];
+				const auto b = positionRemap[indices[i + (e + 1) % 3]];
+				edges.emplace_back((static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b));
+			}
+		}
+
+		std::sort(edges.begin(), edges.end());
+
+		auto isBorder = std::vector<bool>(vertexCount, false);
+		for (uint64_t i = 0; i < edges.size();)
+		{
+			uint64_t end = i + 1;
+			while (end < edges.size() && edges[end] == edges[i])
+				end++;
+
+			if (end - i == 1)
+			{
+				isBorder[edges[i] >> 32] = true;
+				isBorder[edges[i] & 0xffffffff] = true;
+			}
+
+			i = end;
+		}
+
+		for (uint64_t v = 0; v < vertexCount; v++)
+		{
+			if (isBorder[positionRemap[v]])
+				isLocked[v] = true;
+		}
+
+		return isLocked;
+	}
+
+	/**
+	 * Check if moving a vertex to another vertex's position flips any of its triangles.
+	 *
+	 * @param indices The triangle list indices.
+	 * @param pPositions The vertex positions.
+	 * @param adjacency The triangle adjacency.
+	 * @param source The vertex to move.
+	 * @param destination The vertex to move to.
+	 * @return Whether a triangle flips.
+	 */
+	bool CollapseFlipsTriangles(const std::vector<uint32_t>& indices, const float* pPositions, const TriangleAdjacency& adjacency, uint32_t source, uint32_t destination)
+	{
+		const auto pDestination = pPositions + destination * 3;
+		for (uint32_t i = 0; i < adjacency.m_Counts[source]; i++)
+		{
+			const auto pTriangle = indices.data() + adjacency.m_Triangles[adjacency.m_Offsets[source] + i] * 3;
+
+			// The triangles which contain both vertices are removed by the collapse.
+			if (pTriangle[0] == destination || pTriangle[1] == destination || pTriangle[2] == destination)
+				continue;
+
+			std::array<const float*, 3> pCorners = { pPositions + pTriangle[0] * 3, pPositions + pTriangle[1] * 3, pPositions + pTriangle[2] * 3 };
+			const auto oldNormal = ComputeTriangleNormal(pCorners[0], pCorners[1], pCorners[2]);
+
+			for (uint8_t c = 0; c < 3; c++)
+			{
+				if (pTriangle[c] == source)
+					pCorners[c] = pDestination;
+			}
+
+			const auto newNormal = ComputeTriangleNormal(pCorners[0], pCorners[1], pCorners[2]);
+			if (oldNormal[0] * newNormal[0] + oldNormal[1] * newNormal[1] + oldNormal[2] * newNormal[2] <= 0.0f)
+				return true;
+		}
+
+		return false;
+	}
+}
+
+namespace Flint
+{
+	namespace Backend
+	{
+		namespace MeshOptimizer
+		{
+			VertexCacheStatistics AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint64_t vertexCount, uint32_t cacheSize /*= DefaultCacheSize*/)
+			{
+				OPTICK_EVENT();
+
+				VertexCacheStatistics statistics;
+				statistics.m_TriangleCount = indices.size() / 3;
+
+				auto cache = VertexCache(vertexCount, cacheSize);
+				auto isReferenced = std::vector<bool>(vertexCount, false);
+				for (const auto index : indices)
+				{
+					statistics.m_CacheMisses += cache.access(index);
+
+					if (!isReferenced[index])
+					{
+						isReferenced[index] = true;
+						statistics.m_VertexCount++;
+					}
+				}
+
+				return statistics;
+			}
+
+			void OptimizeVertexCache(std::vector<uint32_t>& indices, uint64_t vertexCount, uint32_t cacheSize /*= DefaultCacheSize*/)
+			{
+				OPTICK_EVENT();
+
+				const auto triangleCount = indices.size() / 3;
+				if (triangleCount == 0)
+					return;
+
+				const auto adjacency = BuildAdjacency(indices, vertexCount);
+				auto liveTriangles = adjacency.m_Counts;
+				auto cache = VertexCache(vertexCount, cacheSize);
+				auto isEmitted = std::vector<bool>(triangleCount, false);
+
+				std::vector<uint32_t> result;
+				result.reserve(triangleCount * 3);
+
+				std::vector<uint32_t> deadEndStack;
+				std::vector<uint32_t> candidates;
+				uint32_t cursor = 0;
+
+				// Start fanning around the first vertex.
+				auto fanningVertex = indices.front();
+				while (fanningVertex != InvalidIndex)
+				{
+					candidates.clear();
+
+					// Emit all the remaining triangles around the fanning vertex.
+					const auto pTriangles = adjacency.m_Triangles.data() + adjacency.m_Offsets[fanningVertex];
+					for (uint32_t i = 0; i < adjacency.m_Counts[fanningVertex]; i++)
+					{
+						const auto triangle = pTriangles[i];
+						if (isEmitted[triangle])
+							continue;
+
+						for (uint8_t j = 0; j < 3; j++)
+						{
+							const auto vertex = indices[triangle * 3 + j];
+							result.emplace_back(vertex);
+							deadEndStack.emplace_back(vertex);
+							candidates.emplace_back(vertex);
+
+							liveTriangles[vertex]--;
+							cache.access(vertex);
+						}
+
+						isEmitted[triangle] = true;
+					}
+
+					// Select the next fanning vertex from the candidates. We prefer the oldest vertex which will still be in the cache after emitting it's triangles.
+					fanningVertex = InvalidIndex;
+					int64_t bestPriority = -1;
+					for (const auto candidate : candidates)
+					{
+						if (liveTriangles[candidate] == 0)
+							continue;
+
+						int64_t priority = 0;
+						if (cache.getAge(candidate) + 2 * liveTriangles[candidate] <= cacheSize)
+							priority = cache.getAge(candidate);
+
+						if (priority > bestPriority)
+						{
+							bestPriority = priority;
+							fanningVertex = candidate;
+						}
+					}
+
+					// If we hit a dead end, we first try the recently used vertices and then move to the next vertex in the input order.
+					while (fanningVertex == InvalidIndex && !deadEndStack.empty())
+					{
+						const auto vertex = deadEndStack.back();
+						deadEndStack.pop_back();
+
+						if (liveTriangles[vertex] > 0)
+							fanningVertex = vertex;
+					}
+
+					while (fanningVertex == InvalidIndex && cursor < vertexCount)
+					{
+						if (liveTriangles[cursor] > 0)
+							fanningVertex = cursor;
+
+						cursor++;
+					}
+				}
+
+				indices = std::move(result);
+			}
+
+			void OptimizeOverdraw(std::vector<uint32_t>& indices, const float* pPositions, uint64_t vertexCount, float threshold /*= 1.05f*/, uint32_t cacheSize /*= DefaultCacheSize*/)
+			{
+				OPTICK_EVENT();
+
+				const auto triangleCount = indices.size() / 3;
+				if (triangleCount < 2)
+					return;
+
+				auto cache = VertexCache(vertexCount, cacheSize);
+
+				// Find the hard boundaries. These are the triangles where the vertex cache optimizer hit a dead end, which means that all the vertices missed.
+				std::vector<uint32_t> hardBoundaries;
+				for (uint32_t t = 0; t < triangleCount; t++)
+				{
+					if (cache.access(indices.data() + t * 3) == 3)
+						hardBoundaries.emplace_back(t);
+				}
+
+				hardBoundaries.emplace_back(static_cast<uint32_t>(triangleCount));
+
+				// Split the hard clusters further, wherever the ACMR of the cluster so far is close enough to the ACMR of the whole hard cluster.
+				std::vector<uint32_t> clusters;
+				for (uint64_t h = 0; h + 1 < hardBoundaries.size(); h++)
+				{
+					const auto start = hardBoundaries[h];
+					const auto end = hardBoundaries[h + 1];
+
+					cache.clear();
+					uint32_t clusterMisses = 0;
+					for (auto t = start; t < end; t++)
+						clusterMisses += cache.access(indices.data() + t * 3);
+
+					const auto clusterACMR = static_cast<float>(clusterMisses) / (end - start);
+
+					cache.clear();
+					clusters.emplace_back(start);
+
+					uint32_t misses = 0;
+					auto clusterStart = start;
+					for (auto t = start; t < end; t++)
+					{
+						misses += cache.access(indices.data() + t * 3);
+
+						if (t + 1 < end && static_cast<float>(misses) / (t - clusterStart + 1) <= clusterACMR * threshold)
+						{
+							cache.clear();
+							clusters.emplace_back(t + 1);
+
+							clusterStart = t + 1;
+							misses = 0;
+						}
+					}
+				}
+
+				clusters.emplace_back(static_cast<uint32_t>(triangleCount));
+
+				// Compute the area weighted centroid and normal of each cluster.
+				const auto clusterCount = clusters.size() - 1;
+				std::vector<std::array<float, 3>> clusterCentroids(clusterCount, { 0.0f, 0.0f, 0.0f });
+				std::vector<std::array<float, 3>> clusterNormals(clusterCount, { 0.0f, 0.0f, 0.0f });
+				std::vector<float> clusterAreas(clusterCount, 0.0f);
+
+				std::array<float, 3> meshCentroid = { 0.0f, 0.0f, 0.0f };
+				float meshArea = 0.0f;
+
+				for (uint64_t c = 0; c < clusterCount; c++)
+				{
+					for (auto t = clusters[c]; t < clusters[c + 1]; t++)
+					{
+						const auto pA = pPositions + indices[t * 3 + 0] * 3;
+						const auto pB = pPositions + indices[t * 3 + 1] * 3;
+						const auto pC = pPositions + indices[t * 3 + 2] * 3;
+
+						const std::array<float, 3> edgeA = { pB[0] - pA[0], pB[1] - pA[1], pB[2] - pA[2] };
+						const std::array<float, 3> edgeB = { pC[0] - pA[0], pC[1] - pA[1], pC[2] - pA[2] };
+						const std::array<float, 3> normal = {
+							edgeA[1] * edgeB[2] - edgeA[2] * edgeB[1],
+							edgeA[2] * edgeB[0] - edgeA[0] * edgeB[2],
+							edgeA[0] * edgeB[1] - edgeA[1] * edgeB[0]
+						};
+
+						const auto area = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+						for (uint8_t i = 0; i < 3; i++)
+						{
+							clusterCentroids[c][i] += (pA[i] + pB[i] + pC[i]) / 3.0f * area;
+							clusterNormals[c][i] += normal[i];
+						}
+
+						clusterAreas[c] += area;
+					}
+
+					for (uint8_t i = 0; i < 3; i++)
+						meshCentroid[i] += clusterCentroids[c][i];
+
+					meshArea += clusterAreas[c];
+				}
+
+				if (meshArea > 0.0f)
+				{
+					for (auto& value : meshCentroid)
+						value /= meshArea;
+				}
+
+				// Compute the sort key of each cluster. Clusters which face outwards from the center are more likely to occlude the others.
+				std::vector<float> sortKeys(clusterCount, 0.0f);
+				for (uint64_t c = 0; c < clusterCount; c++)
+				{
+					const auto& normal = clusterNormals[c];
+					const auto length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+					if (length == 0.0f || clusterAreas[c] == 0.0f)
+						continue;
+
+					for (uint8_t i = 0; i < 3; i++)
+						sortKeys[c] += (clusterCentroids[c][i] / clusterAreas[c] - meshCentroid[i]) * normal[i] / length;
+				}
+
+				std::vector<uint32_t> clusterOrder(clusterCount);
+				std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+				std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&sortKeys](uint32_t lhs, uint32_t rhs) { return sortKeys[lhs] > sortKeys[rhs]; });
+
+				// Finally emit the clusters in the sorted order.
+				std::vector<uint32_t> result;
+				result.reserve(indices.size());
+
+				for (const auto cluster : clusterOrder)
+					result.insert(result.end(), indices.begin() + clusters[cluster] * 3, indices.begin() + clusters[cluster + 1] * 3);
+
+				indices = std::move(result);
+			}
+
+			std::vector<uint32_t> OptimizeVertexFetch(std::vector<uint32_t>& indices, uint64_t vertexCount)
+			{
+				OPTICK_EVENT();
+
+				auto remapTable = std::vector<uint32_t>(vertexCount, InvalidIndex);
+				uint32_t nextVertex = 0;
+
+				// Assign the new indices in the order of first use.
+				for (auto& index : indices)
+				{
+					if (remapTable[index] == InvalidIndex)
+						remapTable[index] = nextVertex++;
+
+					index = remapTable[index];
+				}
+
+				// Move the unused vertices to the end.
+				for (auto& vertex : remapTable)
+				{
+					if (vertex == InvalidIndex)
+						vertex = nextVertex++;
+				}
+
+				return remapTable;
+			}
+
+			std::vector<uint32_t> Simplify(const std::vector<uint32_t>& indices, const float* pPositions, uint64_t vertexCount, uint64_t targetIndexCount, float targetError, float* pResultError /*= nullptr*/)
+			{
+				OPTICK_EVENT();
+
+				auto result = indices;
+				double maximumError = 0.0;
+
+				// Compute the area weighted plane quadrics of the vertices.
+				auto quadrics = std::vector<Quadric>(vertexCount);
+				for (uint64_t i = 0; i < indices.size(); i += 3)
+				{
+					const auto pA = pPositions + indices[i + 0] * 3;
+					const auto normal = ComputeTriangleNormal(pA, pPositions + indices[i + 1] * 3, pPositions + indices[i + 2] * 3);
+					const auto length = std::sqrt(static_cast<double>(normal[0]) * normal[0] + static_cast<double>(normal[1]) * normal[1] + static_cast<double>(normal[2]) * normal[2]);
+					if (length == 0.0)
+						continue;
+
+					const auto a = normal[0] / length, b = normal[1] / length, c = normal[2] / length;
+					const auto d = -(a * pA[0] + b * pA[1] + c * pA[2]);
+
+					for (uint8_t v = 0; v < 3; v++)
+						AddPlane(quadrics[indices[i + v]], a, b, c, d, length * 0.5);
+				}
+
+				const auto isLocked = FindLockedVertices(indices, pPositions, vertexCount);
+				const auto maximumCost = static_cast<double>(targetError) * targetError;
+
+				std::vector<uint64_t> edges;
+				std::vector<EdgeCollapse> collapses;
+				auto remapTable = std::vector<uint32_t>(vertexCount);
+				auto isDirty = std::vector<bool>(vertexCount);
+
+				// Collapse the cheapest edges in passes. Each vertex can only be touched once per pass so that the costs and the adjacency stay valid.
+				while (result.size() > targetIndexCount)
+				{
+					const auto adjacency = BuildAdjacency(result, vertexCount);
+
+					// Collect the unique edges.
+					edges.clear();
+					for (uint64_t i = 0; i < result.size(); i += 3)
+					{
+						for (uint8_t e = 0; e < 3; e++)
+						{
+							const auto a = result[i + e];
+							const auto b = result[i + (e + 1) % 3];
+							edges.emplace_back((static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b));
+						}
+					}
+
+					std::sort(edges.begin(), edges.end());
+					edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+					// Pick the cheapest direction of each edge.
+					collapses.clear();
+					for (const auto edge : edges)
+					{
+						const auto a = static_cast<uint32_t>(edge >> 32);
+						const auto b = static_cast<uint32_t>(edge & 0xffffffff);
+						if (a == b)
+							continue;
+
+						auto collapse = EdgeCollapse();
+						collapse.m_Cost = std::numeric_limits<double>::max();
+
+						if (!isLocked[a])
+							collapse = EdgeCollapse{ EvaluateQuadric(quadrics[a], pPositions + b * 3), a, b };
+
+						if (!isLocked[b])
+						{
+							const auto cost = EvaluateQuadric(quadrics[b], pPositions + a * 3);
+							if (cost < collapse.m_Cost)
+								collapse = EdgeCollapse{ cost, b, a };
+						}
+
+						if (collapse.m_Cost <= maximumCost)
+							collapses.emplace_back(collapse);
+					}
+
+					std::sort(collapses.begin(), collapses.end(), [](const EdgeCollapse& lhs, const EdgeCollapse& rhs) { return lhs.m_Cost < rhs.m_Cost; });
+
+					// Perform the collapses until we reach the target.
+					std::iota(remapTable.begin(), remapTable.end(), 0);
+					std::fill(isDirty.begin(), isDirty.end(), false);
+
+					const auto trianglesToRemove = (result.size() - targetIndexCount) / 3;
+					uint64_t removedTriangles = 0;
+					uint64_t collapseCount = 0;
+
+					for (const auto& collapse : collapses)
+					{
+						if (removedTriangles >= trianglesToRemove)
+							break;
+
+						if (isDirty[collapse.m_Source] || isDirty[collapse.m_Destination])
+							continue;
+
+						if (CollapseFlipsTriangles(result, pPositions, adjacency, collapse.m_Source, collapse.m_Destination))
+							continue;
+
+						remapTable[collapse.m_Source] = collapse.m_Destination;
+						AddQuadric(quadrics[collapse.m_Destination], quadrics[collapse.m_Source]);
+						maximumError = std::max(maximumError, collapse.m_Cost);
+						collapseCount++;
+
+						// Mark the neighbours of both vertices as dirty, and count the triangles which are going to be removed.
+						for (const auto vertex : { collapse.m_Source, collapse.m_Destination })
+						{
+							for (uint32_t i = 0; i < adjacency.m_Counts[vertex]; i++)
+							{
+								const auto pTriangle = result.data() + adjacency.m_Triangles[adjacency.m_Offsets[vertex] + i] * 3;
+								isDirty[pTriangle[0]] = isDirty[pTriangle[1]] = isDirty[pTriangle[2]] = true;
+
+								if (vertex == collapse.m_Source && (pTriangle[0] == collapse.m_Destination || pTriangle[1] == collapse.m_Destination || pTriangle[2] == collapse.m_Destination))
+									removedTriangles++;
+							}
+						}
+					}
+
+					if (collapseCount == 0)
+						break;
+
+					// Remap the indices and remove the degenerate triangles.
+					uint64_t writeOffset = 0;
+					for (uint64_t i = 0; i < result.size(); i += 3)
+					{
+						const auto a = remapTable[result[i + 0]];
+						const auto b = remapTable[result[i + 1]];
+						const auto c = remapTable[result[i + 2]];
+
+						if (a == b || b == c || c == a)
+							continue;
+
+						result[writeOffset++] = a;
+						result[writeOffset++] = b;
+						result[writeOffset++] = c;
+					}
+
+					result.resize(writeOffset);
+				}
+
+				if (pResultError)
+					*pResultError = static_cast<float>(std::sqrt(maximumError));
+
+				return result;
+			}
+
+			float ProjectError(float error, float distance, float fieldOfView, uint32_t frameHeight)
+			{
+				// The error is visible as a whole if we are inside the bounds.
+				if (distance <= 0.0f)
+					return std::numeric_limits<float>::max();
+
+				const auto halfFieldOfView = fieldOfView * 0.5f * 3.14159265358979323846f / 180.0f;
+				return error * frameHeight / (2.0f * distance * std::tan(halfFieldOfView));
+			}
+
+			std::vector<Meshlet> BuildMeshlets(const std::vector<uint32_t>& indices, const float* pPositions, uint64_t vertexCount, uint32_t maxVertices /*= MaxMeshletVertices*/, uint32_t maxTriangles /*= MaxMeshletTriangles*/)
+			{
+				OPTICK_EVENT();
+
+				std::vector<Meshlet> meshlets;
+				if (indices.size() < 3)
+					return meshlets;
+
+				// This stores the meshlet which last used each vertex, so we can count the unique vertices of the current meshlet.
+				auto vertexOwners = std::vector<uint32_t>(vertexCount, InvalidIndex);
+				auto meshlet = Meshlet();
+
+				for (uint32_t t = 0; t < indices.size() / 3; t++)
+				{
+					const auto pTriangle = indices.data() + t * 3;
+					const auto owner = static_cast<uint32_t>(meshlets.size());
+					const auto newVertices = static_cast<uint32_t>(vertexOwners[pTriangle[0]] != owner) + static_cast<uint32_t>(vertexOwners[pTriangle[1]] != owner) + static_cast<uint32_t>(vertexOwners[pTriangle[2]] != owner);
+
+					// Start a new meshlet if the triangle does not fit in the current one.
+					if (meshlet.m_VertexCount + newVertices > maxVertices || meshlet.m_IndexCount / 3 >= maxTriangles)
+					{
+						ComputeMeshletBounds(meshlet, indices, pPositions);
+						meshlets.emplace_back(meshlet);
+
+						meshlet = Meshlet();
+						meshlet.m_IndexOffset = t * 3;
+					}
+
+					const auto currentOwner = static_cast<uint32_t>(meshlets.size());
+					for (uint8_t i = 0; i < 3; i++)
+					{
+						if (vertexOwners[pTriangle[i]] != currentOwner)
+						{
+							vertexOwners[pTriangle[i]] = currentOwner;
+							meshlet.m_VertexCount++;
+						}
+					}
+
+					meshlet.m_IndexCount += 3;
+				}
+
+				ComputeMeshletBounds(meshlet, indices, pPositions);
+				meshlets.emplace_back(meshlet);
+
+				return meshlets;
+			}
+		}
+	}
+}
\ No newline at end of file
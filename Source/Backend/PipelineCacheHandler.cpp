@@ -3,10 +3,178 @@
 
 #include "Flint/Backend/PipelineCacheHandler.hpp"
 #include "Flint/Core/Errors/AssetError.hpp"
+#include "Flint/Core/Containers/MappedFile.hpp"
 
 #include <Optick.h>
+#include <spdlog/spdlog.h>
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
 
 #include <fstream>
+#include <cstring>
+
+namespace /* anonymous */
+{
+	constexpr uint32_t StoreMagic = 0x53435046;	// FPCS (Flint Pipeline Cache Store).
+	constexpr uint32_t StoreVersion = 1;
+
+	/**
+	 * Store header structure.
+	 * This is the first thing in the store file, and is followed by the index entries.
+	 */
+	struct StoreHeader final
+	{
+		uint32_t m_Magic = StoreMagic;
+		uint32_t m_Version = StoreVersion;
+		uint64_t m_EntryCount = 0;
+	};
+
+	/**
+	 * Store index entry structure.
+	 */
+	struct StoreIndexEntry final
+	{
+		uint64_t m_Identifier = 0;
+		uint64_t m_Offset = 0;		// The offset of the data from the start of the file.
+		uint64_t m_Size = 0;
+		uint64_t m_Checksum = 0;	// The XXH64 hash of the data.
+	};
+
+	/**
+	 * Get the mutex which serializes writing the store files.
+	 * Stores which share a file read the current file before writing it, so two of them must not do that at the same time.
+	 *
+	 * @return The mutex.
+	 */
+	std::mutex& GetStoreFileMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	/**
+	 * Read the entries of a store file.
+	 * Entries which are out of bounds or whose checksum does not match are skipped.
+	 *
+	 * @param path The file path.
+	 * @return The entries.
+	 */
+	std::unordered_map<uint64_t, std::vector<std::byte>> ReadStoreFile(const std::filesystem::path& path)
+	{
+		OPTICK_EVENT();
+
+		std::unordered_map<uint64_t, std::vector<std::byte>> entries;
+		if (!std::filesystem::exists(path))
+			return entries;
+
+		// An unreadable file is treated as an empty store, since it's overwritten at the next write back.
+		Flint::MappedFile file;
+		try
+		{
+			file = Flint::MappedFile(path);
+		}
+		catch (const Flint::AssetError&)
+		{
+			return entries;
+		}
+
+		const auto pData = file.getData();
+		const auto size = file.getSize();
+		if (size < sizeof(StoreHeader))
+			return entries;
+
+		StoreHeader header = {};
+		std::memcpy(&header, pData, sizeof(StoreHeader));
+		if (header.m_Magic != StoreMagic || header.m_Version != StoreVersion || header.m_EntryCount > (size - sizeof(StoreHeader)) / sizeof(StoreIndexEntry))
+			return entries;
+
+		entries.reserve(header.m_EntryCount);
+		for (uint64_t i = 0; i < header.m_EntryCount; i++)
+		{
+			StoreIndexEntry entry = {};
+			std::memcpy(&entry, pData + sizeof(StoreHeader) + sizeof(StoreIndexEntry) * i, sizeof(StoreIndexEntry));
+
+			if (entry.m_Offset > size || entry.m_Size > size - entry.m_Offset)
+				continue;
+
+			if (static_cast<uint64_t>(XXH64(pData + entry.m_Offset, entry.m_Size, 0)) != entry.m_Checksum)
+				continue;
+
+			entries[entry.m_Identifier] = std::vector<std::byte>(pData + entry.m_Offset, pData + entry.m_Offset + entry.m_Size);
+		}
+
+		return entries;
+	}
+
+	/**
+	 * Write entries to a store file.
+	 * The entries are written to a temporary file which then replaces the store file, so the store file is either the old or the new one.
+	 *
+	 * @param path The file path.
+	 * @param entries The entries to write.
+	 */
+	void WriteStoreFile(const std::filesystem::path& path, const std::unordered_map<uint64_t, std::vector<std::byte>>& entries)
+	{
+		OPTICK_EVENT();
+
+		StoreHeader header = {};
+		header.m_EntryCount = entries.size();
+
+		std::vector<StoreIndexEntry> index;
+		index.reserve(entries.size());
+
+		uint64_t offset = sizeof(StoreHeader) + sizeof(StoreIndexEntry) * entries.size();
+		for (const auto& [identifier, bytes] : entries)
+		{
+			auto& entry = index.emplace_back();
+			entry.m_Identifier = identifier;
+			entry.m_Offset = offset;
+			entry.m_Size = bytes.size();
+			entry.m_Checksum = static_cast<uint64_t>(XXH64(bytes.data(), bytes.size(), 0));
+
+			offset += bytes.size();
+		}
+
+		auto temporaryPath = path;
+		temporaryPath += ".tmp";
+
+		bool isWritten = false;
+		{
+			std::fstream cacheFile(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!cacheFile.is_open())
+			{
+				spdlog::warn("Failed to open the pipeline cache store file {}!", temporaryPath.string());
+				return;
+			}
+
+			cacheFile.write(reinterpret_cast<const char*>(&header), sizeof(StoreHeader));
+			cacheFile.write(reinterpret_cast<const char*>(index.data()), sizeof(StoreIndexEntry) * index.size());
+
+			for (const auto& [identifier, bytes] : entries)
+				cacheFile.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+
+			cacheFile.flush();
+			isWritten = cacheFile.good();
+		}
+
+		// The store file is left untouched if the write or the rename fails, so we only need to clean up the temporary file.
+		std::error_code error;
+		if (!isWritten)
+		{
+			spdlog::warn("Failed to write the pipeline cache store file {}!", temporaryPath.string());
+			std::filesystem::remove(temporaryPath, error);
+			return;
+		}
+
+		std::filesystem::rename(temporaryPath, path, error);
+		if (error)
+		{
+			spdlog::warn("Failed to replace the pipeline cache store {}: {}", path.string(), error.message());
+			std::filesystem::remove(temporaryPath, error);
+		}
+	}
+}
 
 namespace Flint
 {
@@ -69,6 +237,91 @@ namespace Flint
 				cacheFile.close();
 				return buffer;
 			}
+
+			PipelineCacheStore::PipelineCacheStore(std::filesystem::path&& path, std::chrono::milliseconds writeBackInterval /*= std::chrono::seconds(30)*/)
+				: m_LastWriteBack(std::chrono::steady_clock::now()), m_CacheFilePath(std::move(path)), m_WriteBackInterval(writeBackInterval)
+			{
+				OPTICK_EVENT();
+
+				// Validate the path.
+				if (!m_CacheFilePath.has_filename())
+					throw AssetError("Invalid path provided! Make sure that the path leads to a file, not to a directory.");
+
+				// If the parent directory does not exist, let's make it.
+				if (m_CacheFilePath.has_parent_path() && !std::filesystem::exists(m_CacheFilePath.parent_path()))
+					std::filesystem::create_directories(m_CacheFilePath.parent_path());
+
+				m_Entries = ReadStoreFile(m_CacheFilePath);
+			}
+
+			PipelineCacheStore::~PipelineCacheStore()
+			{
+				writeBack();
+
+				if (m_WriteBack.valid())
+					m_WriteBack.wait();
+			}
+
+			void PipelineCacheStore::store(uint64_t identifier, const std::vector<std::byte>& bytes)
+			{
+				OPTICK_EVENT();
+
+				// Return if we don't have anything to save.
+				if (bytes.empty())
+					return;
+
+				bool shouldWriteBack = false;
+				{
+					[[maybe_unused]] const auto lock = std::scoped_lock(m_Mutex);
+					m_Entries[identifier] = bytes;
+					m_PendingEntries[identifier] = bytes;
+
+					shouldWriteBack = std::chrono::steady_clock::now() - m_LastWriteBack >= m_WriteBackInterval;
+				}
+
+				if (shouldWriteBack)
+					writeBack();
+			}
+
+			std::vector<std::byte> PipelineCacheStore::load(uint64_t identifier)
+			{
+				OPTICK_EVENT();
+
+				[[maybe_unused]] const auto lock = std::scoped_lock(m_Mutex);
+				if (const auto itr = m_Entries.find(identifier); itr != m_Entries.end())
+					return itr->second;
+
+				return {};
+			}
+
+			void PipelineCacheStore::writeBack()
+			{
+				OPTICK_EVENT();
+
+				[[maybe_unused]] const auto lock = std::scoped_lock(m_Mutex);
+				if (m_PendingEntries.empty())
+					return;
+
+				// Only one write back is done at a time, so the file always ends up with the latest data.
+				if (m_WriteBack.valid())
+					m_WriteBack.wait();
+
+				m_LastWriteBack = std::chrono::steady_clock::now();
+				m_WriteBack = std::async(std::launch::async, [path = m_CacheFilePath, entries = std::move(m_PendingEntries)]() mutable
+					{
+						[[maybe_unused]] const auto fileLock = std::scoped_lock(GetStoreFileMutex());
+
+						// Keep the entries which were stored by others sharing the file.
+						auto fileEntries = ReadStoreFile(path);
+						for (auto& [identifier, bytes] : entries)
+							fileEntries[identifier] = std::move(bytes);
+
+						WriteStoreFile(path, fileEntries);
+					}
+				);
+
+				m_PendingEntries.clear();
+			}
 		}
 	}
 }
\ No newline at end of file
@@ -4,10 +4,26 @@
 #include "Flint/Backend/RasterizingPipeline.hpp"
 #include "Flint/Core/Errors/InvalidArgumentError.hpp"
 
+#include <algorithm>
+
 namespace Flint
 {
 	namespace Backend
 	{
+		void RasterizingPipelineSpecification::setSpecialization(SpecializationConstant&& constant)
+		{
+			const auto itr = std::find_if(m_SpecializationConstants.begin(), m_SpecializationConstants.end(), [&constant](const SpecializationConstant& other)
+				{
+					return other.m_Name == constant.m_Name && (!constant.m_Name.empty() || other.m_ConstantID == constant.m_ConstantID);
+				}
+			);
+
+			if (itr != m_SpecializationConstants.end())
+				*itr = std::move(constant);
+			else
+				m_SpecializationConstants.emplace_back(std::move(constant));
+		}
+
 		RasterizingPipeline::RasterizingPipeline(const std::shared_ptr<Device>& pDevice, const std::shared_ptr<Rasterizer>& pRasterizer, const std::shared_ptr<RasterizingProgram>& pProgram, const RasterizingPipelineSpecification& specification, std::unique_ptr<PipelineCacheHandler>&& pCacheHandler /*= nullptr*/)
 			: Pipeline(pDevice, std::move(pCacheHandler)), m_pRasterizer(pRasterizer), m_pProgram(pProgram), m_Specification(specification)
 		{
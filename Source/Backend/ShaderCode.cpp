@@ -3,10 +3,14 @@
 
 #include "Flint/Backend/ShaderCode.hpp"
 #include "Flint/Core/Errors/AssetError.hpp"
+#include "Flint/Core/Containers/MappedFile.hpp"
 
 #include <Optick.h>
 
-#include <fstream>
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include <cstring>
 
 namespace Flint
 {
@@ -14,6 +18,7 @@ namespace Flint
 	{
 		ShaderCode::ShaderCode(std::vector<uint32_t>&& code)
 			: m_Code(std::move(code))
+			, m_Hash(static_cast<uint64_t>(XXH64(m_Code.data(), m_Code.size() * sizeof(uint32_t), 0)))
 		{
 
 		}
@@ -22,20 +27,18 @@ namespace Flint
 		{
 			OPTICK_EVENT();
 
-			// Load the shader code and perform reflection over it.
-			auto shaderSource = std::fstream(file, std::ios::binary | std::ios::in | std::ios::ate);
-
-			// Validate the shader file.
-			if (!shaderSource.is_open())
-				throw AssetError("Failed to load the shader file!");
+			// Map the shader file. This throws if the file could not be opened.
+			const auto shaderSource = MappedFile(file);
 
-			const auto shaderSize = shaderSource.tellg();
-			shaderSource.seekg(0);
+			// Validate the shader file. SPIR-V is a stream of 32-bit words.
+			if (shaderSource.isEmpty() || shaderSource.getSize() % sizeof(uint32_t) != 0)
+				throw AssetError("Invalid shader file! The shader code should be SPIR-V.");
 
 			// Load the shader's content.
-			m_Code.resize(shaderSize);
-			shaderSource.read(reinterpret_cast<char*>(m_Code.data()), shaderSize);
-			shaderSource.close();
+			m_Code.resize(shaderSource.getSize() / sizeof(uint32_t));
+			std::memcpy(m_Code.data(), shaderSource.getData(), shaderSource.getSize());
+
+			m_Hash = static_cast<uint64_t>(XXH64(m_Code.data(), shaderSource.getSize(), 0));
 		}
 	}
 }
\ No newline at end of file
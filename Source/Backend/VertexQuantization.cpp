@@ -0,0 +1,383 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Flint/Backend/VertexQuantization.hpp"
+
+#include <Optick.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLINT_VERTEX_QUANTIZATION_SSE2
+#include <emmintrin.h>
+
+#endif
+
+// GCC and Clang only enable F16C with -mf16c, while MSVC enables it with /arch:AVX2.
+#if defined(FLINT_VERTEX_QUANTIZATION_SSE2) && (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+#define FLINT_VERTEX_QUANTIZATION_F16C
+#include <immintrin.h>
+
+#endif
+
+namespace /* anonymous */
+{
+	/**
+	 * Write a value to a possibly unaligned destination.
+	 *
+	 * @param pDestination The destination pointer.
+	 * @param value The value to write.
+	 */
+	template<class Type>
+	void Store(std::byte* pDestination, const Type& value)
+	{
+		std::memcpy(pDestination, &value, sizeof(Type));
+	}
+
+	/**
+	 * Encode a single unit vector to octahedral 2x16-bit SNORM.
+	 *
+	 * @param pVector The vector pointer. This should contain 3 floats.
+	 * @return The encoded value. The lower 16 bits contain the x component.
+	 */
+	uint32_t EncodeOctahedralScalar(const float* pVector)
+	{
+		const auto l1Norm = std::abs(pVector[0]) + std::abs(pVector[1]) + std::abs(pVector[2]);
+		const auto inverse = l1Norm > 0.0f ? 1.0f / l1Norm : 0.0f;
+
+		auto x = pVector[0] * inverse;
+		auto y = pVector[1] * inverse;
+
+		// Fold the lower hemisphere over the diagonals.
+		if (pVector[2] < 0.0f)
+		{
+			const auto foldedX = (1.0f - std::abs(y)) * std::copysign(1.0f, x);
+			const auto foldedY = (1.0f - std::abs(x)) * std::copysign(1.0f, y);
+
+			x = foldedX;
+			y = foldedY;
+		}
+
+		const auto encodedX = static_cast<int32_t>(std::nearbyint(std::clamp(x, -1.0f, 1.0f) * 32767.0f));
+		const auto encodedY = static_cast<int32_t>(std::nearbyint(std::clamp(y, -1.0f, 1.0f) * 32767.0f));
+
+		return (static_cast<uint32_t>(encodedX) & 0xffff) | (static_cast<uint32_t>(encodedY) << 16);
+	}
+
+#ifndef FLINT_VERTEX_QUANTIZATION_SSE2
+	/**
+	 * Quantize a single value to 16-bit UNORM.
+	 *
+	 * @param value The value to quantize. This is clamped to [0, 1].
+	 * @return The quantized value.
+	 */
+	uint16_t QuantizeUnorm16(float value)
+	{
+		return static_cast<uint16_t>(std::nearbyint(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+	}
+
+	/**
+	 * Quantize a single value to 8-bit UNORM.
+	 *
+	 * @param value The value to quantize. This is clamped to [0, 1].
+	 * @return The quantized value.
+	 */
+	uint8_t QuantizeUnorm8(float value)
+	{
+		return static_cast<uint8_t>(std::nearbyint(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+	}
+
+#endif
+}
+
+namespace Flint
+{
+	namespace Backend
+	{
+		namespace VertexQuantization
+		{
+			void ComputeBounds(const float* pPositions, uint64_t count, std::array<float, 3>& minimum, std::array<float, 3>& maximum)
+			{
+				OPTICK_EVENT();
+
+				if (count == 0)
+				{
+					minimum = { 0.0f, 0.0f, 0.0f };
+					maximum = { 0.0f, 0.0f, 0.0f };
+					return;
+				}
+
+#ifdef FLINT_VERTEX_QUANTIZATION_SSE2
+				auto minimumVector = _mm_setr_ps(pPositions[0], pPositions[1], pPositions[2], 0.0f);
+				auto maximumVector = minimumVector;
+
+				for (uint64_t i = 1; i < count; i++)
+				{
+					const auto pPosition = pPositions + i * 3;
+					const auto position = _mm_setr_ps(pPosition[0], pPosition[1], pPosition[2], 0.0f);
+
+					minimumVector = _mm_min_ps(minimumVector, position);
+					maximumVector = _mm_max_ps(maximumVector, position);
+				}
+
+				alignas(16) float minimumValues[4];
+				alignas(16) float maximumValues[4];
+				_mm_store_ps(minimumValues, minimumVector);
+				_mm_store_ps(maximumValues, maximumVector);
+
+				minimum = { minimumValues[0], minimumValues[1], minimumValues[2] };
+				maximum = { maximumValues[0], maximumValues[1], maximumValues[2] };
+
+#else
+				minimum = { pPositions[0], pPositions[1], pPositions[2] };
+				maximum = minimum;
+
+				for (uint64_t i = 1; i < count; i++)
+				{
+					for (uint8_t c = 0; c < 3; c++)
+					{
+						minimum[c] = std::min(minimum[c], pPositions[i * 3 + c]);
+						maximum[c] = std::max(maximum[c], pPositions[i * 3 + c]);
+					}
+				}
+
+#endif
+			}
+
+			void QuantizePositions(const float* pPositions, uint64_t count, const std::array<float, 3>& minimum, const std::array<float, 3>& maximum, std::byte* pDestination, uint32_t stride)
+			{
+				OPTICK_EVENT();
+
+				// Compute the inverse extent. Flat axes are quantized to 0.
+				std::array<float, 3> inverseExtent = {};
+				for (uint8_t c = 0; c < 3; c++)
+				{
+					const auto extent = maximum[c] - minimum[c];
+					inverseExtent[c] = extent > 0.0f ? 1.0f / extent : 0.0f;
+				}
+
+#ifdef FLINT_VERTEX_QUANTIZATION_SSE2
+				const auto minimumVector = _mm_setr_ps(minimum[0], minimum[1], minimum[2], 0.0f);
+				const auto inverseExtentVector = _mm_setr_ps(inverseExtent[0], inverseExtent[1], inverseExtent[2], 0.0f);
+				const auto zero = _mm_setzero_ps();
+				const auto one = _mm_set1_ps(1.0f);
+				const auto scale = _mm_set1_ps(65535.0f);
+				const auto bias = _mm_set1_epi32(32768);
+				const auto signFlip = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+
+				for (uint64_t i = 0; i < count; i++)
+				{
+					const auto pPosition = pPositions + i * 3;
+					auto value = _mm_mul_ps(_mm_sub_ps(_mm_setr_ps(pPosition[0], pPosition[1], pPosition[2], 0.0f), minimumVector), inverseExtentVector);
+					value = _mm_mul_ps(_mm_min_ps(_mm_max_ps(value, zero), one), scale);
+
+					// SSE2 only has a signed 16-bit pack, so we bias the values to the signed range and flip the sign bits back afterwards.
+					const auto biased = _mm_sub_epi32(_mm_cvtps_epi32(value), bias);
+					const auto packed = _mm_xor_si128(_mm_packs_epi32(biased, biased), signFlip);
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(pDestination + i * stride), packed);
+				}
+
+#else
+				for (uint64_t i = 0; i < count; i++)
+				{
+					const auto pPosition = pPositions + i * 3;
+					const std::array<uint16_t, 4> quantized = {
+						QuantizeUnorm16((pPosition[0] - minimum[0]) * inverseExtent[0]),
+						QuantizeUnorm16((pPosition[1] - minimum[1]) * inverseExtent[1]),
+						QuantizeUnorm16((pPosition[2] - minimum[2]) * inverseExtent[2]),
+						0
+					};
+
+					Store(pDestination + i * stride, quantized);
+				}
+
+#endif
+			}
+
+			void EncodeOctahedral(const float* pVectors, uint64_t count, std::byte* pDestination, uint32_t stride)
+			{
+				OPTICK_EVENT();
+
+				uint64_t i = 0;
+
+#ifdef FLINT_VERTEX_QUANTIZATION_SSE2
+				const auto absoluteMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+				const auto signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int32_t>(0x80000000)));
+				const auto zero = _mm_setzero_ps();
+				const auto one = _mm_set1_ps(1.0f);
+				const auto minusOne = _mm_set1_ps(-1.0f);
+				const auto scale = _mm_set1_ps(32767.0f);
+				const auto lowMask = _mm_set1_epi32(0xffff);
+
+				// Encode 4 vectors at a time.
+				for (; i + 4 <= count; i += 4)
+				{
+					const auto pVector = pVectors + i * 3;
+					const auto x = _mm_setr_ps(pVector[0], pVector[3], pVector[6], pVector[9]);
+					const auto y = _mm_setr_ps(pVector[1], pVector[4], pVector[7], pVector[10]);
+					const auto z = _mm_setr_ps(pVector[2], pVector[5], pVector[8], pVector[11]);
+
+					// Project the vectors to the octahedron. Zero vectors stay zero.
+					const auto l1Norm = _mm_add_ps(_mm_add_ps(_mm_and_ps(x, absoluteMask), _mm_and_ps(y, absoluteMask)), _mm_and_ps(z, absoluteMask));
+					const auto inverse = _mm_and_ps(_mm_cmpgt_ps(l1Norm, zero), _mm_div_ps(one, l1Norm));
+					auto octahedralX = _mm_mul_ps(x, inverse);
+					auto octahedralY = _mm_mul_ps(y, inverse);
+
+					// Fold the lower hemisphere over the diagonals.
+					const auto foldedX = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(octahedralY, absoluteMask)), _mm_or_ps(_mm_and_ps(octahedralX, signMask), one));
+					const auto foldedY = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(octahedralX, absoluteMask)), _mm_or_ps(_mm_and_ps(octahedralY, signMask), one));
+					const auto lowerHemisphere = _mm_cmplt_ps(z, zero);
+					octahedralX = _mm_or_ps(_mm_and_ps(lowerHemisphere, foldedX), _mm_andnot_ps(lowerHemisphere, octahedralX));
+					octahedralY = _mm_or_ps(_mm_and_ps(lowerHemisphere, foldedY), _mm_andnot_ps(lowerHemisphere, octahedralY));
+
+					// Convert to SNORM and pack the two components together.
+					const auto encodedX = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(octahedralX, minusOne), one), scale));
+					const auto encodedY = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(octahedralY, minusOne), one), scale));
+					const auto packed = _mm_or_si128(_mm_and_si128(encodedX, lowMask), _mm_slli_epi32(encodedY, 16));
+
+					alignas(16) uint32_t results[4];
+					_mm_store_si128(reinterpret_cast<__m128i*>(results), packed);
+
+					for (uint8_t j = 0; j < 4; j++)
+						Store(pDestination + (i + j) * stride, results[j]);
+				}
+
+#endif
+
+				// Encode the remaining vectors.
+				for (; i < count; i++)
+					Store(pDestination + i * stride, EncodeOctahedralScalar(pVectors + i * 3));
+			}
+
+			void ConvertToHalf2(const float* pCoordinates, uint64_t count, uint32_t sourceComponents, std::byte* pDestination, uint32_t stride)
+			{
+				OPTICK_EVENT();
+
+				uint64_t i = 0;
+
+#ifdef FLINT_VERTEX_QUANTIZATION_F16C
+				// Convert 2 coordinates at a time.
+				for (; i + 2 <= count; i += 2)
+				{
+					const auto pFirst = pCoordinates + i * sourceComponents;
+					const auto pSecond = pFirst + sourceComponents;
+					const auto halfs = _mm_cvtps_ph(_mm_setr_ps(pFirst[0], pFirst[1], pSecond[0], pSecond[1]), _MM_FROUND_TO_NEAREST_INT);
+
+					Store(pDestination + i * stride, static_cast<uint32_t>(_mm_cvtsi128_si32(halfs)));
+					Store(pDestination + (i + 1) * stride, static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(halfs, 4))));
+				}
+
+#endif
+
+				// Convert the remaining coordinates.
+				for (; i < count; i++)
+				{
+					const auto pCoordinate = pCoordinates + i * sourceComponents;
+					const std::array<uint16_t, 2> halfs = { FloatToHalf(pCoordinate[0]), FloatToHalf(pCoordinate[1]) };
+
+					Store(pDestination + i * stride, halfs);
+				}
+			}
+
+			void ConvertToUnorm8x4(const float* pColors, uint64_t count, std::byte* pDestination, uint32_t stride)
+			{
+				OPTICK_EVENT();
+
+#ifdef FLINT_VERTEX_QUANTIZATION_SSE2
+				const auto zero = _mm_setzero_ps();
+				const auto one = _mm_set1_ps(1.0f);
+				const auto scale = _mm_set1_ps(255.0f);
+
+				for (uint64_t i = 0; i < count; i++)
+				{
+					const auto color = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(pColors + i * 4), zero), one), scale);
+					const auto words = _mm_packs_epi32(_mm_cvtps_epi32(color), _mm_setzero_si128());
+					const auto bytes = _mm_packus_epi16(words, words);
+
+					Store(pDestination + i * stride, static_cast<uint32_t>(_mm_cvtsi128_si32(bytes)));
+				}
+
+#else
+				for (uint64_t i = 0; i < count; i++)
+				{
+					const auto pColor = pColors + i * 4;
+					const std::array<uint8_t, 4> quantized = { QuantizeUnorm8(pColor[0]), QuantizeUnorm8(pColor[1]), QuantizeUnorm8(pColor[2]), QuantizeUnorm8(pColor[3]) };
+
+					Store(pDestination + i * stride, quantized);
+				}
+
+#endif
+			}
+
+			void NarrowIndices(const uint32_t* pIndices, uint64_t count, uint16_t* pDestination)
+			{
+				OPTICK_EVENT();
+
+				uint64_t i = 0;
+
+#ifdef FLINT_VERTEX_QUANTIZATION_SSE2
+				const auto bias = _mm_set1_epi32(32768);
+				const auto signFlip = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+
+				// Narrow 8 indices at a time. SSE2 only has a signed 16-bit pack, so we bias the values to the signed range and flip the sign bits back afterwards.
+				for (; i + 8 <= count; i += 8)
+				{
+					const auto first = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIndices + i)), bias);
+					const auto second = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIndices + i + 4)), bias);
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i), _mm_xor_si128(_mm_packs_epi32(first, second), signFlip));
+				}
+
+#endif
+
+				// Narrow the remaining indices.
+				for (; i < count; i++)
+					pDestination[i] = static_cast<uint16_t>(pIndices[i]);
+			}
+
+			uint16_t FloatToHalf(float value)
+			{
+				auto bits = std::bit_cast<uint32_t>(value);
+				const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+				bits &= 0x7fffffff;
+
+				// Infinity and NaN.
+				if (bits >= 0x7f800000)
+					return sign | 0x7c00 | (bits > 0x7f800000 ? 0x0200 : 0);
+
+				// Values which are too large are rounded to infinity.
+				if (bits >= 0x477ff000)
+					return sign | 0x7c00;
+
+				// Values which are too small for a normal half become subnormal (or zero).
+				if (bits < 0x38800000)
+				{
+					if (bits < 0x33000000)
+						return sign;
+
+					const auto shift = 126 - (bits >> 23);
+					const auto mantissa = (bits & 0x007fffff) | 0x00800000;
+					const auto remainder = mantissa & ((1u << shift) - 1);
+					const auto halfway = 1u << (shift - 1);
+
+					auto result = mantissa >> shift;
+					if (remainder > halfway || (remainder == halfway && (result & 1)))
+						result++;
+
+					return sign | static_cast<uint16_t>(result);
+				}
+
+				// Re-bias the exponent and round the mantissa to the nearest even value.
+				auto result = (bits - 0x38000000) >> 13;
+				const auto remainder = bits & 0x1fff;
+				if (remainder > 0x1000 || (remainder == 0x1000 && (result & 1)))
+					result++;
+
+				return sign | static_cast<uint16_t>(result);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Flint/Core/Containers/MappedFile.hpp"
+#include "Flint/Core/Errors/AssetError.hpp"
+
+#include <Optick.h>
+
+#include <utility>
+
+#ifdef FLINT_PLATFORM_WINDOWS
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <Windows.h>
+
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+
+#endif
+
+namespace Flint
+{
+	MappedFile::MappedFile(const std::filesystem::path& path)
+	{
+		OPTICK_EVENT();
+
+#ifdef FLINT_PLATFORM_WINDOWS
+		const auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			throw AssetError("Failed to open the file to map!");
+
+		LARGE_INTEGER size = {};
+		if (!GetFileSizeEx(file, &size))
+		{
+			CloseHandle(file);
+			throw AssetError("Failed to get the size of the file to map!");
+		}
+
+		m_Size = static_cast<uint64_t>(size.QuadPart);
+
+		// Empty files cannot be mapped.
+		if (m_Size > 0)
+		{
+			const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping)
+			{
+				m_pData = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				CloseHandle(mapping);
+			}
+		}
+
+		// The view keeps the file open, so we don't need the handle anymore.
+		CloseHandle(file);
+
+#else
+		const auto file = open(path.c_str(), O_RDONLY);
+		if (file == -1)
+			throw AssetError("Failed to open the file to map!");
+
+		struct stat status = {};
+		if (fstat(file, &status) == -1)
+		{
+			close(file);
+			throw AssetError("Failed to get the size of the file to map!");
+		}
+
+		m_Size = static_cast<uint64_t>(status.st_size);
+
+		// Empty files cannot be mapped.
+		if (m_Size > 0)
+		{
+			const auto pMemory = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, file, 0);
+			if (pMemory != MAP_FAILED)
+			{
+				m_pData = static_cast<const std::byte*>(pMemory);
+				madvise(pMemory, m_Size, MADV_SEQUENTIAL);
+			}
+		}
+
+		// The mapping keeps the file open, so we don't need the descriptor anymore.
+		close(file);
+
+#endif
+
+		if (m_Size > 0 && !m_pData)
+		{
+			m_Size = 0;
+			throw AssetError("Failed to map the file!");
+		}
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: m_pData(std::exchange(other.m_pData, nullptr))
+		, m_Size(std::exchange(other.m_Size, 0))
+	{
+	}
+
+	MappedFile::~MappedFile()
+	{
+		unmap();
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			unmap();
+
+			m_pData = std::exchange(other.m_pData, nullptr);
+			m_Size = std::exchange(other.m_Size, 0);
+		}
+
+		return *this;
+	}
+
+	void MappedFile::unmap()
+	{
+		if (!m_pData)
+			return;
+
+#ifdef FLINT_PLATFORM_WINDOWS
+		UnmapViewOfFile(m_pData);
+
+#else
+		munmap(const_cast<std::byte*>(m_pData), m_Size);
+
+#endif
+
+		m_pData = nullptr;
+		m_Size = 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,232 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Flint/VulkanBackend/VulkanBindlessDescriptor.hpp"
+#include "Flint/VulkanBackend/VulkanDevice.hpp"
+#include "Flint/VulkanBackend/VulkanMacros.hpp"
+
+#include <Optick.h>
+
+#include <algorithm>
+
+namespace /* anonymous */
+{
+	/**
+	 * The maximum number of sampled images in the bindless descriptor set.
+	 */
+	constexpr uint32_t MaxBindlessImages = 16384;
+
+	/**
+	 * The maximum number of samplers in the bindless descriptor set.
+	 */
+	constexpr uint32_t MaxBindlessSamplers = 1024;
+
+	/**
+	 * The maximum number of storage buffers in the bindless descriptor set.
+	 */
+	constexpr uint32_t MaxBindlessStorageBuffers = 16384;
+
+	/**
+	 * Get the descriptor type of a bindless resource type.
+	 *
+	 * @param type The resource type.
+	 * @return The Vulkan descriptor type.
+	 */
+	VkDescriptorType GetDescriptorType(Flint::Backend::BindlessResourceType type)
+	{
+		switch (type)
+		{
+		case Flint::Backend::BindlessResourceType::SampledImage:		return VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+		case Flint::Backend::BindlessResourceType::Sampler:				return VK_DESCRIPTOR_TYPE_SAMPLER;
+		case Flint::Backend::BindlessResourceType::StorageBuffer:		return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		default:														throw Flint::BackendError("Invalid bindless resource type!");
+		}
+	}
+}
+
+namespace Flint
+{
+	namespace Backend
+	{
+		VulkanBindlessDescriptor::VulkanBindlessDescriptor(VulkanDevice& device)
+			: m_Device(device)
+		{
+			OPTICK_EVENT();
+
+			// Get the descriptor indexing limits.
+			VkPhysicalDeviceDescriptorIndexingProperties indexingProperties = {};
+			indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+			indexingProperties.pNext = nullptr;
+
+			VkPhysicalDeviceProperties2 properties = {};
+			properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+			properties.pNext = &indexingProperties;
+			vkGetPhysicalDeviceProperties2(m_Device.getPhysicalDevice(), &properties);
+
+			// The sampled images and samplers are both limited by the per-stage resource limit, so we split it between them.
+			const auto maxStageResources = indexingProperties.maxPerStageUpdateAfterBindResources;
+			m_SlotArrays[EnumToInt(BindlessResourceType::SampledImage)].m_Capacity = std::min({ MaxBindlessImages, indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages, maxStageResources / 2 });
+			m_SlotArrays[EnumToInt(BindlessResourceType::Sampler)].m_Capacity = std::min({ MaxBindlessSamplers, indexingProperties.maxDescriptorSetUpdateAfterBindSamplers, maxStageResources / 4 });
+			m_SlotArrays[EnumToInt(BindlessResourceType::StorageBuffer)].m_Capacity = std::min({ MaxBindlessStorageBuffers, indexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers, maxStageResources / 4 });
+
+			// Setup the bindings and the pool sizes.
+			std::array<VkDescriptorSetLayoutBinding, EnumToInt(BindlessResourceType::Max)> layoutBindings = {};
+			std::array<VkDescriptorBindingFlags, EnumToInt(BindlessResourceType::Max)> bindingFlags = {};
+			std::array<VkDescriptorPoolSize, EnumToInt(BindlessResourceType::Max)> poolSizes = {};
+			for (uint8_t i = 0; i < EnumToInt(BindlessResourceType::Max); i++)
+			{
+				const auto descriptorType = GetDescriptorType(static_cast<BindlessResourceType>(i));
+
+				auto& binding = layoutBindings[i];
+				binding.binding = i;
+				binding.descriptorCount = m_SlotArrays[i].m_Capacity;
+				binding.descriptorType = descriptorType;
+				binding.pImmutableSamplers = nullptr;
+				binding.stageFlags = VK_SHADER_STAGE_ALL;
+
+				bindingFlags[i] = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+
+				poolSizes[i].type = descriptorType;
+				poolSizes[i].descriptorCount = m_SlotArrays[i].m_Capacity;
+			}
+
+			// Create the descriptor set layout.
+			VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsCreateInfo = {};
+			bindingFlagsCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+			bindingFlagsCreateInfo.pNext = nullptr;
+			bindingFlagsCreateInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+			bindingFlagsCreateInfo.pBindingFlags = bindingFlags.data();
+
+			VkDescriptorSetLayoutCreateInfo layoutCreateInfo = {};
+			layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+			layoutCreateInfo.pNext = &bindingFlagsCreateInfo;
+			layoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+			layoutCreateInfo.bindingCount = static_cast<uint32_t>(layoutBindings.size());
+			layoutCreateInfo.pBindings = layoutBindings.data();
+
+			FLINT_VK_ASSERT(m_Device.getDeviceTable().vkCreateDescriptorSetLayout(m_Device.getLogicalDevice(), &layoutCreateInfo, nullptr, &m_DescriptorSetLayout), "Failed to create the bindless descriptor set layout!");
+
+			// Create the descriptor pool.
+			VkDescriptorPoolCreateInfo poolCreateInfo = {};
+			poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+			poolCreateInfo.pNext = nullptr;
+			poolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+			poolCreateInfo.maxSets = 1;
+			poolCreateInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+			poolCreateInfo.pPoolSizes = poolSizes.data();
+
+			FLINT_VK_ASSERT(m_Device.getDeviceTable().vkCreateDescriptorPool(m_Device.getLogicalDevice(), &poolCreateInfo, nullptr, &m_DescriptorPool), "Failed to create the bindless descriptor pool!");
+
+			// Allocate the descriptor set.
+			VkDescriptorSetAllocateInfo allocateInfo = {};
+			allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+			allocateInfo.pNext = nullptr;
+			allocateInfo.descriptorPool = m_DescriptorPool;
+			allocateInfo.descriptorSetCount = 1;
+			allocateInfo.pSetLayouts = &m_DescriptorSetLayout;
+
+			FLINT_VK_ASSERT(m_Device.getDeviceTable().vkAllocateDescriptorSets(m_Device.getLogicalDevice(), &allocateInfo, &m_DescriptorSet), "Failed to allocate the bindless descriptor set!");
+		}
+
+		void VulkanBindlessDescriptor::destroy()
+		{
+			m_Device.getDeviceTable().vkDestroyDescriptorPool(m_Device.getLogicalDevice(), m_DescriptorPool, nullptr);
+			m_Device.getDeviceTable().vkDestroyDescriptorSetLayout(m_Device.getLogicalDevice(), m_DescriptorSetLayout, nullptr);
+
+			m_DescriptorPool = VK_NULL_HANDLE;
+			m_DescriptorSetLayout = VK_NULL_HANDLE;
+			m_DescriptorSet = VK_NULL_HANDLE;
+		}
+
+		uint32_t VulkanBindlessDescriptor::registerImage(VkImageView view, VkImageLayout layout)
+		{
+			OPTICK_EVENT();
+
+			VkDescriptorImageInfo imageInfo = {};
+			imageInfo.imageLayout = layout;
+			imageInfo.imageView = view;
+			imageInfo.sampler = VK_NULL_HANDLE;
+
+			[[maybe_unused]] const auto lock = std::scoped_lock(m_Mutex);
+			const auto index = acquireSlot(BindlessResourceType::SampledImage);
+			write(BindlessResourceType::SampledImage, index, &imageInfo, nullptr);
+
+			return index;
+		}
+
+		uint32_t VulkanBindlessDescriptor::registerSampler(VkSampler sampler)
+		{
+			OPTICK_EVENT();
+
+			VkDescriptorImageInfo imageInfo = {};
+			imageInfo.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			imageInfo.imageView = VK_NULL_HANDLE;
+			imageInfo.sampler = sampler;
+
+			[[maybe_unused]] const auto lock = std::scoped_lock(m_Mutex);
+			const auto index = acquireSlot(BindlessResourceType::Sampler);
+			write(BindlessResourceType::Sampler, index, &imageInfo, nullptr);
+
+			return index;
+		}
+
+		uint32_t VulkanBindlessDescriptor::registerStorageBuffer(VkBuffer buffer, uint64_t size)
+		{
+			OPTICK_EVENT();
+
+			VkDescriptorBufferInfo bufferInfo = {};
+			bufferInfo.buffer = buffer;
+			bufferInfo.offset = 0;
+			bufferInfo.range = size;
+
+			[[maybe_unused]] const auto lock = std::scoped_lock(m_Mutex);
+			const auto index = acquireSlot(BindlessResourceType::StorageBuffer);
+			write(BindlessResourceType::StorageBuffer, index, nullptr, &bufferInfo);
+
+			return index;
+		}
+
+		void VulkanBindlessDescriptor::release(BindlessResourceType type, uint32_t index)
+		{
+			OPTICK_EVENT();
+
+			[[maybe_unused]] const auto lock = std::scoped_lock(m_Mutex);
+			m_SlotArrays[EnumToInt(type)].m_FreeSlots.emplace_back(index);
+		}
+
+		uint32_t VulkanBindlessDescriptor::acquireSlot(BindlessResourceType type)
+		{
+			auto& slotArray = m_SlotArrays[EnumToInt(type)];
+
+			// Reuse a released slot if possible.
+			if (!slotArray.m_FreeSlots.empty())
+			{
+				const auto index = slotArray.m_FreeSlots.back();
+				slotArray.m_FreeSlots.pop_back();
+				return index;
+			}
+
+			if (slotArray.m_NextSlot >= slotArray.m_Capacity)
+				throw BackendError("The bindless descriptor array is full!");
+
+			return slotArray.m_NextSlot++;
+		}
+
+		void VulkanBindlessDescriptor::write(BindlessResourceType type, uint32_t index, const VkDescriptorImageInfo* pImageInfo, const VkDescriptorBufferInfo* pBufferInfo)
+		{
+			VkWriteDescriptorSet writeDescriptorSet = {};
+			writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writeDescriptorSet.pNext = nullptr;
+			writeDescriptorSet.dstSet = m_DescriptorSet;
+			writeDescriptorSet.dstBinding = EnumToInt(type);
+			writeDescriptorSet.dstArrayElement = index;
+			writeDescriptorSet.descriptorCount = 1;
+			writeDescriptorSet.descriptorType = GetDescriptorType(type);
+			writeDescriptorSet.pImageInfo = pImageInfo;
+			writeDescriptorSet.pBufferInfo = pBufferInfo;
+			writeDescriptorSet.pTexelBufferView = nullptr;
+
+			m_Device.getDeviceTable().vkUpdateDescriptorSets(m_Device.getLogicalDevice(), 1, &writeDescriptorSet, 0, nullptr);
+		}
+	}
+}
\ No newline at end of file
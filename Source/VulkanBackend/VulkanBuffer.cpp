@@ -50,6 +50,9 @@ namespace Flint
 			// Unmap if we have mapped.
 			unmapMemory();
 
+			if (m_BindlessIndex != InvalidBindlessIndex)
+				getDevice().as<VulkanDevice>()->getBindlessDescriptor()->release(BindlessResourceType::StorageBuffer, m_BindlessIndex);
+
 			[[maybe_unused]] const auto lock = std::scoped_lock(m_ResouceMutex);
 			getDevice().as<VulkanDevice>()->getAllocator().apply([this](VmaAllocator& allocator) { vmaDestroyBuffer(allocator, m_Buffer, m_Allocation); });
 			invalidate();
@@ -207,6 +210,12 @@ namespace Flint
 				memoryUsage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
 				break;
 
+			case BufferUsage::Indirect:
+				bufferUsage = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+				vmaFlags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+				memoryUsage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+				break;
+
 			case BufferUsage::Staging:
 				bufferUsage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 				vmaFlags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
@@ -217,6 +226,12 @@ namespace Flint
 				throw BackendError("Invalid buffer type!");
 			}
 
+			// Storage buffers can be written by the compute queue, so they are shared with the graphics queue if the two are in different families. This
+			// way we don't need to transfer the ownership between the queues.
+			const auto pVulkanDevice = getDevice().as<VulkanDevice>();
+			const uint32_t queueFamilies[] = { pVulkanDevice->getGraphicsQueue().getUnsafe().m_Family, pVulkanDevice->getComputeQueue().getUnsafe().m_Family };
+			const auto isShared = bufferUsage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT && pVulkanDevice->hasDedicatedComputeQueue();
+
 			// Create the buffer.
 			VkBufferCreateInfo createInfo = {};
 			createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -224,9 +239,9 @@ namespace Flint
 			createInfo.flags = 0;
 			createInfo.size = m_Size;
 			createInfo.usage = bufferUsage;
-			createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-			createInfo.queueFamilyIndexCount = 0;
-			createInfo.pQueueFamilyIndices = nullptr;
+			createInfo.sharingMode = isShared ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+			createInfo.queueFamilyIndexCount = isShared ? 2 : 0;
+			createInfo.pQueueFamilyIndices = isShared ? queueFamilies : nullptr;
 
 			VmaAllocationCreateInfo allocationCreateInfo = {};
 			allocationCreateInfo.flags = vmaFlags;
@@ -243,6 +258,10 @@ namespace Flint
 			m_DescriptorBufferInfo.offset = 0;
 			m_DescriptorBufferInfo.range = m_Size;
 
+			// Register storage buffers in the bindless descriptor if possible.
+			if (bufferUsage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT && getDevice().isBindlessSupported())
+				m_BindlessIndex = getDevice().as<VulkanDevice>()->getBindlessDescriptor()->registerStorageBuffer(m_Buffer, m_Size);
+
 			// Make sure to set the object as valid.
 			validate();
 		}
@@ -8,15 +8,25 @@
 #include "Flint/VulkanBackend/VulkanRasterizingPipeline.hpp"
 #include "Flint/VulkanBackend/VulkanRasterizingProgram.hpp"
 #include "Flint/VulkanBackend/VulkanRasterizingDrawEntry.hpp"
+#include "Flint/VulkanBackend/VulkanComputeProgram.hpp"
 #include "Flint/VulkanBackend/VulkanVertexStorage.hpp"
 
 #include <Optick.h>
 
+namespace /* anonymous */
+{
+	/**
+	 * The graphics pipeline stages which wait for the compute work.
+	 * Compute results are usually consumed as indirect commands, vertex data or shader resources.
+	 */
+	constexpr VkPipelineStageFlags ComputeResultStages = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+}
+
 namespace Flint
 {
 	namespace Backend
 	{
-		VulkanCommandBuffers::VulkanCommandBuffers(const std::shared_ptr<VulkanDevice>& pDevice, uint32_t bufferCount, VkCommandBufferLevel level /*= VK_COMMAND_BUFFER_LEVEL_PRIMARY*/)
+		VulkanCommandBuffers::VulkanCommandBuffers(const std::shared_ptr<VulkanDevice>& pDevice, uint32_t bufferCount, VkCommandBufferLevel level /*= VK_COMMAND_BUFFER_LEVEL_PRIMARY*/, VkQueueFlagBits queue /*= VK_QUEUE_GRAPHICS_BIT*/)
 			: CommandBuffers(pDevice, bufferCount)
 		{
 			OPTICK_EVENT();
@@ -26,7 +36,24 @@ namespace Flint
 			commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
 			commandPoolCreateInfo.pNext = nullptr;
 			commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-			commandPoolCreateInfo.queueFamilyIndex = getDevice().as<VulkanDevice>()->getGraphicsQueue().getUnsafe().m_Family;
+
+			switch (queue)
+			{
+			case VK_QUEUE_GRAPHICS_BIT:
+				commandPoolCreateInfo.queueFamilyIndex = getDevice().as<VulkanDevice>()->getGraphicsQueue().getUnsafe().m_Family;
+				break;
+
+			case VK_QUEUE_COMPUTE_BIT:
+				commandPoolCreateInfo.queueFamilyIndex = getDevice().as<VulkanDevice>()->getComputeQueue().getUnsafe().m_Family;
+				break;
+
+			case VK_QUEUE_TRANSFER_BIT:
+				commandPoolCreateInfo.queueFamilyIndex = getDevice().as<VulkanDevice>()->getTransferQueue().getUnsafe().m_Family;
+				break;
+
+			default:
+				throw BackendError("Invalid command buffer queue!");
+			}
 
 			FLINT_VK_ASSERT(getDevice().as<VulkanDevice>()->getDeviceTable().vkCreateCommandPool(getDevice().as<VulkanDevice>()->getLogicalDevice(), &commandPoolCreateInfo, nullptr, &m_CommandPool), "Failed to create the command pool!");
 
@@ -418,6 +445,28 @@ namespace Flint
 			);
 		}
 
+		void VulkanCommandBuffers::setViewport(const VkViewport& viewport) const noexcept
+		{
+			OPTICK_EVENT();
+
+			m_CurrentCommandBuffer.apply([this, &viewport](VkCommandBuffer commandBuffer)
+				{
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+				}
+			);
+		}
+
+		void VulkanCommandBuffers::setScissor(const VkRect2D& scissor) const noexcept
+		{
+			OPTICK_EVENT();
+
+			m_CurrentCommandBuffer.apply([this, &scissor](VkCommandBuffer commandBuffer)
+				{
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+				}
+			);
+		}
+
 		void VulkanCommandBuffers::bindVertexBuffers(const VulkanVertexStorage& vertexStorage, const std::vector<VertexInput>& inputs) const noexcept
 		{
 			OPTICK_EVENT();
@@ -425,13 +474,24 @@ namespace Flint
 			std::vector<VkBuffer> buffers;
 			buffers.reserve(inputs.size());
 
-			for (const auto& input : inputs)
+			// If the data are interleaved, all the attributes are in a single buffer.
+			if (vertexStorage.getMemoryType() == VertexMemoryType::Interleaved)
 			{
-				const auto& pBuffer = vertexStorage.getBuffer(input.m_Attribute);
+				const auto& pBuffer = vertexStorage.getBuffer(VertexAttribute::Position);
 
 				if (pBuffer)
 					buffers.emplace_back(pBuffer->getBuffer());
 			}
+			else
+			{
+				for (const auto& input : inputs)
+				{
+					const auto& pBuffer = vertexStorage.getBuffer(input.m_Attribute);
+
+					if (pBuffer)
+						buffers.emplace_back(pBuffer->getBuffer());
+				}
+			}
 
 			m_CurrentCommandBuffer.apply([this, &buffers](VkCommandBuffer commandBuffer)
 				{
@@ -441,35 +501,176 @@ namespace Flint
 			);
 		}
 
-		void VulkanCommandBuffers::bindIndexBuffer(const VkBuffer buffer) const noexcept
+		void VulkanCommandBuffers::bindIndexBuffer(const VkBuffer buffer, IndexType indexType /*= IndexType::Uint32*/) const noexcept
 		{
 			OPTICK_EVENT();
 
-			m_CurrentCommandBuffer.apply([this, buffer](VkCommandBuffer commandBuffer)
+			m_CurrentCommandBuffer.apply([this, buffer, indexType](VkCommandBuffer commandBuffer)
 				{
-					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdBindIndexBuffer(commandBuffer, buffer, 0, VK_INDEX_TYPE_UINT32);
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdBindIndexBuffer(commandBuffer, buffer, 0, indexType == IndexType::Uint16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
 				}
 			);
 		}
 
-		void VulkanCommandBuffers::drawIndexed(uint64_t indexCount, uint64_t indexOffset, uint64_t instanceCount, uint64_t vertexOffset) const noexcept
+		void VulkanCommandBuffers::drawIndexed(uint64_t indexCount, uint64_t indexOffset, uint64_t instanceCount, uint64_t vertexOffset, uint64_t firstInstance /*= 0*/) const noexcept
 		{
 			OPTICK_EVENT();
 
-			m_CurrentCommandBuffer.apply([this, indexCount, indexOffset, instanceCount, vertexOffset](VkCommandBuffer commandBuffer)
+			m_CurrentCommandBuffer.apply([this, indexCount, indexOffset, instanceCount, vertexOffset, firstInstance](VkCommandBuffer commandBuffer)
 				{
-					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(indexCount), static_cast<uint32_t>(instanceCount), static_cast<uint32_t>(indexOffset), static_cast<int32_t>(vertexOffset), 0);
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(indexCount), static_cast<uint32_t>(instanceCount), static_cast<uint32_t>(indexOffset), static_cast<int32_t>(vertexOffset), static_cast<uint32_t>(firstInstance));
 				}
 			);
 		}
 
-		void VulkanCommandBuffers::bindDescriptor(const VulkanRasterizingPipeline* pPipeline, VkDescriptorSet descriptorSet) const noexcept
+		void VulkanCommandBuffers::drawIndexedIndirect(const VkBuffer buffer, uint64_t offset, uint64_t drawCount) const noexcept
 		{
 			OPTICK_EVENT();
 
-			m_CurrentCommandBuffer.apply([this, pPipeline, descriptorSet](VkCommandBuffer commandBuffer)
+			m_CurrentCommandBuffer.apply([this, buffer, offset, drawCount](VkCommandBuffer commandBuffer)
 				{
-					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pPipeline->getProgram()->as<VulkanRasterizingProgram>()->getPipelineLayout(), 0, 1, &descriptorSet, 0, nullptr);
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdDrawIndexedIndirect(commandBuffer, buffer, offset, static_cast<uint32_t>(drawCount), sizeof(VkDrawIndexedIndirectCommand));
+				}
+			);
+		}
+
+		void VulkanCommandBuffers::drawIndexedIndirectCount(const VkBuffer buffer, uint64_t offset, const VkBuffer countBuffer, uint64_t countOffset, uint64_t maxDrawCount) const noexcept
+		{
+			OPTICK_EVENT();
+
+			m_CurrentCommandBuffer.apply([this, buffer, offset, countBuffer, countOffset, maxDrawCount](VkCommandBuffer commandBuffer)
+				{
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdDrawIndexedIndirectCountKHR(commandBuffer, buffer, offset, countBuffer, countOffset, static_cast<uint32_t>(maxDrawCount), sizeof(VkDrawIndexedIndirectCommand));
+				}
+			);
+		}
+
+		void VulkanCommandBuffers::bindDescriptor(const VulkanRasterizingPipeline* pPipeline, VkDescriptorSet descriptorSet, const std::vector<uint32_t>& dynamicOffsets /*= {}*/) const noexcept
+		{
+			OPTICK_EVENT();
+
+			m_CurrentCommandBuffer.apply([this, pPipeline, descriptorSet, &dynamicOffsets](VkCommandBuffer commandBuffer)
+				{
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pPipeline->getProgram()->as<VulkanRasterizingProgram>()->getPipelineLayout(), 0, 1, &descriptorSet, static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+				}
+			);
+		}
+
+		void VulkanCommandBuffers::bindBindlessDescriptor(const VulkanRasterizingPipeline* pPipeline) const noexcept
+		{
+			OPTICK_EVENT();
+
+			m_CurrentCommandBuffer.apply([this, pPipeline](VkCommandBuffer commandBuffer)
+				{
+					const auto descriptorSet = getDevice().as<VulkanDevice>()->getBindlessDescriptor()->getDescriptorSet();
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pPipeline->getProgram()->as<VulkanRasterizingProgram>()->getPipelineLayout(), BindlessDescriptorSet, 1, &descriptorSet, 0, nullptr);
+				}
+			);
+		}
+
+		void VulkanCommandBuffers::pushConstants(const VulkanRasterizingPipeline* pPipeline, const std::byte* pData, uint32_t size, uint32_t offset /*= 0*/) const noexcept
+		{
+			OPTICK_EVENT();
+
+			m_CurrentCommandBuffer.apply([this, pPipeline, pData, size, offset](VkCommandBuffer commandBuffer)
+				{
+					const auto pProgram = pPipeline->getProgram()->as<VulkanRasterizingProgram>();
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdPushConstants(commandBuffer, pProgram->getPipelineLayout(), pProgram->getPushConstantStageFlags(), offset, size, pData);
+				}
+			);
+		}
+
+		void VulkanCommandBuffers::bindComputePipeline(VkPipeline pipeline) const noexcept
+		{
+			OPTICK_EVENT();
+
+			m_CurrentCommandBuffer.apply([this, pipeline](VkCommandBuffer commandBuffer)
+				{
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+				}
+			);
+		}
+
+		void VulkanCommandBuffers::bindComputeDescriptor(const VulkanComputeProgram* pProgram, VkDescriptorSet descriptorSet, const std::vector<uint32_t>& dynamicOffsets /*= {}*/) const noexcept
+		{
+			OPTICK_EVENT();
+
+			m_CurrentCommandBuffer.apply([this, pProgram, descriptorSet, &dynamicOffsets](VkCommandBuffer commandBuffer)
+				{
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pProgram->getPipelineLayout(), 0, 1, &descriptorSet, static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+				}
+			);
+		}
+
+		void VulkanCommandBuffers::bindComputeBindlessDescriptor(const VulkanComputeProgram* pProgram) const noexcept
+		{
+			OPTICK_EVENT();
+
+			m_CurrentCommandBuffer.apply([this, pProgram](VkCommandBuffer commandBuffer)
+				{
+					const auto descriptorSet = getDevice().as<VulkanDevice>()->getBindlessDescriptor()->getDescriptorSet();
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pProgram->getPipelineLayout(), BindlessDescriptorSet, 1, &descriptorSet, 0, nullptr);
+				}
+			);
+		}
+
+		void VulkanCommandBuffers::pushComputeConstants(const VulkanComputeProgram* pProgram, const std::byte* pData, uint32_t size, uint32_t offset /*= 0*/) const noexcept
+		{
+			OPTICK_EVENT();
+
+			m_CurrentCommandBuffer.apply([this, pProgram, pData, size, offset](VkCommandBuffer commandBuffer)
+				{
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdPushConstants(commandBuffer, pProgram->getPipelineLayout(), pProgram->getPushConstantStageFlags(), offset, size, pData);
+				}
+			);
+		}
+
+		void VulkanCommandBuffers::dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) const noexcept
+		{
+			OPTICK_EVENT();
+
+			m_CurrentCommandBuffer.apply([this, groupCountX, groupCountY, groupCountZ](VkCommandBuffer commandBuffer)
+				{
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+				}
+			);
+		}
+
+		void VulkanCommandBuffers::dispatchIndirect(const VkBuffer buffer, uint64_t offset) const noexcept
+		{
+			OPTICK_EVENT();
+
+			m_CurrentCommandBuffer.apply([this, buffer, offset](VkCommandBuffer commandBuffer)
+				{
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdDispatchIndirect(commandBuffer, buffer, offset);
+				}
+			);
+		}
+
+		void VulkanCommandBuffers::fillBuffer(const VkBuffer buffer, uint64_t offset, uint64_t size, uint32_t data) const noexcept
+		{
+			OPTICK_EVENT();
+
+			m_CurrentCommandBuffer.apply([this, buffer, offset, size, data](VkCommandBuffer commandBuffer)
+				{
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdFillBuffer(commandBuffer, buffer, offset, size, data);
+				}
+			);
+		}
+
+		void VulkanCommandBuffers::memoryBarrier(VkPipelineStageFlags srcStageMask, VkAccessFlags srcAccessMask, VkPipelineStageFlags dstStageMask, VkAccessFlags dstAccessMask) const noexcept
+		{
+			OPTICK_EVENT();
+
+			VkMemoryBarrier memoryBarrier = {};
+			memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			memoryBarrier.pNext = nullptr;
+			memoryBarrier.srcAccessMask = srcAccessMask;
+			memoryBarrier.dstAccessMask = dstAccessMask;
+
+			m_CurrentCommandBuffer.apply([this, srcStageMask, dstStageMask, &memoryBarrier](VkCommandBuffer commandBuffer)
+				{
+					getDevice().as<VulkanDevice>()->getDeviceTable().vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
 				}
 			);
 		}
@@ -502,14 +703,32 @@ namespace Flint
 		{
 			OPTICK_EVENT();
 
+			auto pVulkanDevice = getDevice().as<VulkanDevice>();
+
+			// Wait for the compute work which was submitted before this. The binary semaphores ignore the values.
+			const VkSemaphore waitSemaphores[] = { inFlightSemaphore, pVulkanDevice->getComputeSemaphore() };
+			const VkPipelineStageFlags waitStageMasks[] = { waitStageMask, ComputeResultStages };
+			const uint64_t waitValues[] = { 0, pVulkanDevice->getComputeSignalValue() };
+			const uint64_t signalValue = 0;
+			const uint32_t waitCount = waitValues[1] > 0 ? 2 : 1;
+
+			VkTimelineSemaphoreSubmitInfo timelineSubmitInfo = {};
+			timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+			timelineSubmitInfo.pNext = nullptr;
+			timelineSubmitInfo.waitSemaphoreValueCount = waitCount;
+			timelineSubmitInfo.pWaitSemaphoreValues = waitValues;
+			timelineSubmitInfo.signalSemaphoreValueCount = 1;
+			timelineSubmitInfo.pSignalSemaphoreValues = &signalValue;
+
 			// Create the submit info structure.
 			VkSubmitInfo submitInfo = {};
 			submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-			submitInfo.waitSemaphoreCount = 1;
-			submitInfo.pWaitSemaphores = &inFlightSemaphore;
+			submitInfo.pNext = &timelineSubmitInfo;
+			submitInfo.waitSemaphoreCount = waitCount;
+			submitInfo.pWaitSemaphores = waitSemaphores;
 			submitInfo.commandBufferCount = 1;
 			submitInfo.pCommandBuffers = m_CurrentCommandBuffer.pointerUnsafe();
-			submitInfo.pWaitDstStageMask = &waitStageMask;
+			submitInfo.pWaitDstStageMask = waitStageMasks;
 			submitInfo.signalSemaphoreCount = 1;
 			submitInfo.pSignalSemaphores = &renderFinishedSemaphore;
 
@@ -517,7 +736,6 @@ namespace Flint
 			auto& fence = m_CommandFences[m_CurrentIndex];
 			fence.m_IsFree = false;
 
-			auto pVulkanDevice = getDevice().as<VulkanDevice>();
 			pVulkanDevice->getGraphicsQueue().apply([this, pVulkanDevice, submitInfo, fence](VulkanQueue& queue)
 				{
 					FLINT_VK_ASSERT(pVulkanDevice->getDeviceTable().vkQueueSubmit(queue.m_Queue, 1, &submitInfo, fence.m_Fence), "Failed to submit the queue!");
@@ -529,14 +747,30 @@ namespace Flint
 		{
 			OPTICK_EVENT();
 
+			auto pVulkanDevice = getDevice().as<VulkanDevice>();
+
+			// Wait for the compute work which was submitted before this.
+			const auto computeSemaphore = pVulkanDevice->getComputeSemaphore();
+			const auto waitValue = pVulkanDevice->getComputeSignalValue();
+			const VkPipelineStageFlags computeWaitStageMask = ComputeResultStages;
+
+			VkTimelineSemaphoreSubmitInfo timelineSubmitInfo = {};
+			timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+			timelineSubmitInfo.pNext = nullptr;
+			timelineSubmitInfo.waitSemaphoreValueCount = 1;
+			timelineSubmitInfo.pWaitSemaphoreValues = &waitValue;
+			timelineSubmitInfo.signalSemaphoreValueCount = 0;
+			timelineSubmitInfo.pSignalSemaphoreValues = nullptr;
+
 			// Create the submit info structure.
 			VkSubmitInfo submitInfo = {};
 			submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-			submitInfo.waitSemaphoreCount = 0;
-			submitInfo.pWaitSemaphores = nullptr;
+			submitInfo.pNext = waitValue > 0 ? &timelineSubmitInfo : nullptr;
+			submitInfo.waitSemaphoreCount = waitValue > 0 ? 1 : 0;
+			submitInfo.pWaitSemaphores = waitValue > 0 ? &computeSemaphore : nullptr;
 			submitInfo.commandBufferCount = 1;
 			submitInfo.pCommandBuffers = m_CurrentCommandBuffer.pointerUnsafe();
-			submitInfo.pWaitDstStageMask = &waitStageMask;
+			submitInfo.pWaitDstStageMask = waitValue > 0 ? &computeWaitStageMask : &waitStageMask;
 			submitInfo.signalSemaphoreCount = 0;
 			submitInfo.pSignalSemaphores = nullptr;
 
@@ -544,7 +778,6 @@ namespace Flint
 			auto& fence = m_CommandFences[m_CurrentIndex];
 			fence.m_IsFree = false;
 
-			auto pVulkanDevice = getDevice().as<VulkanDevice>();
 			pVulkanDevice->getGraphicsQueue().apply([this, pVulkanDevice, submitInfo, fence](VulkanQueue& queue)
 				{
 					FLINT_VK_ASSERT(pVulkanDevice->getDeviceTable().vkQueueSubmit(queue.m_Queue, 1, &submitInfo, fence.m_Fence), "Failed to submit the queue!");
@@ -586,25 +819,40 @@ namespace Flint
 			OPTICK_EVENT();
 
 			const VkPipelineStageFlags waitStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+			auto pVulkanDevice = getDevice().as<VulkanDevice>();
+
+			// Signal the compute semaphore so the graphics submissions can wait for this.
+			const auto computeSemaphore = pVulkanDevice->getComputeSemaphore();
+
+			VkTimelineSemaphoreSubmitInfo timelineSubmitInfo = {};
+			timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+			timelineSubmitInfo.pNext = nullptr;
+			timelineSubmitInfo.waitSemaphoreValueCount = 0;
+			timelineSubmitInfo.pWaitSemaphoreValues = nullptr;
+			timelineSubmitInfo.signalSemaphoreValueCount = 1;
 
 			// Create the submit info structure.
 			VkSubmitInfo submitInfo = {};
 			submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			submitInfo.pNext = &timelineSubmitInfo;
 			submitInfo.waitSemaphoreCount = 0;
 			submitInfo.pWaitSemaphores = nullptr;
 			submitInfo.commandBufferCount = 1;
 			submitInfo.pCommandBuffers = m_CurrentCommandBuffer.pointerUnsafe();
 			submitInfo.pWaitDstStageMask = &waitStageMask;
-			submitInfo.signalSemaphoreCount = 0;
-			submitInfo.pSignalSemaphores = nullptr;
+			submitInfo.signalSemaphoreCount = 1;
+			submitInfo.pSignalSemaphores = &computeSemaphore;
 
 			// Submit the queue.
 			auto& fence = m_CommandFences[m_CurrentIndex];
 			fence.m_IsFree = false;
 
-			auto pVulkanDevice = getDevice().as<VulkanDevice>();
-			pVulkanDevice->getComputeQueue().apply([this, pVulkanDevice, submitInfo, fence](VulkanQueue& queue)
+			// The signal value is acquired while the queue is locked, so the values are signaled in order.
+			pVulkanDevice->getComputeQueue().apply([this, pVulkanDevice, &timelineSubmitInfo, &submitInfo, fence](VulkanQueue& queue)
 				{
+					const auto signalValue = pVulkanDevice->acquireComputeSignalValue();
+					timelineSubmitInfo.pSignalSemaphoreValues = &signalValue;
+
 					FLINT_VK_ASSERT(pVulkanDevice->getDeviceTable().vkQueueSubmit(queue.m_Queue, 1, &submitInfo, fence.m_Fence), "Failed to submit the queue!");
 				}
 			);
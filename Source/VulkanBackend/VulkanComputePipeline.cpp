@@ -0,0 +1,218 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Flint/VulkanBackend/VulkanComputePipeline.hpp"
+#include "Flint/VulkanBackend/VulkanComputeProgram.hpp"
+#include "Flint/VulkanBackend/VulkanCommandBuffers.hpp"
+#include "Flint/VulkanBackend/VulkanBuffer.hpp"
+#include "Flint/VulkanBackend/VulkanMacros.hpp"
+
+#include <Optick.h>
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+namespace Flint
+{
+	namespace Backend
+	{
+		VulkanComputePipeline::VulkanComputePipeline(const std::shared_ptr<VulkanDevice>& pDevice, const std::shared_ptr<VulkanComputeProgram>& pProgram, std::unique_ptr<PipelineCacheHandler>&& pCacheHandler /*= nullptr*/)
+			: ComputePipeline(pDevice, pProgram, std::move(pCacheHandler))
+			, m_DescriptorSetManager(pDevice, 1)
+			, m_pCommandBuffers(std::make_unique<VulkanCommandBuffers>(pDevice, CommandBufferCount, VK_COMMAND_BUFFER_LEVEL_PRIMARY, VK_QUEUE_COMPUTE_BIT))
+		{
+			OPTICK_EVENT();
+
+			// Setup the descriptor set manager.
+			m_DescriptorSetManager.setup(pProgram->getLayoutBindings(), pProgram->getPoolSizes(), pProgram->getDescriptorSetLayout(), pProgram->getDescriptorUpdateTemplate(), pProgram->getTemplateBindings());
+
+			// The pipeline cache is identified by the shader code, since that's the only thing that changes the pipeline.
+			m_Identifier = pProgram->getComputeShader().getHash();
+
+			// Create the pipeline.
+			createPipeline();
+
+			// Make sure to set the object as valid.
+			validate();
+		}
+
+		VulkanComputePipeline::~VulkanComputePipeline()
+		{
+			FLINT_TERMINATE_IF_VALID;
+		}
+
+		void VulkanComputePipeline::terminate()
+		{
+			OPTICK_EVENT();
+
+			// Wait till all the dispatches are done.
+			for (uint32_t i = 0; i < CommandBufferCount; i++)
+			{
+				m_pCommandBuffers->finishExecution();
+				m_pCommandBuffers->next();
+			}
+
+			m_pCommandBuffers->terminate();
+
+			saveCache(m_Identifier, m_PipelineCache);
+			getDevice().as<VulkanDevice>()->getDeviceTable().vkDestroyPipeline(getDevice().as<VulkanDevice>()->getLogicalDevice(), m_Pipeline, nullptr);
+			getDevice().as<VulkanDevice>()->getDeviceTable().vkDestroyPipelineCache(getDevice().as<VulkanDevice>()->getLogicalDevice(), m_PipelineCache, nullptr);
+
+			m_DescriptorSetManager.destroy();
+			invalidate();
+		}
+
+		uint64_t VulkanComputePipeline::registerTable(const MeshBindingTable& table)
+		{
+			OPTICK_EVENT();
+
+			auto lock = std::scoped_lock(m_Mutex);
+
+			Table entry;
+			entry.m_Constants = table.getConstants();
+
+			// Only register the resources if the program has any bindings.
+			if (!getProgram()->as<VulkanComputeProgram>()->getLayoutBindings().empty())
+			{
+				entry.m_ResourceHash = m_DescriptorSetManager.registerTable(table);
+				entry.m_DynamicOffsets = m_DescriptorSetManager.getDynamicOffsets(table);
+			}
+
+			// The dynamic offsets and the constants are not a part of the descriptor set, so they are hashed on top of the resource hash.
+			auto hash = static_cast<uint64_t>(XXH64(entry.m_DynamicOffsets.data(), entry.m_DynamicOffsets.size() * sizeof(uint32_t), entry.m_ResourceHash));
+			hash = static_cast<uint64_t>(XXH64(entry.m_Constants.data(), entry.m_Constants.size(), hash));
+
+			m_Tables.try_emplace(hash, std::move(entry));
+			return hash;
+		}
+
+		void VulkanComputePipeline::dispatch(uint64_t table, uint32_t groupCountX, uint32_t groupCountY /*= 1*/, uint32_t groupCountZ /*= 1*/)
+		{
+			OPTICK_EVENT();
+
+			auto lock = std::scoped_lock(m_Mutex);
+
+			m_pCommandBuffers->finishExecution();
+			m_pCommandBuffers->begin();
+
+			bind(*m_pCommandBuffers, table);
+			m_pCommandBuffers->dispatch(groupCountX, groupCountY, groupCountZ);
+
+			m_pCommandBuffers->end();
+			m_pCommandBuffers->submitCompute();
+			m_pCommandBuffers->next();
+		}
+
+		void VulkanComputePipeline::dispatchIndirect(uint64_t table, const std::shared_ptr<Buffer>& pBuffer, uint64_t offset /*= 0*/)
+		{
+			OPTICK_EVENT();
+
+			if (!(pBuffer->getUsage() & BufferUsage::Indirect))
+				throw BackendError("The dispatch buffer must be an indirect buffer!");
+
+			auto lock = std::scoped_lock(m_Mutex);
+
+			m_pCommandBuffers->finishExecution();
+			m_pCommandBuffers->begin();
+
+			bind(*m_pCommandBuffers, table);
+			m_pCommandBuffers->dispatchIndirect(pBuffer->as<VulkanBuffer>()->getBuffer(), offset);
+
+			m_pCommandBuffers->end();
+			m_pCommandBuffers->submitCompute();
+			m_pCommandBuffers->next();
+		}
+
+		void VulkanComputePipeline::bind(const VulkanCommandBuffers& commandBuffers, uint64_t table) const
+		{
+			OPTICK_EVENT();
+
+			const auto itr = m_Tables.find(table);
+			if (itr == m_Tables.end())
+				throw BackendError("The table is not registered to the pipeline!");
+
+			const auto pProgram = getProgram()->as<VulkanComputeProgram>();
+			commandBuffers.bindComputePipeline(m_Pipeline);
+
+			if (!pProgram->getLayoutBindings().empty())
+				commandBuffers.bindComputeDescriptor(pProgram, m_DescriptorSetManager.getDescriptorSet(itr->second.m_ResourceHash, 0), itr->second.m_DynamicOffsets);
+
+			if (pProgram->usesBindless())
+				commandBuffers.bindComputeBindlessDescriptor(pProgram);
+
+			if (const auto range = pProgram->getPushConstantRange(itr->second.m_Constants.size()); range.size > 0)
+				commandBuffers.pushComputeConstants(pProgram, itr->second.m_Constants.data() + range.offset, range.size, range.offset);
+		}
+
+		VkPipelineCache VulkanComputePipeline::loadCache(uint64_t identifier) const
+		{
+			OPTICK_EVENT();
+
+			std::vector<std::byte> buffer;
+
+			// Load the cache if possible. Data created by another device or driver version are discarded.
+			if (m_pCacheHandler)
+				buffer = m_pCacheHandler->load(identifier);
+
+			if (!getDevicePointerAs<VulkanDevice>()->isPipelineCacheCompatible(buffer))
+				buffer.clear();
+
+			// Create the pipeline cache.
+			VkPipelineCacheCreateInfo createInfo = {};
+			createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+			createInfo.pNext = VK_NULL_HANDLE;
+			createInfo.flags = 0;
+			createInfo.initialDataSize = buffer.size();
+			createInfo.pInitialData = buffer.data();
+
+			VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+			FLINT_VK_ASSERT(getDevicePointerAs<VulkanDevice>()->getDeviceTable().vkCreatePipelineCache(getDevicePointerAs<VulkanDevice>()->getLogicalDevice(), &createInfo, nullptr, &pipelineCache), "Failed to create the pipeline cache!");
+
+			return pipelineCache;
+		}
+
+		void VulkanComputePipeline::saveCache(uint64_t identifier, VkPipelineCache cache) const
+		{
+			OPTICK_EVENT();
+
+			// Return if we don't have anything to save.
+			if (cache == VK_NULL_HANDLE)
+				return;
+
+			// Load cache data.
+			size_t cacheSize = 0;
+			FLINT_VK_ASSERT(getDevicePointerAs<VulkanDevice>()->getDeviceTable().vkGetPipelineCacheData(getDevicePointerAs<VulkanDevice>()->getLogicalDevice(), cache, &cacheSize, nullptr), "Failed to get the pipeline cache size!");
+
+			auto buffer = std::vector<std::byte>(cacheSize);
+			FLINT_VK_ASSERT(getDevicePointerAs<VulkanDevice>()->getDeviceTable().vkGetPipelineCacheData(getDevicePointerAs<VulkanDevice>()->getLogicalDevice(), cache, &cacheSize, buffer.data()), "Failed to get the pipeline cache data!");
+
+			// Store the cache if possible.
+			if (m_pCacheHandler)
+				m_pCacheHandler->store(identifier, buffer);
+		}
+
+		void VulkanComputePipeline::createPipeline()
+		{
+			OPTICK_EVENT();
+
+			const auto pProgram = getProgram()->as<VulkanComputeProgram>();
+
+			m_PipelineCache = loadCache(m_Identifier);
+
+			// Create the pipeline.
+			VkComputePipelineCreateInfo createInfo = {};
+			createInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+			createInfo.pNext = nullptr;
+			createInfo.flags = 0;
+			createInfo.stage = pProgram->getPipelineShaderStageCreateInfos().front();
+			createInfo.layout = pProgram->getPipelineLayout();
+			createInfo.basePipelineHandle = VK_NULL_HANDLE;
+			createInfo.basePipelineIndex = 0;
+
+			FLINT_VK_ASSERT(getDevice().as<VulkanDevice>()->getDeviceTable().vkCreateComputePipelines(getDevice().as<VulkanDevice>()->getLogicalDevice(), m_PipelineCache, 1, &createInfo, nullptr, &m_Pipeline), "Failed to create the compute pipeline!");
+
+			// Save the cache so a crash later on does not lose it.
+			saveCache(m_Identifier, m_PipelineCache);
+		}
+	}
+}
\ No newline at end of file
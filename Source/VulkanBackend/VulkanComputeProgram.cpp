@@ -0,0 +1,44 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Flint/VulkanBackend/VulkanComputeProgram.hpp"
+#include "Flint/VulkanBackend/VulkanMacros.hpp"
+
+#include <Optick.h>
+
+namespace Flint
+{
+	namespace Backend
+	{
+		VulkanComputeProgram::VulkanComputeProgram(const std::shared_ptr<VulkanDevice>& pDevice, ShaderCode&& computeShader)
+			: ComputeProgram(pDevice, std::move(computeShader)), VulkanProgramLayout(*pDevice)
+		{
+			OPTICK_EVENT();
+
+			// Create the shader module.
+			if (m_ComputeShader.empty())
+				throw BackendError("The compute shader is empty!");
+
+			m_WorkGroupSize = createShaderModule(m_ComputeShader, VK_SHADER_STAGE_COMPUTE_BIT, m_BindingMap).m_WorkGroupSize;
+
+			// Create the descriptor set layout and the pipeline layout.
+			createLayout(m_BindingMap);
+
+			// Make sure to set the object as valid.
+			validate();
+		}
+
+		VulkanComputeProgram::~VulkanComputeProgram()
+		{
+			FLINT_TERMINATE_IF_VALID;
+		}
+
+		void VulkanComputeProgram::terminate()
+		{
+			OPTICK_EVENT();
+
+			destroyLayout();
+			invalidate();
+		}
+	}
+}
\ No newline at end of file
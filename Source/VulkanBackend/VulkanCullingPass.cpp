@@ -0,0 +1,580 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Flint/VulkanBackend/VulkanCullingPass.hpp"
+#include "Flint/VulkanBackend/VulkanRasterizingPipeline.hpp"
+#include "Flint/VulkanBackend/VulkanRasterizer.hpp"
+#include "Flint/VulkanBackend/VulkanComputeProgram.hpp"
+#include "Flint/VulkanBackend/VulkanCommandBuffers.hpp"
+#include "Flint/VulkanBackend/VulkanBuffer.hpp"
+#include "Flint/VulkanBackend/VulkanMacros.hpp"
+
+#include <Optick.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace /* anonymous */
+{
+	/**
+	 * Culling bindings enum.
+	 * These are the bindings of the culling shader.
+	 */
+	enum class CullingBinding : uint32_t
+	{
+		View,
+		Items,
+		SourceCommands,
+		SourceDrawData,
+		CulledCommands,
+		CulledDrawData,
+		Counts,
+		DepthPyramid
+	};
+
+	/**
+	 * Depth pyramid bindings enum.
+	 * These are the bindings of the depth pyramid reduction shader.
+	 */
+	enum class DepthPyramidBinding : uint32_t
+	{
+		Input,
+		Output
+	};
+
+	/**
+	 * Get the number of work groups required to cover a number of invocations.
+	 *
+	 * @param count The number of invocations.
+	 * @param groupSize The work group size.
+	 * @return The work group count.
+	 */
+	uint32_t GetGroupCount(uint32_t count, uint32_t groupSize)
+	{
+		return (count + groupSize - 1) / groupSize;
+	}
+
+	/**
+	 * Check if a descriptor type is a dynamic buffer type.
+	 *
+	 * @param type The descriptor type.
+	 * @return Whether or not the type is dynamic.
+	 */
+	bool IsDynamicBuffer(VkDescriptorType type)
+	{
+		return type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC || type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+	}
+
+	/**
+	 * Normalize a plane so that it's normal is a unit vector.
+	 *
+	 * @param plane The plane to normalize.
+	 * @return The normalized plane.
+	 */
+	glm::vec4 NormalizePlane(const glm::vec4& plane)
+	{
+		return plane / glm::length(glm::vec3(plane));
+	}
+}
+
+namespace Flint
+{
+	namespace Backend
+	{
+		VulkanCullingPass::VulkanCullingPass(VulkanRasterizingPipeline& pipeline, const std::shared_ptr<VulkanComputeProgram>& pCullingProgram, const std::shared_ptr<VulkanComputeProgram>& pDepthPyramidProgram)
+			: m_Frames(pipeline.getRasterizer()->getFrameCount())
+			, m_Pipeline(pipeline)
+			, m_Device(*pipeline.getDevice().as<VulkanDevice>())
+			, m_pCullingProgram(pCullingProgram)
+			, m_pDepthPyramidProgram(pDepthPyramidProgram)
+		{
+			OPTICK_EVENT();
+
+			const auto pRasterizer = pipeline.getRasterizer()->as<VulkanRasterizer>();
+
+			// Occlusion culling needs a depth attachment which can be sampled directly.
+			m_SupportsOcclusion = pRasterizer->getDepthAttachment(0) && pRasterizer->getMultisample() == Multisample::One;
+
+			// Create the pipelines.
+			m_CullingPipeline = createPipeline(m_pCullingProgram.get());
+			m_DepthPyramidPipeline = createPipeline(m_pDepthPyramidProgram.get());
+
+			// Create the sampler. The shaders fetch the texels directly, so the sampler only needs to keep the coordinates within the image.
+			VkSamplerCreateInfo samplerCreateInfo = {};
+			samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+			samplerCreateInfo.flags = 0;
+			samplerCreateInfo.pNext = nullptr;
+			samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+			samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+			samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+			samplerCreateInfo.anisotropyEnable = VK_FALSE;
+			samplerCreateInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+			samplerCreateInfo.compareEnable = VK_FALSE;
+			samplerCreateInfo.magFilter = VK_FILTER_NEAREST;
+			samplerCreateInfo.minFilter = VK_FILTER_NEAREST;
+			samplerCreateInfo.maxLod = VK_LOD_CLAMP_NONE;
+			samplerCreateInfo.minLod = 0.0f;
+			samplerCreateInfo.mipLodBias = 0.0f;
+			samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+			samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+
+			FLINT_VK_ASSERT(m_Device.getDeviceTable().vkCreateSampler(m_Device.getLogicalDevice(), &samplerCreateInfo, nullptr, &m_Sampler), "Failed to create the sampler!");
+
+			// The program layout may promote the culling buffers to dynamic buffers. Every dynamic binding needs an offset when binding, and the
+			// buffers are written from their beginning, so all the offsets are zero.
+			for (const auto& binding : m_pCullingProgram->getLayoutBindings())
+			{
+				if (IsDynamicBuffer(binding.descriptorType))
+					m_CullingDynamicOffsets.emplace_back(0);
+			}
+
+			// Allocate the culling descriptor sets.
+			m_CullingDescriptorPool = createDescriptorPool(m_pCullingProgram.get(), static_cast<uint32_t>(m_Frames.size()));
+			const auto descriptorSets = allocateDescriptorSets(m_pCullingProgram.get(), m_CullingDescriptorPool, static_cast<uint32_t>(m_Frames.size()));
+			for (uint64_t i = 0; i < m_Frames.size(); i++)
+			{
+				m_Frames[i].m_CullingDescriptorSet = descriptorSets[i];
+				m_Frames[i].m_pViewBuffer = std::static_pointer_cast<VulkanBuffer>(m_Device.createBuffer(sizeof(CullingView), BufferUsage::Uniform));
+			}
+
+			// Create the depth pyramid.
+			createPyramid();
+		}
+
+		VulkanCullingPass::~VulkanCullingPass()
+		{
+			destroy();
+		}
+
+		void VulkanCullingPass::destroy()
+		{
+			OPTICK_EVENT();
+
+			if (m_CullingPipeline == VK_NULL_HANDLE)
+				return;
+
+			destroyPyramid();
+
+			for (auto& frame : m_Frames)
+			{
+				for (const auto& pBuffer : { frame.m_pViewBuffer, frame.m_pItemBuffer, frame.m_pCommandBuffer, frame.m_pDrawDataBuffer, frame.m_pCountBuffer })
+				{
+					if (pBuffer)
+						pBuffer->terminate();
+				}
+			}
+
+			m_Frames.clear();
+
+			m_Device.getDeviceTable().vkDestroyDescriptorPool(m_Device.getLogicalDevice(), m_CullingDescriptorPool, nullptr);
+			m_Device.getDeviceTable().vkDestroySampler(m_Device.getLogicalDevice(), m_Sampler, nullptr);
+			m_Device.getDeviceTable().vkDestroyPipeline(m_Device.getLogicalDevice(), m_CullingPipeline, nullptr);
+			m_Device.getDeviceTable().vkDestroyPipeline(m_Device.getLogicalDevice(), m_DepthPyramidPipeline, nullptr);
+
+			m_CullingPipeline = VK_NULL_HANDLE;
+			m_DepthPyramidPipeline = VK_NULL_HANDLE;
+		}
+
+		void VulkanCullingPass::recreatePyramid()
+		{
+			OPTICK_EVENT();
+
+			destroyPyramid();
+			createPyramid();
+
+			// The culling descriptor sets point to the old pyramid.
+			for (uint32_t i = 0; i < m_Frames.size(); i++)
+			{
+				if (m_Frames[i].m_ItemCount > 0)
+					writeCullingDescriptorSet(i);
+			}
+		}
+
+		void VulkanCullingPass::update(uint32_t frameIndex, const std::vector<CullingItem>& items, uint32_t batchCount, const VulkanBuffer* pCommandBuffer, const VulkanBuffer* pDrawDataBuffer)
+		{
+			OPTICK_EVENT();
+
+			auto& frame = m_Frames[frameIndex];
+			frame.m_ItemCount = static_cast<uint32_t>(items.size());
+			frame.m_BatchCount = batchCount;
+			frame.m_pSourceCommandBuffer = pCommandBuffer;
+			frame.m_pSourceDrawDataBuffer = pDrawDataBuffer;
+
+			if (items.empty())
+				return;
+
+			// The buffers are only recreated if they are too small.
+			const auto reserveBuffer = [this](std::shared_ptr<VulkanBuffer>& pBuffer, uint64_t size, BufferUsage usage)
+			{
+				if (pBuffer && pBuffer->getSize() >= size)
+					return;
+
+				if (pBuffer)
+					pBuffer->terminate();
+
+				pBuffer = std::static_pointer_cast<VulkanBuffer>(m_Device.createBuffer(size, usage));
+			};
+
+			reserveBuffer(frame.m_pItemBuffer, items.size() * sizeof(CullingItem), BufferUsage::Storage);
+			reserveBuffer(frame.m_pCommandBuffer, items.size() * sizeof(VkDrawIndexedIndirectCommand), BufferUsage::Indirect);
+			reserveBuffer(frame.m_pDrawDataBuffer, items.size() * sizeof(IndirectDrawData), BufferUsage::Indirect);
+			reserveBuffer(frame.m_pCountBuffer, batchCount * sizeof(uint32_t), BufferUsage::Indirect);
+
+			frame.m_pItemBuffer->copyFrom(reinterpret_cast<const std::byte*>(items.data()), items.size() * sizeof(CullingItem));
+
+			writeCullingDescriptorSet(frameIndex);
+		}
+
+		void VulkanCullingPass::setView(const glm::mat4& view, const glm::mat4& projection)
+		{
+			m_View.m_View = view;
+			m_View.m_Projection = projection;
+
+			// Extract the world space planes from the rows of the view projection matrix. GLM matrices are column major, so we transpose it first.
+			const auto matrix = glm::transpose(projection * view);
+			m_View.m_FrustumPlanes[0] = NormalizePlane(matrix[3] + matrix[0]);	// Left.
+			m_View.m_FrustumPlanes[1] = NormalizePlane(matrix[3] - matrix[0]);	// Right.
+			m_View.m_FrustumPlanes[2] = NormalizePlane(matrix[3] + matrix[1]);	// Bottom.
+			m_View.m_FrustumPlanes[3] = NormalizePlane(matrix[3] - matrix[1]);	// Top.
+			m_View.m_FrustumPlanes[4] = NormalizePlane(matrix[3] + matrix[2]);	// Near.
+			m_View.m_FrustumPlanes[5] = NormalizePlane(matrix[3] - matrix[2]);	// Far.
+		}
+
+		void VulkanCullingPass::uploadView(uint32_t frameIndex)
+		{
+			OPTICK_EVENT();
+
+			const auto& frame = m_Frames[frameIndex];
+
+			auto view = m_View;
+			view.m_PyramidSize = glm::vec2(static_cast<float>(m_PyramidWidth), static_cast<float>(m_PyramidHeight));
+			view.m_ItemCount = frame.m_ItemCount;
+
+			// The pyramid is built from the previous frame's depth, so there is nothing to test against in the first frame after it was created.
+			view.m_EnableOcclusion = m_SupportsOcclusion && m_HasPyramid;
+			m_HasPyramid = true;
+
+			frame.m_pViewBuffer->copyFrom(reinterpret_cast<const std::byte*>(&view), sizeof(CullingView));
+		}
+
+		void VulkanCullingPass::cull(const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex) const
+		{
+			OPTICK_EVENT();
+
+			const auto& frame = m_Frames[frameIndex];
+			if (frame.m_ItemCount == 0)
+				return;
+
+			// Reset the draw counts. The barrier also makes the previous frame's depth pyramid visible to the culling shader.
+			commandBuffers.fillBuffer(frame.m_pCountBuffer->getBuffer(), 0, frame.m_BatchCount * sizeof(uint32_t), 0);
+			commandBuffers.memoryBarrier(
+				VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+				VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+			commandBuffers.bindComputePipeline(m_CullingPipeline);
+			commandBuffers.bindComputeDescriptor(m_pCullingProgram.get(), frame.m_CullingDescriptorSet, m_CullingDynamicOffsets);
+			commandBuffers.dispatch(GetGroupCount(frame.m_ItemCount, m_pCullingProgram->getWorkGroupSize()[0]), 1, 1);
+
+			// The culled commands and draw data are consumed by the draws.
+			commandBuffers.memoryBarrier(
+				VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+				VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT);
+		}
+
+		void VulkanCullingPass::buildDepthPyramid(const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex) const
+		{
+			OPTICK_EVENT();
+
+			if (!m_SupportsOcclusion)
+				return;
+
+			// Wait till the depth is written, and till the culling shader is done reading the pyramid.
+			commandBuffers.memoryBarrier(
+				VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+				VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+			commandBuffers.bindComputePipeline(m_DepthPyramidPipeline);
+
+			const auto& workGroupSize = m_pDepthPyramidProgram->getWorkGroupSize();
+			const auto& descriptorSets = m_Frames[frameIndex].m_PyramidDescriptorSets;
+			for (uint32_t level = 0; level < descriptorSets.size(); level++)
+			{
+				const auto width = std::max(m_PyramidWidth >> level, 1u);
+				const auto height = std::max(m_PyramidHeight >> level, 1u);
+
+				commandBuffers.bindComputeDescriptor(m_pDepthPyramidProgram.get(), descriptorSets[level]);
+				commandBuffers.dispatch(GetGroupCount(width, workGroupSize[0]), GetGroupCount(height, workGroupSize[1]), 1);
+
+				// The next level reads this one.
+				commandBuffers.memoryBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+			}
+		}
+
+		VkPipeline VulkanCullingPass::createPipeline(const VulkanComputeProgram* pProgram) const
+		{
+			OPTICK_EVENT();
+
+			VkComputePipelineCreateInfo createInfo = {};
+			createInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+			createInfo.pNext = nullptr;
+			createInfo.flags = 0;
+			createInfo.stage = pProgram->getPipelineShaderStageCreateInfos().front();
+			createInfo.layout = pProgram->getPipelineLayout();
+			createInfo.basePipelineHandle = VK_NULL_HANDLE;
+			createInfo.basePipelineIndex = 0;
+
+			// The pipelines are stored in the rasterizing pipeline's cache, which is saved with it.
+			VkPipeline pipeline = VK_NULL_HANDLE;
+			FLINT_VK_ASSERT(m_Device.getDeviceTable().vkCreateComputePipelines(m_Device.getLogicalDevice(), m_Pipeline.getPipelineCache(), 1, &createInfo, nullptr, &pipeline), "Failed to create the compute pipeline!");
+
+			return pipeline;
+		}
+
+		VkDescriptorPool VulkanCullingPass::createDescriptorPool(const VulkanComputeProgram* pProgram, uint32_t setCount) const
+		{
+			OPTICK_EVENT();
+
+			// The pool should be able to hold the descriptors of all of its sets.
+			auto poolSizes = pProgram->getPoolSizes();
+			for (auto& poolSize : poolSizes)
+				poolSize.descriptorCount *= setCount;
+
+			VkDescriptorPoolCreateInfo createInfo = {};
+			createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+			createInfo.pNext = nullptr;
+			createInfo.flags = 0;
+			createInfo.maxSets = setCount;
+			createInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+			createInfo.pPoolSizes = poolSizes.data();
+
+			VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+			FLINT_VK_ASSERT(m_Device.getDeviceTable().vkCreateDescriptorPool(m_Device.getLogicalDevice(), &createInfo, nullptr, &descriptorPool), "Failed to create the descriptor pool!");
+
+			return descriptorPool;
+		}
+
+		std::vector<VkDescriptorSet> VulkanCullingPass::allocateDescriptorSets(const VulkanComputeProgram* pProgram, VkDescriptorPool pool, uint32_t count) const
+		{
+			OPTICK_EVENT();
+
+			std::vector<VkDescriptorSet> descriptorSets(count);
+			const std::vector<VkDescriptorSetLayout> layouts(count, pProgram->getDescriptorSetLayout());
+
+			VkDescriptorSetAllocateInfo allocateInfo = {};
+			allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+			allocateInfo.pNext = nullptr;
+			allocateInfo.descriptorPool = pool;
+			allocateInfo.descriptorSetCount = count;
+			allocateInfo.pSetLayouts = layouts.data();
+
+			FLINT_VK_ASSERT(m_Device.getDeviceTable().vkAllocateDescriptorSets(m_Device.getLogicalDevice(), &allocateInfo, descriptorSets.data()), "Failed to allocate descriptor set!");
+			return descriptorSets;
+		}
+
+		void VulkanCullingPass::createPyramid()
+		{
+			OPTICK_EVENT();
+
+			const auto pRasterizer = m_Pipeline.getRasterizer()->as<VulkanRasterizer>();
+
+			// The first level is half the size of the depth attachment, and every other level is half the size of the previous one.
+			m_PyramidWidth = std::max(pRasterizer->getWidth() / 2, 1u);
+			m_PyramidHeight = std::max(pRasterizer->getHeight() / 2, 1u);
+			m_HasPyramid = false;
+
+			const auto levelCount = static_cast<uint32_t>(std::bit_width(std::max(m_PyramidWidth, m_PyramidHeight)));
+
+			// Create the image.
+			VkImageCreateInfo imageCreateInfo = {};
+			imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+			imageCreateInfo.flags = 0;
+			imageCreateInfo.pNext = nullptr;
+			imageCreateInfo.extent.width = m_PyramidWidth;
+			imageCreateInfo.extent.height = m_PyramidHeight;
+			imageCreateInfo.extent.depth = 1;
+			imageCreateInfo.format = VK_FORMAT_R32_SFLOAT;
+			imageCreateInfo.arrayLayers = 1;
+			imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+			imageCreateInfo.queueFamilyIndexCount = 0;
+			imageCreateInfo.pQueueFamilyIndices = nullptr;
+			imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+			imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+			imageCreateInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+			imageCreateInfo.mipLevels = levelCount;
+
+			VmaAllocationCreateInfo allocationCreateInfo = {};
+			allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+			m_Device.getAllocator().apply([this, imageCreateInfo, allocationCreateInfo](VmaAllocator& allocator)
+				{
+					FLINT_VK_ASSERT(vmaCreateImage(allocator, &imageCreateInfo, &allocationCreateInfo, &m_PyramidImage, &m_PyramidAllocation, nullptr), "Failed to create the image!");
+				}
+			);
+
+			// Create the views. The culling shader uses the view which contains all the levels, and the reduction shader uses one view per level.
+			VkImageViewCreateInfo imageViewCreateInfo = {};
+			imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+			imageViewCreateInfo.pNext = nullptr;
+			imageViewCreateInfo.flags = 0;
+			imageViewCreateInfo.image = m_PyramidImage;
+			imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+			imageViewCreateInfo.format = VK_FORMAT_R32_SFLOAT;
+			imageViewCreateInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+			imageViewCreateInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+			imageViewCreateInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+			imageViewCreateInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+			imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
+			imageViewCreateInfo.subresourceRange.levelCount = levelCount;
+			imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+			imageViewCreateInfo.subresourceRange.layerCount = 1;
+
+			FLINT_VK_ASSERT(m_Device.getDeviceTable().vkCreateImageView(m_Device.getLogicalDevice(), &imageViewCreateInfo, nullptr, &m_PyramidView), "Failed to create the image view!");
+
+			m_PyramidLevelViews.resize(levelCount);
+			imageViewCreateInfo.subresourceRange.levelCount = 1;
+			for (uint32_t level = 0; level < levelCount; level++)
+			{
+				imageViewCreateInfo.subresourceRange.baseMipLevel = level;
+				FLINT_VK_ASSERT(m_Device.getDeviceTable().vkCreateImageView(m_Device.getLogicalDevice(), &imageViewCreateInfo, nullptr, &m_PyramidLevelViews[level]), "Failed to create the image view!");
+			}
+
+			// The pyramid stays in the general layout, since it's both written and sampled.
+			auto commandBuffers = VulkanCommandBuffers(m_Device.shared_from_this());
+			commandBuffers.begin();
+			commandBuffers.changeImageLayout(m_PyramidImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_ASPECT_COLOR_BIT, levelCount);
+			commandBuffers.end();
+			commandBuffers.submitGraphics();
+			commandBuffers.finishExecution();
+
+			// We don't need the reduction descriptors if the pyramid is never built.
+			if (!m_SupportsOcclusion)
+				return;
+
+			const auto frameCount = static_cast<uint32_t>(m_Frames.size());
+			m_PyramidDescriptorPool = createDescriptorPool(m_pDepthPyramidProgram.get(), frameCount * levelCount);
+			const auto descriptorSets = allocateDescriptorSets(m_pDepthPyramidProgram.get(), m_PyramidDescriptorPool, frameCount * levelCount);
+
+			// Each level reads the previous level, and the first level reads the frame's depth attachment.
+			std::vector<VkDescriptorImageInfo> imageInfos;
+			std::vector<VkWriteDescriptorSet> writes;
+			imageInfos.reserve(descriptorSets.size() * 2);
+			writes.reserve(descriptorSets.size() * 2);
+
+			for (uint32_t i = 0; i < frameCount; i++)
+			{
+				auto& frame = m_Frames[i];
+				frame.m_PyramidDescriptorSets.assign(descriptorSets.begin() + i * levelCount, descriptorSets.begin() + (i + 1) * levelCount);
+
+				for (uint32_t level = 0; level < levelCount; level++)
+				{
+					auto& inputInfo = imageInfos.emplace_back();
+					inputInfo.sampler = m_Sampler;
+					inputInfo.imageView = level == 0 ? pRasterizer->getDepthAttachment(i)->getImageView() : m_PyramidLevelViews[level - 1];
+					inputInfo.imageLayout = level == 0 ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
+
+					auto& outputInfo = imageInfos.emplace_back();
+					outputInfo.sampler = VK_NULL_HANDLE;
+					outputInfo.imageView = m_PyramidLevelViews[level];
+					outputInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+					for (const auto& binding : m_pDepthPyramidProgram->getLayoutBindings())
+					{
+						auto& write = writes.emplace_back();
+						write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+						write.pNext = nullptr;
+						write.dstSet = frame.m_PyramidDescriptorSets[level];
+						write.dstBinding = binding.binding;
+						write.dstArrayElement = 0;
+						write.descriptorCount = 1;
+						write.descriptorType = binding.descriptorType;
+						write.pImageInfo = binding.binding == EnumToInt(DepthPyramidBinding::Input) ? &inputInfo : &outputInfo;
+					}
+				}
+			}
+
+			m_Device.getDeviceTable().vkUpdateDescriptorSets(m_Device.getLogicalDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+		}
+
+		void VulkanCullingPass::destroyPyramid()
+		{
+			OPTICK_EVENT();
+
+			for (const auto view : m_PyramidLevelViews)
+				m_Device.getDeviceTable().vkDestroyImageView(m_Device.getLogicalDevice(), view, nullptr);
+
+			m_Device.getDeviceTable().vkDestroyImageView(m_Device.getLogicalDevice(), m_PyramidView, nullptr);
+			m_Device.getAllocator().apply([this](VmaAllocator& allocator) { vmaDestroyImage(allocator, m_PyramidImage, m_PyramidAllocation); });
+
+			// Destroying the pool frees the sets as well.
+			m_Device.getDeviceTable().vkDestroyDescriptorPool(m_Device.getLogicalDevice(), m_PyramidDescriptorPool, nullptr);
+			for (auto& frame : m_Frames)
+				frame.m_PyramidDescriptorSets.clear();
+
+			m_PyramidLevelViews.clear();
+			m_PyramidView = VK_NULL_HANDLE;
+			m_PyramidImage = VK_NULL_HANDLE;
+			m_PyramidAllocation = nullptr;
+			m_PyramidDescriptorPool = VK_NULL_HANDLE;
+		}
+
+		void VulkanCullingPass::writeCullingDescriptorSet(uint32_t frameIndex) const
+		{
+			OPTICK_EVENT();
+
+			const auto& frame = m_Frames[frameIndex];
+
+			const auto getBufferInfo = [](const VulkanBuffer* pBuffer)
+			{
+				VkDescriptorBufferInfo bufferInfo = {};
+				bufferInfo.buffer = pBuffer->getBuffer();
+				bufferInfo.offset = 0;
+				bufferInfo.range = pBuffer->getSize();	// Dynamic buffers use the range for every offset, so it's set explicitly.
+
+				return bufferInfo;
+			};
+
+			// The buffers, in the order of their bindings.
+			const VkDescriptorBufferInfo bufferInfos[] = {
+				getBufferInfo(frame.m_pViewBuffer.get()),
+				getBufferInfo(frame.m_pItemBuffer.get()),
+				getBufferInfo(frame.m_pSourceCommandBuffer),
+				getBufferInfo(frame.m_pSourceDrawDataBuffer),
+				getBufferInfo(frame.m_pCommandBuffer.get()),
+				getBufferInfo(frame.m_pDrawDataBuffer.get()),
+				getBufferInfo(frame.m_pCountBuffer.get())
+			};
+
+			VkDescriptorImageInfo imageInfo = {};
+			imageInfo.sampler = m_Sampler;
+			imageInfo.imageView = m_PyramidView;
+			imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+			std::vector<VkWriteDescriptorSet> writes;
+			writes.reserve(m_pCullingProgram->getLayoutBindings().size());
+			for (const auto& binding : m_pCullingProgram->getLayoutBindings())
+			{
+				if (binding.binding > EnumToInt(CullingBinding::DepthPyramid))
+					throw BackendError("The culling program has an unknown binding!");
+
+				auto& write = writes.emplace_back();
+				write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				write.pNext = nullptr;
+				write.dstSet = frame.m_CullingDescriptorSet;
+				write.dstBinding = binding.binding;
+				write.dstArrayElement = 0;
+				write.descriptorCount = 1;
+				write.descriptorType = binding.descriptorType;
+
+				if (binding.binding == EnumToInt(CullingBinding::DepthPyramid))
+					write.pImageInfo = &imageInfo;
+
+				else
+					write.pBufferInfo = &bufferInfos[binding.binding];
+			}
+
+			m_Device.getDeviceTable().vkUpdateDescriptorSets(m_Device.getLogicalDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+		}
+	}
+}
\ No newline at end of file
@@ -15,8 +15,8 @@ namespace Flint
 		{
 			OPTICK_EVENT();
 
-			// Create the image.
-			createImage(VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_IMAGE_TILING_OPTIMAL);
+			// Create the image. The depth is sampled when building the depth pyramid for occlusion culling.
+			createImage(VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_IMAGE_TILING_OPTIMAL);
 
 			// Create the image view.
 			createImageView(VK_IMAGE_ASPECT_DEPTH_BIT);
@@ -9,6 +9,64 @@
 
 #include <Optick.h>
 
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include <algorithm>
+
+namespace /* anonymous */
+{
+	/**
+	 * The number of descriptor sets a single descriptor pool can hold.
+	 */
+	constexpr uint32_t SetsPerPool = 128;
+
+	/**
+	 * Check if a descriptor type is a dynamic buffer type.
+	 *
+	 * @param type The descriptor type.
+	 * @return Whether or not the type is dynamic.
+	 */
+	bool IsDynamicBuffer(VkDescriptorType type)
+	{
+		return type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC || type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+	}
+
+	/**
+	 * Get the descriptor image info of an image binding.
+	 *
+	 * @param image The image binding.
+	 * @return The image info.
+	 */
+	VkDescriptorImageInfo GetImageInfo(const auto& image)
+	{
+		VkDescriptorImageInfo imageInfo = {};
+		imageInfo.imageLayout = image.m_ImageUsage == Flint::ImageUsage::Graphics ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+		imageInfo.imageView = image.m_pTextureView->template as<Flint::Backend::VulkanTextureView>()->getViewHandle();
+		imageInfo.sampler = image.m_pTextureSampler->template as<Flint::Backend::VulkanTextureSampler>()->getSamplerHandle();
+
+		return imageInfo;
+	}
+
+	/**
+	 * Get the descriptor buffer info of a buffer binding.
+	 *
+	 * @param buffer The buffer binding.
+	 * @param type The descriptor type of the binding.
+	 * @return The buffer info.
+	 */
+	VkDescriptorBufferInfo GetBufferInfo(const auto& buffer, VkDescriptorType type)
+	{
+		// Dynamic buffers get their offset when binding, so the descriptor starts from 0.
+		VkDescriptorBufferInfo bufferInfo = {};
+		bufferInfo.buffer = buffer.m_pBuffer->template as<Flint::Backend::VulkanBuffer>()->getBuffer();
+		bufferInfo.offset = IsDynamicBuffer(type) ? 0 : buffer.m_Offset;
+		bufferInfo.range = buffer.m_Size;
+
+		return bufferInfo;
+	}
+}
+
 namespace Flint
 {
 	namespace Backend
@@ -20,181 +78,308 @@ namespace Flint
 
 		void VulkanDescriptorSetManager::destroy()
 		{
-			if (m_DescriptorPool != VK_NULL_HANDLE)
-				m_pDevice->getDeviceTable().vkDestroyDescriptorPool(m_pDevice->getLogicalDevice(), m_DescriptorPool, nullptr);
+			for (const auto pool : m_DescriptorPools)
+				m_pDevice->getDeviceTable().vkDestroyDescriptorPool(m_pDevice->getLogicalDevice(), pool, nullptr);
+
+			m_DescriptorPools.clear();
+			m_AvailableSets = 0;
 		}
 
-		void VulkanDescriptorSetManager::setup(const std::vector<VkDescriptorSetLayoutBinding>& layoutBindings, const std::vector<VkDescriptorPoolSize>& poolSizes, VkDescriptorSetLayout layout)
+		void VulkanDescriptorSetManager::setup(const std::vector<VkDescriptorSetLayoutBinding>& layoutBindings, const std::vector<VkDescriptorPoolSize>& poolSizes, VkDescriptorSetLayout layout, VkDescriptorUpdateTemplate updateTemplate, const std::vector<uint32_t>& templateBindings)
 		{
 			OPTICK_EVENT();
 
 			// Create the descriptor type map.
 			for (const auto& binding : layoutBindings)
+			{
 				m_DescriptorTypeMap[binding.binding] = binding.descriptorType;
 
+				// Keep track of the dynamic bindings.
+				if (IsDynamicBuffer(binding.descriptorType) && std::find(m_DynamicBindings.begin(), m_DynamicBindings.end(), binding.binding) == m_DynamicBindings.end())
+					m_DynamicBindings.emplace_back(binding.binding);
+			}
+
+			// Dynamic offsets are consumed in the binding order.
+			std::sort(m_DynamicBindings.begin(), m_DynamicBindings.end());
+
 			m_PoolSizes = std::move(poolSizes);
+			m_TemplateBindings = templateBindings;
 			m_DescriptorSetLayout = layout;
+			m_DescriptorUpdateTemplate = updateTemplate;
 		}
 
-		void VulkanDescriptorSetManager::registerTable(const MeshBindingTable& table)
+		uint64_t VulkanDescriptorSetManager::registerTable(const MeshBindingTable& table)
 		{
 			OPTICK_EVENT();
 
-			const auto tableHash = table.generateHash();
+			return registerTables(std::span<const MeshBindingTable>(&table, 1)).front();
+		}
 
-			// Return if the table is registered.
-			if (m_DescriptorSets.contains(tableHash))
-				return;
+		std::vector<uint64_t> VulkanDescriptorSetManager::registerTables(std::span<const MeshBindingTable> tables)
+		{
+			OPTICK_EVENT();
 
-			// Else we can create a new one and update the previous descriptors.
-			// First, create the new descriptor pool.
-			VkDescriptorPoolCreateInfo createInfo = {};
-			createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-			createInfo.pNext = nullptr;
-			createInfo.flags = 0;
-			createInfo.maxSets = (static_cast<uint32_t>(m_DescriptorSets.size()) + 1) * m_FrameCount;
-			createInfo.poolSizeCount = static_cast<uint32_t>(m_PoolSizes.size());
-			createInfo.pPoolSizes = m_PoolSizes.data();
+			std::vector<uint64_t> tableHashes;
+			tableHashes.reserve(tables.size());
 
-			VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
-			FLINT_VK_ASSERT(m_pDevice->getDeviceTable().vkCreateDescriptorPool(m_pDevice->getLogicalDevice(), &createInfo, nullptr, &descriptorPool), "Failed to create the descriptor pool!");
+			// Find the tables which are not registered yet.
+			std::vector<const MeshBindingTable*> pNewTables;
+			std::vector<uint64_t> newHashes;
+			for (const auto& table : tables)
+			{
+				const auto tableHash = generateHash(table);
+				tableHashes.emplace_back(tableHash);
 
-			// Allocate the descriptor sets.
-			VkDescriptorSetAllocateInfo allocateInfo = {};
-			allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			allocateInfo.pNext = nullptr;
-			allocateInfo.descriptorSetCount = 1;
-			allocateInfo.pSetLayouts = &m_DescriptorSetLayout;
-			allocateInfo.descriptorPool = descriptorPool;
+				if (m_DescriptorSets.contains(tableHash) || std::find(newHashes.begin(), newHashes.end(), tableHash) != newHashes.end())
+					continue;
+
+				pNewTables.emplace_back(&table);
+				newHashes.emplace_back(tableHash);
+			}
+
+			// Return if all the tables are registered.
+			if (pNewTables.empty())
+				return tableHashes;
+
+			// Allocate all the required descriptor sets at once.
+			auto descriptorSets = allocateDescriptorSets(static_cast<uint32_t>(pNewTables.size()) * m_FrameCount);
+
+			// Reserve the image and buffer infos beforehand so the pointers remain valid.
+			uint64_t imageCount = 0, bufferCount = 0;
+			for (const auto pTable : pNewTables)
+			{
+				imageCount += pTable->getImages().size();
+				bufferCount += pTable->getBuffers().size();
+			}
+
+			std::vector<VkDescriptorImageInfo> imageInfos;
+			imageInfos.reserve(imageCount);
 
-			// Create a descriptor set and copy the old stuff to it.
-			for (auto& [hash, table] : m_DescriptorSets)
+			std::vector<VkDescriptorBufferInfo> bufferInfos;
+			bufferInfos.reserve(bufferCount);
+
+			std::vector<VkWriteDescriptorSet> writeDescriptorSets;
+			writeDescriptorSets.reserve(imageCount + bufferCount);
+
+			std::vector<VkCopyDescriptorSet> copyDescriptorSets;
+			copyDescriptorSets.reserve((imageCount + bufferCount) * (m_FrameCount - 1));
+
+			for (uint64_t i = 0; i < pNewTables.size(); i++)
 			{
-				for (uint8_t i = 0; i < m_FrameCount; i++)
+				const auto& table = *pNewTables[i];
+				const auto pBegin = descriptorSets.begin() + i * m_FrameCount;
+				const auto sourceSet = *pBegin;
+
+				// Add the descriptor set to the list.
+				m_DescriptorSets.emplace(newHashes[i], DescriptorSet(std::vector<VkDescriptorSet>(pBegin, pBegin + m_FrameCount)));
+
+				// If the table binds everything the update template expects, we can write each frame's set with a single call.
+				if (m_DescriptorUpdateTemplate != VK_NULL_HANDLE && isTemplateCompatible(table))
 				{
-					VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
-					FLINT_VK_ASSERT(m_pDevice->getDeviceTable().vkAllocateDescriptorSets(m_pDevice->getLogicalDevice(), &allocateInfo, &descriptorSet), "Failed to allocate descriptor set!");
+					const auto updateData = getTemplateData(table);
+					for (uint8_t frame = 0; frame < m_FrameCount; frame++)
+						m_pDevice->getDeviceTable().vkUpdateDescriptorSetWithTemplate(m_pDevice->getLogicalDevice(), *(pBegin + frame), m_DescriptorUpdateTemplate, updateData.data());
 
-					// Set the destination set.
-					for (auto& copyInfo : table.m_CopyDescriptorSets)
-						copyInfo.dstSet = descriptorSet;
+					continue;
+				}
 
-					m_pDevice->getDeviceTable().vkUpdateDescriptorSets(m_pDevice->getLogicalDevice(), 0, nullptr, static_cast<uint32_t>(table.m_CopyDescriptorSets.size()), table.m_CopyDescriptorSets.data());
-					table.m_DescriptorSets[i] = descriptorSet;
+				// Copy a binding from the first set to the rest of the frames.
+				const auto copyBinding = [this, &copyDescriptorSets, pBegin, sourceSet](uint32_t binding)
+				{
+					for (uint8_t frame = 1; frame < m_FrameCount; frame++)
+					{
+						auto& copySet = copyDescriptorSets.emplace_back();
+						copySet.sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
+						copySet.pNext = nullptr;
+						copySet.dstSet = *(pBegin + frame);
+						copySet.srcSet = sourceSet;
+						copySet.descriptorCount = 1;
+						copySet.dstBinding = binding;
+						copySet.dstArrayElement = 0;
+						copySet.srcBinding = binding;
+						copySet.srcArrayElement = 0;
+					}
+				};
+
+				// Resolve the images.
+				for (const auto& [binding, image] : table.getImages())
+				{
+					const auto& imageInfo = imageInfos.emplace_back(GetImageInfo(image));
+
+					// Setup write info.
+					auto& writeDescriptorSet = writeDescriptorSets.emplace_back();
+					writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+					writeDescriptorSet.pNext = nullptr;
+					writeDescriptorSet.dstSet = sourceSet;
+					writeDescriptorSet.dstBinding = binding;
+					writeDescriptorSet.descriptorCount = 1;
+					writeDescriptorSet.descriptorType = m_DescriptorTypeMap[binding];
+					writeDescriptorSet.dstArrayElement = 0;
+					writeDescriptorSet.pBufferInfo = nullptr;
+					writeDescriptorSet.pImageInfo = &imageInfo;
+					writeDescriptorSet.pTexelBufferView = nullptr;
+
+					copyBinding(binding);
+				}
 
-					// Set the source set.
-					for (auto& copyInfo : table.m_CopyDescriptorSets)
-						copyInfo.srcSet = descriptorSet;
+				// Resolve buffers.
+				for (const auto& [binding, buffer] : table.getBuffers())
+				{
+					const auto descriptorType = m_DescriptorTypeMap[binding];
+					const auto& bufferInfo = bufferInfos.emplace_back(GetBufferInfo(buffer, descriptorType));
+
+					// Setup write info.
+					auto& writeDescriptorSet = writeDescriptorSets.emplace_back();
+					writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+					writeDescriptorSet.pNext = nullptr;
+					writeDescriptorSet.dstSet = sourceSet;
+					writeDescriptorSet.dstBinding = binding;
+					writeDescriptorSet.descriptorCount = 1;
+					writeDescriptorSet.descriptorType = descriptorType;
+					writeDescriptorSet.dstArrayElement = 0;
+					writeDescriptorSet.pBufferInfo = &bufferInfo;
+					writeDescriptorSet.pImageInfo = nullptr;
+					writeDescriptorSet.pTexelBufferView = nullptr;
+
+					copyBinding(binding);
 				}
 			}
 
-			// Delete the old descriptor set.
-			if (m_DescriptorPool != VK_NULL_HANDLE)
-				m_pDevice->getDeviceTable().vkDestroyDescriptorPool(m_pDevice->getLogicalDevice(), m_DescriptorPool, nullptr);
-			m_DescriptorPool = descriptorPool;
+			// Update the rest of the descriptor sets with the data. Writes are performed before the copies, so the copies will see the new descriptors.
+			if (!writeDescriptorSets.empty())
+				m_pDevice->getDeviceTable().vkUpdateDescriptorSets(m_pDevice->getLogicalDevice(),
+				static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(),
+				static_cast<uint32_t>(copyDescriptorSets.size()), copyDescriptorSets.data());
 
-			// Now we can create the new ones.
-			std::vector<VkDescriptorSetLayout> layouts(m_FrameCount, m_DescriptorSetLayout);
-			std::vector<VkDescriptorSet> descriptorSets(m_FrameCount);
+			return tableHashes;
+		}
 
-			allocateInfo.descriptorSetCount = m_FrameCount;
-			allocateInfo.pSetLayouts = layouts.data();
-			FLINT_VK_ASSERT(m_pDevice->getDeviceTable().vkAllocateDescriptorSets(m_pDevice->getLogicalDevice(), &allocateInfo, descriptorSets.data()), "Failed to allocate descriptor set!");
+		std::vector<uint32_t> VulkanDescriptorSetManager::getDynamicOffsets(const MeshBindingTable& table) const
+		{
+			OPTICK_EVENT();
 
-			std::vector<VkWriteDescriptorSet> writeDescriptorSets;
-			std::vector<VkCopyDescriptorSet> copyDescriptorSets;
+			std::vector<uint32_t> offsets;
+			offsets.reserve(m_DynamicBindings.size());
 
-			// Resolve the images.
-			for (const auto& [binding, image] : table.getImages())
+			// Every dynamic binding requires an offset, even if the table does not bind anything to it.
+			const auto& buffers = table.getBuffers();
+			for (const auto binding : m_DynamicBindings)
 			{
-				// Setup write info.
-				auto& writeDescriptorSet = writeDescriptorSets.emplace_back();
-				writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-				writeDescriptorSet.pNext = nullptr;
-				writeDescriptorSet.dstSet = descriptorSets.front();
-				writeDescriptorSet.dstBinding = binding;
-				writeDescriptorSet.descriptorCount = 1;
-				writeDescriptorSet.descriptorType = m_DescriptorTypeMap[binding];
-				writeDescriptorSet.pBufferInfo = nullptr;
-				writeDescriptorSet.pTexelBufferView = nullptr;
-				writeDescriptorSet.dstArrayElement = 0;
-
-				auto pImageInfo = new VkDescriptorImageInfo;
-				pImageInfo->imageLayout = image.m_ImageUsage == ImageUsage::Graphics ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-				pImageInfo->imageView = image.m_pTextureView->as<VulkanTextureView>()->getViewHandle();
-				pImageInfo->sampler = image.m_pTextureSampler->as<VulkanTextureSampler>()->getSamplerHandle();
-				writeDescriptorSet.pImageInfo = pImageInfo;
-
-				// Setup copy info.
-				auto& copySet = copyDescriptorSets.emplace_back();
-				copySet.sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
-				copySet.pNext = nullptr;
-				copySet.dstSet = VK_NULL_HANDLE;
-				copySet.srcSet = descriptorSets.front();
-				copySet.descriptorCount = 1;
-				copySet.dstBinding = binding;
-				copySet.dstArrayElement = 0;
-				copySet.srcBinding = binding;
-				copySet.srcArrayElement = 0;
+				const auto itr = buffers.find(binding);
+				offsets.emplace_back(itr != buffers.end() ? static_cast<uint32_t>(itr->second.m_Offset) : 0);
 			}
 
-			// Resolve buffers.
-			for (const auto& [binding, buffers] : table.getBuffers())
+			return offsets;
+		}
+
+		VkDescriptorSet VulkanDescriptorSetManager::getDescriptorSet(uint64_t hash, uint32_t frameIndex) const
+		{
+			OPTICK_EVENT();
+
+			return m_DescriptorSets.at(hash).m_DescriptorSets[frameIndex];
+		}
+
+		uint64_t VulkanDescriptorSetManager::generateHash(const MeshBindingTable& table) const
+		{
+			OPTICK_EVENT();
+
+			std::vector<uint64_t> hashes = { table.generateHash() };
+
+			// Append the offsets of the buffers which are not dynamic.
+			for (const auto& [binding, buffer] : table.getBuffers())
 			{
-				// Setup write info.
-				auto& writeDescriptorSet = writeDescriptorSets.emplace_back();
-				writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-				writeDescriptorSet.pNext = nullptr;
-				writeDescriptorSet.dstSet = descriptorSets.front();
-				writeDescriptorSet.dstBinding = binding;
-				writeDescriptorSet.descriptorCount = 1;
-				writeDescriptorSet.descriptorType = m_DescriptorTypeMap[binding];
-				writeDescriptorSet.dstArrayElement = 0;
-				writeDescriptorSet.pBufferInfo = buffers->as<VulkanBuffer>()->getDescriptorBufferInfo();
-				writeDescriptorSet.pImageInfo = nullptr;
-				writeDescriptorSet.pTexelBufferView = nullptr;
-
-				// Setup copy info.
-				auto& copySet = copyDescriptorSets.emplace_back();
-				copySet.sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
-				copySet.pNext = nullptr;
-				copySet.dstSet = VK_NULL_HANDLE;
-				copySet.srcSet = descriptorSets.front();
-				copySet.descriptorCount = 1;
-				copySet.dstBinding = binding;
-				copySet.dstArrayElement = 0;
-				copySet.srcBinding = binding;
-				copySet.srcArrayElement = 0;
+				const auto itr = m_DescriptorTypeMap.find(binding);
+				if (itr != m_DescriptorTypeMap.end() && !IsDynamicBuffer(itr->second) && buffer.m_Offset > 0)
+				{
+					hashes.emplace_back(binding);
+					hashes.emplace_back(buffer.m_Offset);
+				}
 			}
 
-			// Update the descriptor sets with the data.
-			m_pDevice->getDeviceTable().vkUpdateDescriptorSets(m_pDevice->getLogicalDevice(), static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+			if (hashes.size() == 1)
+				return hashes.front();
+
+			return static_cast<uint64_t>(XXH64(hashes.data(), sizeof(uint64_t) * hashes.size(), 0));
+		}
+
+		bool VulkanDescriptorSetManager::isTemplateCompatible(const MeshBindingTable& table) const
+		{
+			return std::all_of(m_TemplateBindings.begin(), m_TemplateBindings.end(), [&table](const uint32_t binding) { return table.getBuffers().contains(binding) || table.getImages().contains(binding); });
+		}
+
+		std::vector<DescriptorUpdateData> VulkanDescriptorSetManager::getTemplateData(const MeshBindingTable& table) const
+		{
+			OPTICK_EVENT();
 
-			// Copy the descriptors to the rest.
-			for (uint8_t i = 1; i < m_FrameCount; i++)
+			std::vector<DescriptorUpdateData> updateData(m_TemplateBindings.size());
+			for (uint64_t i = 0; i < m_TemplateBindings.size(); i++)
 			{
-				for (auto& copy : copyDescriptorSets)
-					copy.dstSet = descriptorSets[i];
+				const auto binding = m_TemplateBindings[i];
+
+				if (const auto buffer = table.getBuffers().find(binding); buffer != table.getBuffers().end())
+					updateData[i].m_BufferInfo = GetBufferInfo(buffer->second, m_DescriptorTypeMap.at(binding));
 
-				m_pDevice->getDeviceTable().vkUpdateDescriptorSets(m_pDevice->getLogicalDevice(), 0, nullptr, static_cast<uint32_t>(copyDescriptorSets.size()), copyDescriptorSets.data());
+				else
+					updateData[i].m_ImageInfo = GetImageInfo(table.getImages().at(binding));
 			}
 
-			// Delete the allocated memory.
-			for (auto& write : writeDescriptorSets)
+			return updateData;
+		}
+
+		std::vector<VkDescriptorSet> VulkanDescriptorSetManager::allocateDescriptorSets(uint32_t count)
+		{
+			OPTICK_EVENT();
+
+			std::vector<VkDescriptorSet> descriptorSets(count);
+
+			VkDescriptorSetAllocateInfo allocateInfo = {};
+			allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+			allocateInfo.pNext = nullptr;
+
+			// Allocate the sets in chunks, each chunk coming from the pool which has space for it.
+			uint32_t allocated = 0;
+			while (allocated < count)
 			{
-				if (write.pImageInfo)
-					delete write.pImageInfo;
+				if (m_AvailableSets == 0)
+					createDescriptorPool();
+
+				const auto chunkSize = std::min(count - allocated, m_AvailableSets);
+				const std::vector<VkDescriptorSetLayout> layouts(chunkSize, m_DescriptorSetLayout);
+
+				allocateInfo.descriptorPool = m_DescriptorPools.back();
+				allocateInfo.descriptorSetCount = chunkSize;
+				allocateInfo.pSetLayouts = layouts.data();
+				FLINT_VK_ASSERT(m_pDevice->getDeviceTable().vkAllocateDescriptorSets(m_pDevice->getLogicalDevice(), &allocateInfo, descriptorSets.data() + allocated), "Failed to allocate descriptor set!");
+
+				allocated += chunkSize;
+				m_AvailableSets -= chunkSize;
 			}
 
-			// Add the descriptor set to the list.
-			m_DescriptorSets.emplace(tableHash, DescriptorSet(std::move(copyDescriptorSets), std::move(descriptorSets)));
+			return descriptorSets;
 		}
 
-		VkDescriptorSet VulkanDescriptorSetManager::getDescriptorSet(uint64_t hash, uint32_t frameIndex) const
+		void VulkanDescriptorSetManager::createDescriptorPool()
 		{
 			OPTICK_EVENT();
 
-			return m_DescriptorSets.at(hash).m_DescriptorSets[frameIndex];
+			// Every pool should be able to hold the descriptors of all of its sets.
+			auto poolSizes = m_PoolSizes;
+			for (auto& poolSize : poolSizes)
+				poolSize.descriptorCount *= SetsPerPool;
+
+			VkDescriptorPoolCreateInfo createInfo = {};
+			createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+			createInfo.pNext = nullptr;
+			createInfo.flags = 0;
+			createInfo.maxSets = SetsPerPool;
+			createInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+			createInfo.pPoolSizes = poolSizes.data();
+
+			VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+			FLINT_VK_ASSERT(m_pDevice->getDeviceTable().vkCreateDescriptorPool(m_pDevice->getLogicalDevice(), &createInfo, nullptr, &descriptorPool), "Failed to create the descriptor pool!");
+
+			m_DescriptorPools.emplace_back(descriptorPool);
+			m_AvailableSets = SetsPerPool;
 		}
 	}
 }
\ No newline at end of file
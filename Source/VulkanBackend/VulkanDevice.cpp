@@ -9,6 +9,8 @@
 #include "Flint/VulkanBackend/VulkanRayTracer.hpp"
 #include "Flint/VulkanBackend/VulkanWindow.hpp"
 #include "Flint/VulkanBackend/VulkanRasterizingProgram.hpp"
+#include "Flint/VulkanBackend/VulkanComputeProgram.hpp"
+#include "Flint/VulkanBackend/VulkanComputePipeline.hpp"
 #include "Flint/VulkanBackend/VulkanStaticModel.hpp"
 #include "Flint/VUlkanBackend/VulkanTexture2D.hpp"
 #include "Flint/VUlkanBackend/VulkanTextureSampler.hpp"
@@ -20,6 +22,7 @@
 
 #include <set>
 #include <array>
+#include <algorithm>
 
 #ifdef FLINT_PLATFORM_WINDOWS
 #	include <execution>
@@ -70,9 +73,11 @@ namespace /* anonymous */
 	 *
 	 * @param physicalDevice The physical device to get the queue family from.
 	 * @param flag The queue flag.
+	 * @param avoidedFlags The queue flags which the family should preferably not have. If there are no such families, the first family with the flag is
+	 * returned. Default is 0.
 	 * @retrun The queue family.
 	 */
-	uint32_t GetQueueFamily(VkPhysicalDevice physicalDevice, VkQueueFlagBits flag)
+	uint32_t GetQueueFamily(VkPhysicalDevice physicalDevice, VkQueueFlagBits flag, VkQueueFlags avoidedFlags = 0)
 	{
 		OPTICK_EVENT();
 
@@ -88,7 +93,7 @@ namespace /* anonymous */
 		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
 		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
 
-		// Iterate over those queue family properties and check if we have a family with the required flag.
+		// Iterate over those queue family properties and check if we have a family with the required flag, and without the avoided flags.
 		for (uint32_t i = 0; i < queueFamilies.size(); ++i)
 		{
 			const auto& family = queueFamilies[i];
@@ -96,10 +101,14 @@ namespace /* anonymous */
 				continue;
 
 			// Check if the queue flag contains what we want.
-			if (family.queueFlags & flag)
+			if (family.queueFlags & flag && !(family.queueFlags & avoidedFlags))
 				return i;
 		}
 
+		// Fall back to any family with the required flag.
+		if (avoidedFlags != 0)
+			return GetQueueFamily(physicalDevice, flag);
+
 		return -1;
 	}
 
@@ -155,6 +164,12 @@ namespace Flint
 			// Create the VMA allocator.
 			createVMAAllocator();
 
+			// Create the geometry pool.
+			m_pGeometryPool = std::make_unique<VulkanGeometryPool>(*this);
+
+			// Create the shader cache.
+			m_pShaderCache = std::make_unique<VulkanShaderCache>(*this);
+
 			// Make sure to set the object as valid.
 			validate();
 		}
@@ -199,11 +214,25 @@ namespace Flint
 			return std::make_shared<VulkanRasterizingProgram>(shared_from_this(), std::move(vertexShader), std::move(fragementShader));
 		}
 
-		std::shared_ptr<Flint::Backend::StaticModel> VulkanDevice::createStaticModel(std::filesystem::path&& assetFile)
+		std::shared_ptr<Flint::Backend::ComputeProgram> VulkanDevice::createComputeProgram(ShaderCode&& computeShader)
+		{
+			OPTICK_EVENT();
+
+			return std::make_shared<VulkanComputeProgram>(shared_from_this(), std::move(computeShader));
+		}
+
+		std::shared_ptr<Flint::Backend::ComputePipeline> VulkanDevice::createComputePipeline(const std::shared_ptr<ComputeProgram>& pProgram, std::unique_ptr<PipelineCacheHandler>&& pCacheHandler /*= nullptr*/)
 		{
 			OPTICK_EVENT();
 
-			return std::make_shared<VulkanStaticModel>(shared_from_this(), std::move(assetFile));
+			return std::make_shared<VulkanComputePipeline>(shared_from_this(), std::static_pointer_cast<VulkanComputeProgram>(pProgram), std::move(pCacheHandler));
+		}
+
+		std::shared_ptr<Flint::Backend::StaticModel> VulkanDevice::createStaticModel(std::filesystem::path&& assetFile, VertexMemoryType memoryType /*= VertexMemoryType::Exclusive*/, std::vector<VertexInput>&& vertexLayout /*= {}*/, VertexFormatProfile formatProfile /*= VertexFormatProfile::Full*/)
+		{
+			OPTICK_EVENT();
+
+			return std::make_shared<VulkanStaticModel>(shared_from_this(), std::move(assetFile), memoryType, std::move(vertexLayout), formatProfile);
 		}
 
 		std::shared_ptr<Flint::Backend::Texture2D> VulkanDevice::createTexture2D(uint32_t width, uint32_t height, ImageUsage usage, PixelFormat format, uint32_t mipLevels /*= 0*/, Multisample multisampleCount /*= Multisample::One*/, const std::byte* pDataStore /*= nullptr*/)
@@ -239,6 +268,21 @@ namespace Flint
 			// Terminate the samplers.
 			m_Samplers.clear();
 
+			// Destroy the bindless descriptor.
+			if (m_pBindlessDescriptor)
+			{
+				m_pBindlessDescriptor->destroy();
+				m_pBindlessDescriptor.reset();
+			}
+
+			// Destroy the geometry pool.
+			m_pGeometryPool->destroy();
+			m_pGeometryPool.reset();
+
+			// Destroy the shader cache.
+			m_pShaderCache->destroy();
+			m_pShaderCache.reset();
+
 			// Destroy the VMA allocator.
 			destroyVMAAllocator();
 
@@ -278,6 +322,40 @@ namespace Flint
 			return Multisample::One;
 		}
 
+		uint64_t VulkanDevice::getBufferAlignment(BufferUsage usage) const
+		{
+			switch (usage)
+			{
+			case BufferUsage::Uniform:
+				return m_PhysicalDeviceProperties.limits.minUniformBufferOffsetAlignment;
+
+			case BufferUsage::Storage:
+			case BufferUsage::Indirect:
+				return m_PhysicalDeviceProperties.limits.minStorageBufferOffsetAlignment;
+
+			case BufferUsage::General:
+				return std::max(m_PhysicalDeviceProperties.limits.minUniformBufferOffsetAlignment, m_PhysicalDeviceProperties.limits.minStorageBufferOffsetAlignment);
+
+			default:
+				return 1;
+			}
+		}
+
+		bool VulkanDevice::isPipelineCacheCompatible(const std::vector<std::byte>& data) const
+		{
+			if (data.size() < sizeof(VkPipelineCacheHeaderVersionOne))
+				return false;
+
+			VkPipelineCacheHeaderVersionOne header = {};
+			std::copy_n(data.data(), sizeof(VkPipelineCacheHeaderVersionOne), reinterpret_cast<std::byte*>(&header));
+
+			return header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne) &&
+				header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+				header.vendorID == m_PhysicalDeviceProperties.vendorID &&
+				header.deviceID == m_PhysicalDeviceProperties.deviceID &&
+				std::equal(std::begin(header.pipelineCacheUUID), std::end(header.pipelineCacheUUID), std::begin(m_PhysicalDeviceProperties.pipelineCacheUUID));
+		}
+
 		void VulkanDevice::selectPhysicalDevice()
 		{
 			OPTICK_EVENT();
@@ -363,7 +441,8 @@ namespace Flint
 
 			// Setup the queue families.
 			m_GraphicsQueue.apply([this](VulkanQueue& queue) { queue.m_Family = GetQueueFamily(m_PhysicalDevice, VK_QUEUE_GRAPHICS_BIT); });
-			m_ComputeQueue.apply([this](VulkanQueue& queue) { queue.m_Family = GetQueueFamily(m_PhysicalDevice, VK_QUEUE_COMPUTE_BIT); });
+			// Prefer a compute family which cannot do graphics, so compute work can run asynchronously to the rendering.
+			m_ComputeQueue.apply([this](VulkanQueue& queue) { queue.m_Family = GetQueueFamily(m_PhysicalDevice, VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT); });
 			m_TransferQueue.apply([this](VulkanQueue& queue) { queue.m_Family = GetQueueFamily(m_PhysicalDevice, VK_QUEUE_TRANSFER_BIT); });
 		}
 
@@ -401,10 +480,63 @@ namespace Flint
 			features.tessellationShader = VK_TRUE;
 			features.geometryShader = VK_TRUE;
 
+			// Check if we can use descriptor indexing for bindless resources.
+			VkPhysicalDeviceDescriptorIndexingFeatures supportedIndexingFeatures = {};
+			supportedIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+			supportedIndexingFeatures.pNext = nullptr;
+
+			VkPhysicalDeviceFeatures2 supportedFeatures = {};
+			supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			supportedFeatures.pNext = &supportedIndexingFeatures;
+			vkGetPhysicalDeviceFeatures2(m_PhysicalDevice, &supportedFeatures);
+
+			const bool supportsBindless = CheckDeviceExtensionSupport(m_PhysicalDevice, { VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME }) &&
+				supportedIndexingFeatures.runtimeDescriptorArray &&
+				supportedIndexingFeatures.descriptorBindingPartiallyBound &&
+				supportedIndexingFeatures.descriptorBindingUpdateUnusedWhilePending &&
+				supportedIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+				supportedIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind &&
+				supportedIndexingFeatures.shaderSampledImageArrayNonUniformIndexing &&
+				supportedIndexingFeatures.shaderStorageBufferArrayNonUniformIndexing;
+
+			// Enable multi draw indirect if possible, so batches of meshes can be drawn using a single indirect draw. The first instance is used to select
+			// the level of detail's instances so we need both.
+			m_SupportsMultiDrawIndirect = supportedFeatures.features.multiDrawIndirect && supportedFeatures.features.drawIndirectFirstInstance;
+			features.multiDrawIndirect = m_SupportsMultiDrawIndirect ? VK_TRUE : VK_FALSE;
+			features.drawIndirectFirstInstance = m_SupportsMultiDrawIndirect ? VK_TRUE : VK_FALSE;
+
+			// Enable draw indirect count if possible, so the draws which are culled on the GPU can be issued without reading the draw count back.
+			m_SupportsDrawIndirectCount = m_SupportsMultiDrawIndirect && CheckDeviceExtensionSupport(m_PhysicalDevice, { VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME });
+			if (m_SupportsDrawIndirectCount)
+				m_DeviceExtensions.emplace_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+
+			VkPhysicalDeviceDescriptorIndexingFeatures indexingFeatures = {};
+			indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+			indexingFeatures.pNext = nullptr;
+
+			// Timeline semaphores are used to make the graphics queue wait for the compute queue.
+			VkPhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeatures = {};
+			timelineSemaphoreFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+			timelineSemaphoreFeatures.pNext = supportsBindless ? &indexingFeatures : nullptr;
+			timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+
+			if (supportsBindless)
+			{
+				m_DeviceExtensions.emplace_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+
+				indexingFeatures.runtimeDescriptorArray = VK_TRUE;
+				indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+				indexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+				indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+				indexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+				indexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+				indexingFeatures.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+			}
+
 			// Setup the device create info.
 			VkDeviceCreateInfo deviceCreateInfo = {};
 			deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-			deviceCreateInfo.pNext = nullptr;
+			deviceCreateInfo.pNext = &timelineSemaphoreFeatures;
 			deviceCreateInfo.flags = 0;
 			deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
 			deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
@@ -432,12 +564,31 @@ namespace Flint
 			m_GraphicsQueue.apply([this](VulkanQueue& queue) { m_DeviceTable.vkGetDeviceQueue(m_LogicalDevice, queue.m_Family, 0, &queue.m_Queue); });
 			m_ComputeQueue.apply([this](VulkanQueue& queue) { m_DeviceTable.vkGetDeviceQueue(m_LogicalDevice, queue.m_Family, 0, &queue.m_Queue); });
 			m_TransferQueue.apply([this](VulkanQueue& queue) { m_DeviceTable.vkGetDeviceQueue(m_LogicalDevice, queue.m_Family, 0, &queue.m_Queue); });
+
+			// Create the compute timeline semaphore.
+			VkSemaphoreTypeCreateInfo semaphoreTypeCreateInfo = {};
+			semaphoreTypeCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+			semaphoreTypeCreateInfo.pNext = nullptr;
+			semaphoreTypeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+			semaphoreTypeCreateInfo.initialValue = 0;
+
+			VkSemaphoreCreateInfo semaphoreCreateInfo = {};
+			semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+			semaphoreCreateInfo.pNext = &semaphoreTypeCreateInfo;
+			semaphoreCreateInfo.flags = 0;
+
+			FLINT_VK_ASSERT(m_DeviceTable.vkCreateSemaphore(m_LogicalDevice, &semaphoreCreateInfo, nullptr, &m_ComputeSemaphore), "Failed to create the compute semaphore!");
+
+			// Create the bindless descriptor if supported.
+			if (supportsBindless)
+				m_pBindlessDescriptor = std::make_unique<VulkanBindlessDescriptor>(*this);
 		}
 
 		void VulkanDevice::destroyLogicalDevice()
 		{
 			OPTICK_EVENT();
 
+			m_DeviceTable.vkDestroySemaphore(m_LogicalDevice, m_ComputeSemaphore, nullptr);
 			vkDestroyDevice(m_LogicalDevice, nullptr);
 		}
 
@@ -0,0 +1,182 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Flint/VulkanBackend/VulkanGeometryPool.hpp"
+#include "Flint/VulkanBackend/VulkanVertexStorage.hpp"
+
+#include <Optick.h>
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include <algorithm>
+
+namespace /* anonymous */
+{
+	/**
+	 * Compute the hash of an arena.
+	 *
+	 * @param memoryType The vertex memory type.
+	 * @param strides The attribute strides.
+	 * @return The arena hash.
+	 */
+	uint64_t HashArena(Flint::VertexMemoryType memoryType, std::array<uint32_t, Flint::EnumToInt(Flint::VertexAttribute::Max)> strides)
+	{
+		// Only the vertex stride matters when the data are interleaved.
+		if (memoryType == Flint::VertexMemoryType::Interleaved)
+			std::fill(strides.begin() + 1, strides.end(), 0);
+
+		const auto hash = static_cast<uint64_t>(XXH64(strides.data(), sizeof(strides), 0));
+		return hash ^ static_cast<uint64_t>(Flint::EnumToInt(memoryType));
+	}
+}
+
+namespace Flint
+{
+	namespace Backend
+	{
+		VulkanGeometryPool::VulkanGeometryPool(VulkanDevice& device)
+			: m_Device(device)
+		{
+		}
+
+		VulkanGeometryPool::~VulkanGeometryPool()
+		{
+			destroy();
+		}
+
+		void VulkanGeometryPool::destroy()
+		{
+			OPTICK_EVENT();
+
+			auto lock = std::scoped_lock(m_Mutex);
+
+			for (auto& [hash, arena] : m_VertexArenas)
+			{
+				for (auto& block : arena.m_Blocks)
+					block.m_pStorage->terminate();
+			}
+
+			for (auto& block : m_IndexBlocks)
+				block.m_pBuffer->terminate();
+
+			m_VertexArenas.clear();
+			m_IndexBlocks.clear();
+		}
+
+		VulkanGeometryPool::VertexRange VulkanGeometryPool::allocateVertices(VertexMemoryType memoryType, const std::array<uint32_t, EnumToInt(VertexAttribute::Max)>& strides, const std::array<bool, EnumToInt(VertexAttribute::Max)>& usedAttributes, uint64_t vertexCount)
+		{
+			OPTICK_EVENT();
+
+			auto lock = std::scoped_lock(m_Mutex);
+
+			VertexRange range;
+			range.m_ArenaHash = HashArena(memoryType, strides);
+			range.m_VertexCount = vertexCount;
+
+			auto& arena = m_VertexArenas[range.m_ArenaHash];
+			arena.m_Strides = strides;
+
+			// Try to fit the range in one of the existing blocks, and create a new block if none of them have enough space.
+			range.m_FirstVertex = RangeAllocator::InvalidOffset;
+			for (range.m_Block = 0; range.m_Block < arena.m_Blocks.size(); range.m_Block++)
+			{
+				range.m_FirstVertex = arena.m_Blocks[range.m_Block].m_Allocator.allocate(vertexCount);
+				if (range.m_FirstVertex != RangeAllocator::InvalidOffset)
+					break;
+			}
+
+			if (range.m_FirstVertex == RangeAllocator::InvalidOffset)
+			{
+				auto& block = arena.m_Blocks.emplace_back();
+				block.m_pStorage = std::make_unique<VulkanVertexStorage>(m_Device.shared_from_this(), memoryType);
+				block.m_Allocator = RangeAllocator(std::max(DefaultBlockVertexCount, vertexCount));
+
+				range.m_FirstVertex = block.m_Allocator.allocate(vertexCount);
+			}
+
+			// Create the attribute buffers which the block does not have yet. The storage resolves all the attributes to the same buffer if the data are
+			// interleaved, so we only need to check the first one.
+			auto& block = arena.m_Blocks[range.m_Block];
+			range.m_pStorage = block.m_pStorage.get();
+
+			const auto attributeCount = memoryType == VertexMemoryType::Interleaved ? 1 : EnumToInt(VertexAttribute::Max);
+			for (uint8_t a = 0; a < attributeCount; a++)
+			{
+				if (memoryType != VertexMemoryType::Interleaved && !usedAttributes[a])
+					continue;
+
+				const auto attribute = static_cast<VertexAttribute>(a);
+				if (!block.m_pStorage->getBuffer(attribute))
+					(void)block.m_pStorage->reserve(attribute, block.m_Allocator.getCapacity() * strides[a]);
+
+				range.m_Offsets[a] = range.m_FirstVertex * strides[a];
+			}
+
+			return range;
+		}
+
+		void VulkanGeometryPool::freeVertices(const VertexRange& range)
+		{
+			OPTICK_EVENT();
+
+			if (!range.m_pStorage)
+				return;
+
+			auto lock = std::scoped_lock(m_Mutex);
+
+			const auto arena = m_VertexArenas.find(range.m_ArenaHash);
+			if (arena == m_VertexArenas.end() || range.m_Block >= arena->second.m_Blocks.size())
+				throw BackendError("The vertex range does not belong to this pool!");
+
+			arena->second.m_Blocks[range.m_Block].m_Allocator.free(range.m_FirstVertex, range.m_VertexCount);
+		}
+
+		VulkanGeometryPool::IndexRange VulkanGeometryPool::allocateIndices(uint64_t size)
+		{
+			OPTICK_EVENT();
+
+			auto lock = std::scoped_lock(m_Mutex);
+
+			IndexRange range;
+			range.m_Size = size;
+
+			range.m_Offset = RangeAllocator::InvalidOffset;
+			for (range.m_Block = 0; range.m_Block < m_IndexBlocks.size(); range.m_Block++)
+			{
+				range.m_Offset = m_IndexBlocks[range.m_Block].m_Allocator.allocate(size, 4);
+				if (range.m_Offset != RangeAllocator::InvalidOffset)
+					break;
+			}
+
+			if (range.m_Offset == RangeAllocator::InvalidOffset)
+			{
+				const auto blockSize = std::max(DefaultIndexBlockSize, size);
+
+				auto& block = m_IndexBlocks.emplace_back();
+				block.m_pBuffer = std::static_pointer_cast<VulkanBuffer>(m_Device.createBuffer(blockSize, BufferUsage::Index));
+				block.m_Allocator = RangeAllocator(blockSize);
+
+				range.m_Offset = block.m_Allocator.allocate(size, 4);
+			}
+
+			range.m_pBuffer = m_IndexBlocks[range.m_Block].m_pBuffer.get();
+			return range;
+		}
+
+		void VulkanGeometryPool::freeIndices(const IndexRange& range)
+		{
+			OPTICK_EVENT();
+
+			if (!range.m_pBuffer)
+				return;
+
+			auto lock = std::scoped_lock(m_Mutex);
+
+			if (range.m_Block >= m_IndexBlocks.size())
+				throw BackendError("The index range does not belong to this pool!");
+
+			m_IndexBlocks[range.m_Block].m_Allocator.free(range.m_Offset, range.m_Size);
+		}
+	}
+}
\ No newline at end of file
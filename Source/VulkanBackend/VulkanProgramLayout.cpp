@@ -0,0 +1,284 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Flint/VulkanBackend/VulkanProgramLayout.hpp"
+#include "Flint/VulkanBackend/VulkanMacros.hpp"
+
+#include <Optick.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace /* anonymous */
+{
+	/**
+	 * Get the binging type from the descriptor type.
+	 *
+	 * @parma type The descriptor type.
+	 * @return The binding type.
+	 */
+	Flint::ResourceType GetResourceType(VkDescriptorType type)
+	{
+		switch (type)
+		{
+		case VK_DESCRIPTOR_TYPE_SAMPLER:										return Flint::ResourceType::Sampler;
+		case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:							return Flint::ResourceType::CombinedImageSampler;
+		case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:									return Flint::ResourceType::SampledImage;
+		case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:									return Flint::ResourceType::StorageImage;
+		case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:							return Flint::ResourceType::UniformTexelBuffer;
+		case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:							return Flint::ResourceType::StorageTexelBuffer;
+		case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:									return Flint::ResourceType::UniformBuffer;
+		case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:									return Flint::ResourceType::StorageBuffer;
+		case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:							return Flint::ResourceType::DynamicUniformBuffer;
+		case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:							return Flint::ResourceType::DynamicStorageBuffer;
+		case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:								return Flint::ResourceType::InputAttachment;
+		case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:						return Flint::ResourceType::AccelerationStructure;
+		default:																spdlog::error("Invalid resource type!"); return Flint::ResourceType::UniformBuffer;
+		}
+	}
+
+	/**
+	 * Promote a uniform or storage buffer descriptor type to it's dynamic counterpart if the device limits allow it.
+	 * Dynamic buffers let multiple buffer regions share the same descriptor set by supplying the offset at draw time.
+	 *
+	 * @param type The reflected descriptor type.
+	 * @param layoutBindings The already reflected layout bindings.
+	 * @param limits The physical device limits.
+	 * @return The descriptor type to use.
+	 */
+	VkDescriptorType PromoteToDynamic(VkDescriptorType type, const std::vector<VkDescriptorSetLayoutBinding>& layoutBindings, const VkPhysicalDeviceLimits& limits)
+	{
+		const auto countBindings = [&layoutBindings](VkDescriptorType descriptorType)
+		{
+			return static_cast<uint32_t>(std::count_if(layoutBindings.begin(), layoutBindings.end(), [descriptorType](const VkDescriptorSetLayoutBinding& binding) { return binding.descriptorType == descriptorType; }));
+		};
+
+		if (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER && countBindings(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) < limits.maxDescriptorSetUniformBuffersDynamic)
+			return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+
+		if (type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER && countBindings(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC) < limits.maxDescriptorSetStorageBuffersDynamic)
+			return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+
+		return type;
+	}
+}
+
+namespace Flint
+{
+	namespace Backend
+	{
+		VkPushConstantRange VulkanProgramLayout::getPushConstantRange(uint64_t size) const
+		{
+			VkPushConstantRange range = {};
+			range.stageFlags = m_PushConstantStageFlags;
+
+			if (m_PushConstants.empty())
+				return range;
+
+			const auto& pushConstant = m_PushConstants.front();
+			const auto end = std::min<uint64_t>(size, pushConstant.offset + pushConstant.size);
+
+			range.offset = pushConstant.offset;
+			range.size = end > pushConstant.offset ? static_cast<uint32_t>(end - pushConstant.offset) : 0;
+
+			return range;
+		}
+
+		VulkanProgramLayout::ShaderInterface VulkanProgramLayout::createShaderModule(const ShaderCode& shader, VkShaderStageFlagBits stage, BindingMap& bindingMap)
+		{
+			OPTICK_EVENT();
+
+			// Get the reflection from the device's shader cache. Shaders which were already reflected (in this session or a previous one) are not
+			// reflected again.
+			auto& shaderCache = m_Device.getShaderCache();
+			const auto pReflection = shaderCache.getReflection(shader, stage);
+
+			ShaderInterface shaderInterface = {};
+			shaderInterface.m_VertexInputs = pReflection->m_VertexInputs;
+			shaderInterface.m_InstanceInputs = pReflection->m_InstanceInputs;
+			shaderInterface.m_WorkGroupSize = pReflection->m_WorkGroupSize;
+
+			// Setup the layout bindings.
+			for (const auto& resource : pReflection->m_Bindings)
+			{
+				// Resources in the bindless set are managed by the device.
+				if (resource.m_Set == BindlessDescriptorSet)
+				{
+					if (!m_Device.isBindlessSupported())
+						throw BackendError("The shader uses bindless resources but the device does not support them!");
+
+					m_UsesBindless = true;
+					continue;
+				}
+
+				const auto descriptorType = PromoteToDynamic(resource.m_Type, m_LayoutBindings, m_Device.getPhysicalDeviceProperties().limits);
+
+				auto& binding = m_LayoutBindings.emplace_back();
+				binding.binding = resource.m_Binding;
+				binding.descriptorCount = resource.m_Count;
+				binding.descriptorType = descriptorType;
+				binding.pImmutableSamplers = nullptr;
+				binding.stageFlags = stage;
+
+				auto& poolSize = m_PoolSizes.emplace_back();
+				poolSize.descriptorCount = resource.m_Count;
+				poolSize.type = binding.descriptorType;
+
+				bindingMap.registerBinding(std::string(resource.m_Name), resource.m_Binding, GetResourceType(descriptorType));
+			}
+
+			// Setup the push constants. All the stages share a single range, so the constants can be pushed to all of them at once.
+			for (const auto& block : pReflection->m_PushConstantBlocks)
+			{
+				if (m_PushConstants.empty())
+				{
+					auto& pushConstant = m_PushConstants.emplace_back();
+					pushConstant.size = block.m_Size;
+					pushConstant.offset = block.m_Offset;
+					pushConstant.stageFlags = stage;
+				}
+				else
+				{
+					auto& pushConstant = m_PushConstants.front();
+					const auto end = std::max(pushConstant.offset + pushConstant.size, block.m_Offset + block.m_Size);
+					pushConstant.offset = std::min(pushConstant.offset, block.m_Offset);
+					pushConstant.size = end - pushConstant.offset;
+					pushConstant.stageFlags |= stage;
+				}
+
+				m_PushConstantStageFlags |= stage;
+
+				// Register the members so the meshes can set them by their names.
+				for (const auto& member : block.m_Members)
+					bindingMap.registerPushConstant(std::string(member.m_Name), member.m_Offset, member.m_Size);
+			}
+
+			// Setup the specialization constants. The same constant can be used by multiple stages.
+			for (const auto& constant : pReflection->m_SpecializationConstants)
+			{
+				auto& info = m_SpecializationConstants[constant.m_Name];
+				info.m_ConstantID = constant.m_ConstantID;
+				info.m_Size = constant.m_Size;
+			}
+
+			// Now let's get the shader module. Programs which use the same shader share the module.
+			const auto shaderModule = shaderCache.acquireModule(shader);
+			m_ShaderHashes.emplace_back(shader.getHash());
+
+			auto& shaderStage = m_ShaderStageCreateInfos.emplace_back();
+			shaderStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+			shaderStage.flags = 0;
+			shaderStage.pNext = nullptr;
+			shaderStage.module = shaderModule;
+			shaderStage.pSpecializationInfo = nullptr;
+			shaderStage.stage = stage;
+			shaderStage.pName = "main";
+
+			return shaderInterface;
+		}
+
+		void VulkanProgramLayout::createLayout(const BindingMap& bindingMap)
+		{
+			OPTICK_EVENT();
+
+			createDescriptorSetLayout();
+			createDescriptorUpdateTemplate(bindingMap);
+			createPipelineLayout();
+		}
+
+		void VulkanProgramLayout::destroyLayout()
+		{
+			OPTICK_EVENT();
+
+			for (const auto hash : m_ShaderHashes)
+				m_Device.getShaderCache().releaseModule(hash);
+
+			if (m_DescriptorUpdateTemplate)
+				m_Device.getDeviceTable().vkDestroyDescriptorUpdateTemplate(m_Device.getLogicalDevice(), m_DescriptorUpdateTemplate, nullptr);
+
+			m_Device.getDeviceTable().vkDestroyDescriptorSetLayout(m_Device.getLogicalDevice(), m_DescriptorSetLayout, nullptr);
+			m_Device.getDeviceTable().vkDestroyPipelineLayout(m_Device.getLogicalDevice(), m_PipelineLayout, nullptr);
+
+			m_ShaderHashes.clear();
+			m_ShaderStageCreateInfos.clear();
+		}
+
+		void VulkanProgramLayout::createDescriptorSetLayout()
+		{
+			OPTICK_EVENT();
+
+			VkDescriptorSetLayoutCreateInfo createInfo = {};
+			createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+			createInfo.flags = 0;
+			createInfo.pNext = nullptr;
+			createInfo.bindingCount = static_cast<uint32_t>(m_LayoutBindings.size());
+			createInfo.pBindings = m_LayoutBindings.data();
+
+			FLINT_VK_ASSERT(m_Device.getDeviceTable().vkCreateDescriptorSetLayout(m_Device.getLogicalDevice(), &createInfo, nullptr, &m_DescriptorSetLayout), "Failed to create the descriptor set layout!");
+		}
+
+		void VulkanProgramLayout::createDescriptorUpdateTemplate(const BindingMap& bindingMap)
+		{
+			OPTICK_EVENT();
+
+			// Create one entry per unique binding. The same binding might be reflected by multiple shader stages.
+			std::vector<VkDescriptorUpdateTemplateEntry> entries;
+			for (const auto& binding : bindingMap.getBindings())
+			{
+				if (std::find(m_TemplateBindings.begin(), m_TemplateBindings.end(), binding.m_BindingIndex) != m_TemplateBindings.end())
+					continue;
+
+				const auto layoutBinding = std::find_if(m_LayoutBindings.begin(), m_LayoutBindings.end(), [&binding](const VkDescriptorSetLayoutBinding& layoutBinding) { return layoutBinding.binding == binding.m_BindingIndex; });
+
+				auto& entry = entries.emplace_back();
+				entry.dstBinding = binding.m_BindingIndex;
+				entry.dstArrayElement = 0;
+				entry.descriptorCount = 1;
+				entry.descriptorType = layoutBinding->descriptorType;
+				entry.offset = sizeof(DescriptorUpdateData) * m_TemplateBindings.size();
+				entry.stride = sizeof(DescriptorUpdateData);
+
+				m_TemplateBindings.emplace_back(binding.m_BindingIndex);
+			}
+
+			// We don't need a template if there aren't any bindings.
+			if (entries.empty())
+				return;
+
+			VkDescriptorUpdateTemplateCreateInfo createInfo = {};
+			createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+			createInfo.pNext = nullptr;
+			createInfo.flags = 0;
+			createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+			createInfo.pDescriptorUpdateEntries = entries.data();
+			createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+			createInfo.descriptorSetLayout = m_DescriptorSetLayout;
+			createInfo.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+			createInfo.pipelineLayout = VK_NULL_HANDLE;
+			createInfo.set = 0;
+
+			FLINT_VK_ASSERT(m_Device.getDeviceTable().vkCreateDescriptorUpdateTemplate(m_Device.getLogicalDevice(), &createInfo, nullptr, &m_DescriptorUpdateTemplate), "Failed to create the descriptor update template!");
+		}
+
+		void VulkanProgramLayout::createPipelineLayout()
+		{
+			OPTICK_EVENT();
+
+			// The bindless descriptor set is bound right after the program's own descriptor set.
+			std::vector<VkDescriptorSetLayout> setLayouts = { m_DescriptorSetLayout };
+			if (m_UsesBindless)
+				setLayouts.emplace_back(m_Device.getBindlessDescriptor()->getDescriptorSetLayout());
+
+			VkPipelineLayoutCreateInfo createInfo = {};
+			createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+			createInfo.flags = 0;
+			createInfo.pNext = nullptr;
+			createInfo.pushConstantRangeCount = static_cast<uint32_t>(m_PushConstants.size());
+			createInfo.pPushConstantRanges = m_PushConstants.data();
+			createInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+			createInfo.pSetLayouts = setLayouts.data();
+
+			FLINT_VK_ASSERT(m_Device.getDeviceTable().vkCreatePipelineLayout(m_Device.getLogicalDevice(), &createInfo, nullptr, &m_PipelineLayout), "Failed to create the pipeline layout!");
+		}
+	}
+}
\ No newline at end of file
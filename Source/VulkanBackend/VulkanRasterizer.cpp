@@ -83,11 +83,23 @@ namespace Flint
 			// Begin the command buffer.
 			m_pCommandBuffers->finishExecution();
 
+			// The culling view changes every frame, even if the commands don't. The pipelines also request an update here if any of their variations
+			// finished compiling in the background.
+			for (auto& pPipeline : m_pPipelines)
+			{
+				pPipeline->updateVariations();
+				pPipeline->uploadCullingView(m_FrameIndex);
+			}
+
 			// Update everything ONLY if we have anything to update.
 			if (needToUpdate())
 			{
 				m_pCommandBuffers->begin();
 
+				// Cull the draws before the render pass.
+				for (auto& pPipeline : m_pPipelines)
+					pPipeline->cull(*m_pCommandBuffers, m_FrameIndex);
+
 				// Bind the rasterizer.
 				m_pCommandBuffers->bindRenderTarget(*this, m_ClearValues, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
 
@@ -107,6 +119,10 @@ namespace Flint
 				// Unbind the rasterizer.
 				m_pCommandBuffers->unbindRenderTarget();
 
+				// Build the depth pyramids which are used to cull the next frame.
+				for (const auto& pPipeline : m_pPipelines)
+					pPipeline->buildDepthPyramid(*m_pCommandBuffers, m_FrameIndex);
+
 				// End the command buffer.
 				m_pCommandBuffers->end();
 
@@ -158,6 +174,17 @@ namespace Flint
 			return *m_pAttachments[m_ExclusiveBuffering * m_FrameIndex][index];
 		}
 
+		const Flint::Backend::VulkanRenderTargetAttachment* VulkanRasterizer::getDepthAttachment(uint32_t frameIndex) const
+		{
+			for (const auto& pAttachment : m_pAttachments[m_ExclusiveBuffering * frameIndex])
+			{
+				if (pAttachment->getType() == AttachmentType::Depth)
+					return pAttachment.get();
+			}
+
+			return nullptr;
+		}
+
 		std::shared_ptr<Flint::Backend::RasterizingPipeline> VulkanRasterizer::createPipeline(const std::shared_ptr<RasterizingProgram>& pRasterizingProgram, const RasterizingPipelineSpecification& specification, std::unique_ptr<PipelineCacheHandler>&& pCacheHandler /*= nullptr*/)
 		{
 			OPTICK_EVENT();
@@ -3,6 +3,14 @@
 
 #include "Flint/VulkanBackend/VulkanRasterizingDrawEntry.hpp"
 #include "Flint/VulkanBackend/VulkanRasterizingPipeline.hpp"
+#include "Flint/VulkanBackend/VulkanStaticModel.hpp"
+
+#include "Flint/Backend/MeshOptimizer.hpp"
+#include "Flint/Core/Camera/Camera.hpp"
+
+#include <Optick.h>
+
+#include <algorithm>
 
 namespace Flint
 {
@@ -16,13 +24,62 @@ namespace Flint
 			instance.m_Rotation = rotation;
 			instance.m_Scale = scale;
 
+			// New instances use the full mesh until the levels are selected again.
+			for (auto& meshDrawer : m_MeshDrawers)
+			{
+				if (!meshDrawer.m_InstanceLevels.empty())
+					meshDrawer.m_InstanceLevels.emplace_back(0);
+			}
+
+			// The command buffers need to be recorded again to draw the new instance.
+			m_pPipeline->notifyRenderTarget();
+
 			return instance;
 		}
 
-		void VulkanRasterizingDrawEntry::registerMesh(uint64_t pipelineHash, uint64_t resourceHash)
+		void VulkanRasterizingDrawEntry::selectLevelsOfDetail(const Camera& camera, float threshold /*= 1.0f*/)
+		{
+			OPTICK_EVENT();
+
+			const auto& meshes = m_pEntity->as<VulkanStaticModel>()->getMeshes();
+
+			bool hasChanged = false;
+			for (uint64_t i = 0; i < m_MeshDrawers.size(); i++)
+			{
+				const auto& mesh = meshes[i];
+				auto& meshDrawer = m_MeshDrawers[i];
+				meshDrawer.m_InstanceLevels.resize(m_DrawInstances.size(), 0);
+
+				for (uint64_t j = 0; j < m_DrawInstances.size(); j++)
+				{
+					const auto& instance = m_DrawInstances[j];
+					const auto scale = std::max({ instance.m_Scale.x, instance.m_Scale.y, instance.m_Scale.z });
+
+					// The rotation is not applied to the bounding sphere, so we use a sphere around the instance's origin which contains it at any rotation.
+					const auto radius = (glm::length(mesh.m_BoundingCenter) + mesh.m_BoundingRadius) * scale;
+					const auto distance = glm::length(camera.m_Position - instance.m_Position) - radius;
+
+					uint8_t level = 0;
+					while (level + 1 < mesh.m_LevelsOfDetail.size() && MeshOptimizer::ProjectError(mesh.m_LevelsOfDetail[level + 1].m_Error * scale, distance, camera.m_FieldOfView, camera.getFrameHeight()) <= threshold)
+						level++;
+
+					if (meshDrawer.m_InstanceLevels[j] != level)
+					{
+						meshDrawer.m_InstanceLevels[j] = level;
+						hasChanged = true;
+					}
+				}
+			}
+
+			// The command buffers need to be recorded again to draw the new levels.
+			if (hasChanged)
+				m_pPipeline->notifyRenderTarget();
+		}
+
+		void VulkanRasterizingDrawEntry::registerMesh(uint64_t pipelineHash, uint64_t resourceHash, std::vector<uint32_t>&& dynamicOffsets /*= {}*/, std::vector<std::byte>&& constants /*= {}*/)
 		{
 			m_pPipeline->notifyRenderTarget();
-			m_MeshDrawers.emplace_back(pipelineHash, resourceHash);
+			m_MeshDrawers.emplace_back(std::move(dynamicOffsets), std::move(constants), pipelineHash, resourceHash);
 		}
 	}
 }
\ No newline at end of file
@@ -8,12 +8,22 @@
 #include "Flint/VulkanBackend/VulkanRasterizingDrawEntry.hpp"
 #include "Flint/VulkanBackend/VulkanStaticModel.hpp"
 #include "Flint/VulkanBackend/VulkanCommandBuffers.hpp"
+#include "Flint/VulkanBackend/VulkanComputeProgram.hpp"
+#include "Flint/VulkanBackend/VulkanCullingPass.hpp"
+
+#include "Flint/Core/Containers/WorkerGroup.hpp"
 
 #include <Optick.h>
 
 #define XXH_INLINE_ALL
 #include <xxhash.h>
 
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <bit>
+#include <map>
+
 #ifdef FLINT_PLATFORM_WINDOWS
 #	include <execution>
 
@@ -282,6 +292,81 @@ namespace /* anonymous */
 
 		return flags;
 	}
+
+	/**
+	 * Get the hash which identifies a pipeline variation.
+	 *
+	 * @param inputBindings The vertex input bindings of the variation.
+	 * @param inputAttributes The vertex input attributes of the variation.
+	 * @return The hash.
+	 */
+	uint64_t GetVariationHash(const std::vector<VkVertexInputBindingDescription>& inputBindings, const std::vector<VkVertexInputAttributeDescription>& inputAttributes)
+	{
+		const XXH64_hash_t hashes[] = {
+			XXH64(inputBindings.data(), sizeof(VkVertexInputBindingDescription) * inputBindings.size(), 0),
+			XXH64(inputAttributes.data(), sizeof(VkVertexInputAttributeDescription) * inputAttributes.size(), 0),
+		};
+
+		return static_cast<uint64_t>(XXH64(hashes, sizeof(hashes), 0));
+	}
+
+	/**
+	 * Get the hash of the specification members which change the pipelines.
+	 *
+	 * @param specification The pipeline specification.
+	 * @return The hash.
+	 */
+	uint64_t GetSpecificationHash(const Flint::Backend::RasterizingPipelineSpecification& specification)
+	{
+		std::vector<uint32_t> state;
+		for (const auto& attachment : specification.m_ColorBlendAttachments)
+		{
+			state.insert(state.end(), {
+				attachment.m_EnableBlend,
+				Flint::EnumToInt(attachment.m_SrcBlendFactor),
+				Flint::EnumToInt(attachment.m_DstBlendFactor),
+				Flint::EnumToInt(attachment.m_SrcAlphaBlendFactor),
+				Flint::EnumToInt(attachment.m_DstAlphaBlendFactor),
+				Flint::EnumToInt(attachment.m_BlendOperator),
+				Flint::EnumToInt(attachment.m_AlphaBlendOperator),
+				Flint::EnumToInt(attachment.m_ColorWriteMask)
+				});
+		}
+
+		for (const auto constant : specification.m_ColorBlendConstants)
+			state.emplace_back(std::bit_cast<uint32_t>(constant));
+
+		state.insert(state.end(), {
+			std::bit_cast<uint32_t>(specification.m_DepthBiasFactor),
+			std::bit_cast<uint32_t>(specification.m_DepthConstantFactor),
+			std::bit_cast<uint32_t>(specification.m_DepthSlopeFactor),
+			std::bit_cast<uint32_t>(specification.m_RasterizerLineWidth),
+			std::bit_cast<uint32_t>(specification.m_MinSampleShading),
+			specification.m_TessellationPatchControlPoints,
+			Flint::EnumToInt(specification.m_PrimitiveTopology),
+			Flint::EnumToInt(specification.m_CullMode),
+			Flint::EnumToInt(specification.m_FrontFace),
+			Flint::EnumToInt(specification.m_PolygonMode),
+			Flint::EnumToInt(specification.m_ColorBlendLogic),
+			Flint::EnumToInt(specification.m_DepthCompareLogic),
+			Flint::EnumToInt(specification.m_DynamicStateFlags),
+			specification.m_EnablePrimitiveRestart,
+			specification.m_EnableDepthBias,
+			specification.m_EnableDepthClamp,
+			specification.m_EnableRasterizerDiscard,
+			specification.m_EnableAlphaCoverage,
+			specification.m_EnableAlphaToOne,
+			specification.m_EnableSampleShading,
+			specification.m_EnableColorBlendLogic,
+			specification.m_EnableDepthTest,
+			specification.m_EnableDepthWrite
+			});
+
+		for (const auto& constant : specification.m_SpecializationConstants)
+			state.insert(state.end(), { static_cast<uint32_t>(XXH32(constant.m_Name.data(), constant.m_Name.size(), 0)), constant.m_ConstantID, constant.m_Value });
+
+		return static_cast<uint64_t>(XXH64(state.data(), sizeof(uint32_t) * state.size(), 0));
+	}
 }
 
 namespace Flint
@@ -293,14 +378,50 @@ namespace Flint
 			, m_DescriptorSetManager(pDevice, pRasterizer->getFrameCount())
 			, m_WorkerThread(&VulkanRasterizingPipeline::worker, this)
 			, m_pSecondaryCommandBuffers(pRasterizer->getCommandBuffers()->createChild())
+			, m_IndirectDraws(pRasterizer->getFrameCount())
 		{
 			OPTICK_EVENT();
 
 			// Setup the defaults.
 			setupDefaults(specification);
 
+			// Resolve the draw data push constant if the program uses it.
+			if (const auto pDrawData = pProgram->getBindingMap().findPushConstant(DrawDataPushConstant))
+			{
+				if (pDrawData->m_Size < sizeof(IndirectDrawData))
+					throw BackendError("The draw data push constant should be a uvec4!");
+
+				m_DrawDataOffset = pDrawData->m_Offset;
+			}
+
+			// The pipeline cache is identified by the shader code and the specification, so pipelines which share a cache handler don't overwrite each
+			// other's cache.
+			const XXH64_hash_t hashes[] = {
+				pProgram->getVertexShaderPath().getHash(),
+				pProgram->getFragmentShaderPath().getHash(),
+				GetSpecificationHash(specification)
+			};
+
+			m_Identifier = static_cast<uint64_t>(XXH64(hashes, sizeof(hashes), 0));
+			m_PipelineCache = loadCache(m_Identifier);
+
+			// The manifest is identified by everything which changes the pipelines except the vertex layout, which is what the manifest contains.
+			std::vector<uint32_t> renderPass = { EnumToInt(pRasterizer->getMultisample()) };
+			for (uint32_t i = 0; i < pRasterizer->getAttachmentCount(); i++)
+				renderPass.insert(renderPass.end(), { EnumToInt(pRasterizer->getAttachment(i).getType()), EnumToInt(pRasterizer->getAttachment(i).getFormat()) });
+
+			const XXH64_hash_t manifestHashes[] = {
+				m_Identifier,
+				XXH64(renderPass.data(), sizeof(uint32_t) * renderPass.size(), 0)
+			};
+
+			m_ManifestIdentifier = static_cast<uint64_t>(XXH64(manifestHashes, sizeof(manifestHashes), 0));
+
+			// Compile the variations the previous sessions used.
+			warmUp();
+
 			// Setup the descriptor set manager.
-			m_DescriptorSetManager.setup(pProgram->getLayoutBindings(), pProgram->getPoolSizes(), pProgram->getDescriptorSetLayout());
+			m_DescriptorSetManager.setup(pProgram->getLayoutBindings(), pProgram->getPoolSizes(), pProgram->getDescriptorSetLayout(), pProgram->getDescriptorUpdateTemplate(), pProgram->getTemplateBindings());
 
 			// Make sure to set the object as valid.
 			validate();
@@ -315,13 +436,27 @@ namespace Flint
 		{
 			OPTICK_EVENT();
 
+			// The background compilations use the pipeline, so they need to finish first.
+			waitForCompilations();
+
 			for (const auto& [hash, pipeline] : m_Pipelines)
-			{
-				saveCache(hash, pipeline.m_PipelineCache);
 				getDevice().as<VulkanDevice>()->getDeviceTable().vkDestroyPipeline(getDevice().as<VulkanDevice>()->getLogicalDevice(), pipeline.m_Pipeline, nullptr);
-				getDevice().as<VulkanDevice>()->getDeviceTable().vkDestroyPipelineCache(getDevice().as<VulkanDevice>()->getLogicalDevice(), pipeline.m_PipelineCache, nullptr);
+
+			saveCache(m_Identifier, m_PipelineCache);
+			getDevice().as<VulkanDevice>()->getDeviceTable().vkDestroyPipelineCache(getDevice().as<VulkanDevice>()->getLogicalDevice(), m_PipelineCache, nullptr);
+
+			for (auto& indirectDraws : m_IndirectDraws)
+			{
+				if (indirectDraws.m_pCommandBuffer)
+					indirectDraws.m_pCommandBuffer->terminate();
+
+				if (indirectDraws.m_pDrawDataBuffer)
+					indirectDraws.m_pDrawDataBuffer->terminate();
 			}
 
+			if (m_pCullingPass)
+				m_pCullingPass->destroy();
+
 			m_pSecondaryCommandBuffers->terminate();
 			m_DescriptorSetManager.destroy();
 			terminateWorker();
@@ -332,7 +467,17 @@ namespace Flint
 		{
 			OPTICK_EVENT();
 
-			// Recreate everything again.
+			// The depth pyramid depends on the size of the depth attachment.
+			if (m_pCullingPass)
+				m_pCullingPass->recreatePyramid();
+
+			// The extent is the only thing that changes, so the pipelines don't need to be recreated if the viewport and scissor are dynamic.
+			const auto dynamicStateFlags = getSpecification().m_DynamicStateFlags;
+			if (dynamicStateFlags & DynamicStateFlags::ViewPort && dynamicStateFlags & DynamicStateFlags::Scissor)
+				return;
+
+			// Recreate everything again. The variations which are being compiled use the previous state, so we wait till they are done and recreate them too.
+			waitForCompilations();
 			for (auto& [hash, pipeline] : m_Pipelines)
 			{
 				getDevice().as<VulkanDevice>()->getDeviceTable().vkDestroyPipeline(getDevice().as<VulkanDevice>()->getLogicalDevice(), pipeline.m_Pipeline, nullptr);
@@ -345,7 +490,7 @@ namespace Flint
 				inputState.pVertexBindingDescriptions = pipeline.m_InputBindings.data();
 				inputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(pipeline.m_InputAttributes.size());
 				inputState.pVertexAttributeDescriptions = pipeline.m_InputAttributes.data();
-				pipeline.m_Pipeline = createVariation(std::move(inputState), pipeline.m_PipelineCache);
+				pipeline.m_Pipeline = createVariation(std::move(inputState), m_PipelineCache);
 			}
 		}
 
@@ -359,11 +504,19 @@ namespace Flint
 
 			auto pEntry = std::make_shared<VulkanRasterizingDrawEntry>(pModel, shared_from_this());
 
+			std::vector<MeshBindingTable> bindingTables;
+			bindingTables.reserve(pStaticModel->getMeshes().size());
+
+			std::vector<uint64_t> pipelineHashes;
+			pipelineHashes.reserve(pStaticModel->getMeshes().size());
+
+			std::vector<uint64_t> newVariations;
+
 			// Iterate over the meshes and create the required pipelines.
 			for (const auto& mesh : pStaticModel->getMeshes())
 			{
 				// Prepare the required resources.
-				const auto bindingTable = binder(*pModel, mesh, bindingMap);
+				bindingTables.emplace_back(binder(*pModel, mesh, bindingMap));
 				const auto inputBindings = pStaticModel->getInputBindingDescriptions(mesh, vertexInputs);
 				const auto inputAttributes = pStaticModel->getInputAttributeDescriptions(mesh, vertexInputs);
 
@@ -372,56 +525,141 @@ namespace Flint
 					throw BackendError("The mesh does not contain all the vertex attributes this pipeline requires!");
 
 				// Generate the hash which is used to uniquely identify the pipeline.
-				const XXH64_hash_t hashes[] = {
-					XXH64(inputBindings.data(), sizeof(VkVertexInputBindingDescription) * inputBindings.size(), 0),
-					XXH64(inputAttributes.data(), sizeof(VkVertexInputAttributeDescription) * inputAttributes.size(), 0),
-				};
+				const auto pipelineHash = GetVariationHash(inputBindings, inputAttributes);
 
-				const auto pipelineHash = static_cast<uint64_t>(XXH64(hashes, sizeof(hashes), 0));
-
-				// Check and create the pipeline if not available.
-				if (!m_Pipelines.contains(pipelineHash))
+				// Register the pipeline if not available. The new variations are compiled together once all the meshes are processed.
 				{
-					Pipeline pipeline = {};
-					pipeline.m_InputBindings = inputBindings;
-					pipeline.m_InputAttributes = inputAttributes;
+					[[maybe_unused]] const auto lock = std::scoped_lock(m_PipelineMutex);
+					if (!m_Pipelines.contains(pipelineHash))
+					{
+						Pipeline pipeline = {};
+						pipeline.m_InputBindings = inputBindings;
+						pipeline.m_InputAttributes = inputAttributes;
 
-					VkPipelineVertexInputStateCreateInfo inputState = {};
-					inputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-					inputState.flags = 0;
-					inputState.pNext = nullptr;
-					inputState.vertexBindingDescriptionCount = static_cast<uint32_t>(pipeline.m_InputBindings.size());
-					inputState.pVertexBindingDescriptions = pipeline.m_InputBindings.data();
-					inputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(pipeline.m_InputAttributes.size());
-					inputState.pVertexAttributeDescriptions = pipeline.m_InputAttributes.data();
+						m_Pipelines[pipelineHash] = std::move(pipeline);
+						newVariations.emplace_back(pipelineHash);
+					}
+				}
 
-					pipeline.m_PipelineCache = loadCache(pipelineHash);
-					pipeline.m_Pipeline = createVariation(std::move(inputState), pipeline.m_PipelineCache);
-					saveCache(pipelineHash, pipeline.m_PipelineCache);
+				pipelineHashes.emplace_back(pipelineHash);
+			}
 
-					m_Pipelines[pipelineHash] = pipeline;
-				}
+			// Record the new variations and compile them.
+			if (!newVariations.empty())
+			{
+				saveManifest();
+
+				if (getSpecification().m_CompilationPolicy == PipelineCompilationPolicy::Background)
+				{
+					// Collect the finished tasks. This rethrows any error which was thrown while compiling them.
+					for (auto itr = m_CompilationTasks.begin(); itr != m_CompilationTasks.end();)
+					{
+						if (itr->wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+						{
+							++itr;
+							continue;
+						}
+
+						auto task = std::move(*itr);
+						itr = m_CompilationTasks.erase(itr);
+						task.get();
+					}
 
-				// Setup resources.
-				m_DescriptorSetManager.registerTable(bindingTable);
-				pEntry->registerMesh(pipelineHash, bindingTable.generateHash());
+					m_CompilationTasks.emplace_back(std::async(std::launch::async, [this, variations = std::move(newVariations)]
+						{
+							compileVariations(variations);
+							m_HasCompiledVariations = true;
+						}
+					));
+				}
+				else
+					compileVariations(newVariations);
 			}
 
+			// The variations which were registered before (like the ones being warmed up) might still be compiling.
+			if (getSpecification().m_CompilationPolicy == PipelineCompilationPolicy::Wait && std::any_of(pipelineHashes.begin(), pipelineHashes.end(), [this](uint64_t hash) { return getPipelineHandle(hash) == VK_NULL_HANDLE; }))
+				waitForCompilations();
+
+			// Setup resources. All the tables are registered at once to batch the descriptor set allocations and updates.
+			// Programs which only use bindless resources do not need per-mesh descriptor sets.
+			const auto hasDescriptors = !getProgram()->as<VulkanRasterizingProgram>()->getLayoutBindings().empty();
+			const auto resourceHashes = hasDescriptors ? m_DescriptorSetManager.registerTables(bindingTables) : std::vector<uint64_t>(bindingTables.size());
+			for (uint64_t i = 0; i < bindingTables.size(); i++)
+				pEntry->registerMesh(pipelineHashes[i], resourceHashes[i], m_DescriptorSetManager.getDynamicOffsets(bindingTables[i]), std::vector<std::byte>(bindingTables[i].getConstants()));
+
 			// Register the draw call callback.
-			m_DrawCalls.emplace_back([this, pEntry, vertexInputs, pStaticModel](const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex)
+			const auto entryIndex = static_cast<uint32_t>(m_pDrawEntries.size());
+			m_DrawCalls.emplace_back([this, pEntry, entryIndex, vertexInputs, pStaticModel, hasDescriptors](const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex)
 				{
 					commandBuffers.bindVertexBuffers(pStaticModel->getVertexStorage(), vertexInputs);
-					commandBuffers.bindIndexBuffer(pStaticModel->getIndexBufferHandle());
+
+					// The bindless descriptor set is shared by all the meshes so we only need to bind it once.
+					if (getProgram()->as<VulkanRasterizingProgram>()->usesBindless())
+						commandBuffers.bindBindlessDescriptor(this);
+
+					// The meshes can use different index types, so we only rebind the index buffer when the type changes.
+					bool isIndexBufferBound = false;
+					IndexType boundIndexType = IndexType::Uint32;
 
 					const auto& meshDrawers = pEntry->getMeshDrawers();
 					for (uint32_t i = 0; i < meshDrawers.size(); i++)
 					{
-						const auto meshDrawer = meshDrawers[i];
+						const auto& meshDrawer = meshDrawers[i];
 						const auto& mesh = pStaticModel->getMeshes()[i];
 
-						commandBuffers.bindRasterizingPipeline(getPipelineHandle(meshDrawer.m_PipelineHash));
-						commandBuffers.bindDescriptor(this, getDescriptorSetManager().getDescriptorSet(meshDrawers[i].m_ResourceHash, frameIndex));
-						commandBuffers.drawIndexed(mesh.m_IndexCount, mesh.m_IndexOffset, pEntry->getInstanceCount(), mesh.m_VertexOffset);
+						if (!isIndexBufferBound || boundIndexType != mesh.m_IndexType)
+						{
+							commandBuffers.bindIndexBuffer(pStaticModel->getIndexBufferHandle(), mesh.m_IndexType);
+							boundIndexType = mesh.m_IndexType;
+							isIndexBufferBound = true;
+						}
+
+						// Skip the meshes whose variation is still being compiled. They are drawn once the frames are recorded again.
+						const auto pipeline = getPipelineHandle(meshDrawer.m_PipelineHash);
+						if (pipeline == VK_NULL_HANDLE)
+							continue;
+
+						commandBuffers.bindRasterizingPipeline(pipeline);
+
+						if (hasDescriptors)
+							commandBuffers.bindDescriptor(this, getDescriptorSetManager().getDescriptorSet(meshDrawer.m_ResourceHash, frameIndex), meshDrawer.m_DynamicOffsets);
+
+						// Only the constants within the program's push constant range are pushed.
+						if (const auto range = getProgram()->as<VulkanRasterizingProgram>()->getPushConstantRange(meshDrawer.m_Constants.size()); range.size > 0)
+							commandBuffers.pushConstants(this, meshDrawer.m_Constants.data() + range.offset, range.size, range.offset);
+
+						// Push the draw data of a draw before issuing it.
+						const auto pushDrawData = [this, &commandBuffers, entryIndex, i](uint32_t firstInstance, uint32_t levelOfDetail)
+						{
+							if (!m_DrawDataOffset)
+								return;
+
+							const auto drawData = IndirectDrawData{ entryIndex, i, firstInstance, levelOfDetail };
+							commandBuffers.pushConstants(this, reinterpret_cast<const std::byte*>(&drawData), sizeof(IndirectDrawData), *m_DrawDataOffset);
+						};
+
+						// Draw the consecutive instances which use the same level of detail together.
+						if (meshDrawer.m_InstanceLevels.empty())
+						{
+							pushDrawData(0, 0);
+							commandBuffers.drawIndexed(mesh.m_IndexCount, mesh.m_IndexOffset, pEntry->getInstanceCount(), mesh.m_VertexOffset);
+							continue;
+						}
+
+						for (uint64_t first = 0; first < meshDrawer.m_InstanceLevels.size();)
+						{
+							const auto level = meshDrawer.m_InstanceLevels[first];
+
+							uint64_t last = first + 1;
+							while (last < meshDrawer.m_InstanceLevels.size() && meshDrawer.m_InstanceLevels[last] == level)
+								last++;
+
+							const auto& levelOfDetail = mesh.m_LevelsOfDetail[level];
+							pushDrawData(static_cast<uint32_t>(first), level);
+							commandBuffers.drawIndexed(levelOfDetail.m_IndexCount, mesh.m_IndexOffset + levelOfDetail.m_IndexOffset, last - first, mesh.m_VertexOffset, first);
+
+							first = last;
+						}
 					}
 				}
 			);
@@ -429,15 +667,60 @@ namespace Flint
 			return m_pDrawEntries.emplace_back(std::move(pEntry));
 		}
 
+		void VulkanRasterizingPipeline::updateVariations()
+		{
+			if (m_HasCompiledVariations.exchange(false))
+				notifyRenderTarget();
+		}
+
+		void VulkanRasterizingPipeline::waitForCompilations()
+		{
+			OPTICK_EVENT();
+
+			auto tasks = std::move(m_CompilationTasks);
+			m_CompilationTasks.clear();
+
+			// Wait for all of them before rethrowing, since the rest would still be using the pipeline.
+			for (const auto& task : tasks)
+				task.wait();
+
+			for (auto& task : tasks)
+				task.get();
+		}
+
+		void VulkanRasterizingPipeline::enableCulling(const std::shared_ptr<ComputeProgram>& pCullingProgram, const std::shared_ptr<ComputeProgram>& pDepthPyramidProgram)
+		{
+			OPTICK_EVENT();
+
+			// Make sure that the frames which use the previous pass are done.
+			getDevice().as<VulkanDevice>()->waitIdle();
+
+			m_pCullingPass = std::make_unique<VulkanCullingPass>(*this, std::static_pointer_cast<VulkanComputeProgram>(pCullingProgram), std::static_pointer_cast<VulkanComputeProgram>(pDepthPyramidProgram));
+			notifyRenderTarget();
+		}
+
+		void VulkanRasterizingPipeline::setCullingView(const glm::mat4& view, const glm::mat4& projection)
+		{
+			if (m_pCullingPass)
+				m_pCullingPass->setView(view, projection);
+		}
+
 		VkPipelineCache VulkanRasterizingPipeline::loadCache(uint64_t identifier) const
 		{
 			OPTICK_EVENT();
 
 			std::vector<std::byte> buffer;
 
-			// Load the cache if possible.
+			// Load the cache if possible. The variations can be compiled in parallel, and the handler is not required to be thread safe.
 			if (m_pCacheHandler)
+			{
+				[[maybe_unused]] const auto lock = std::scoped_lock(m_CacheMutex);
 				buffer = m_pCacheHandler->load(identifier);
+			}
+
+			// Data created by another device or driver version are discarded.
+			if (!getDevicePointerAs<VulkanDevice>()->isPipelineCacheCompatible(buffer))
+				buffer.clear();
 
 			// Create the pipeline cache.
 			VkPipelineCacheCreateInfo createInfo = {};
@@ -470,11 +753,15 @@ namespace Flint
 
 			// Store the cache if possible.
 			if (m_pCacheHandler)
+			{
+				[[maybe_unused]] const auto lock = std::scoped_lock(m_CacheMutex);
 				m_pCacheHandler->store(identifier, buffer);
+			}
 		}
 
 		void VulkanRasterizingPipeline::notifyRenderTarget()
 		{
+			m_DrawVersion++;
 			getRasterizer()->toggleNeedToUpdate();
 		}
 
@@ -496,14 +783,86 @@ namespace Flint
 			}
 		}
 
-		void VulkanRasterizingPipeline::issueDrawCalls(const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex) const
+		void VulkanRasterizingPipeline::issueDrawCalls(const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex)
 		{
 			OPTICK_EVENT();
 
+			// Set the dynamic viewport and scissor. The frames are recorded again when the extent changes, so the pipelines don't depend on it.
+			const auto dynamicStateFlags = getSpecification().m_DynamicStateFlags;
+			if (dynamicStateFlags & DynamicStateFlags::ViewPort)
+			{
+				VkViewport viewport = {};
+				viewport.width = static_cast<float>(m_pRasterizer->getWidth());
+				viewport.height = static_cast<float>(m_pRasterizer->getHeight());
+				viewport.maxDepth = 1.0f;
+				viewport.minDepth = 0.0f;
+				viewport.x = 0.0f;
+				viewport.y = 0.0f;
+
+				commandBuffers.setViewport(viewport);
+			}
+
+			if (dynamicStateFlags & DynamicStateFlags::Scissor)
+			{
+				VkRect2D scissor = {};
+				scissor.extent.width = m_pRasterizer->getWidth();
+				scissor.extent.height = m_pRasterizer->getHeight();
+				scissor.offset = { 0, 0 };
+
+				commandBuffers.setScissor(scissor);
+			}
+
+			if (isDrawnIndirectly())
+			{
+				// The indirect draws are already up to date if they were culled.
+				if (!isCulling())
+					updateIndirectDraws(frameIndex);
+
+				issueIndirectDrawCalls(commandBuffers, frameIndex);
+				return;
+			}
+
 			for (const auto& drawCall : m_DrawCalls)
 				drawCall(commandBuffers, frameIndex);
 		}
 
+		void VulkanRasterizingPipeline::uploadCullingView(uint32_t frameIndex)
+		{
+			if (isCulling())
+				m_pCullingPass->uploadView(frameIndex);
+		}
+
+		void VulkanRasterizingPipeline::cull(const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex)
+		{
+			OPTICK_EVENT();
+
+			if (!isCulling())
+				return;
+
+			updateIndirectDraws(frameIndex);
+			m_pCullingPass->cull(commandBuffers, frameIndex);
+		}
+
+		void VulkanRasterizingPipeline::buildDepthPyramid(const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex) const
+		{
+			if (isCulling())
+				m_pCullingPass->buildDepthPyramid(commandBuffers, frameIndex);
+		}
+
+		const VulkanBuffer* VulkanRasterizingPipeline::getDrawDataBuffer(uint32_t frameIndex) const
+		{
+			if (isCulling())
+				return m_pCullingPass->getDrawDataBuffer(frameIndex);
+
+			return m_IndirectDraws[frameIndex].m_pDrawDataBuffer.get();
+		}
+
+		VkPipeline VulkanRasterizingPipeline::getPipelineHandle(uint64_t identifier) const
+		{
+			[[maybe_unused]] const auto lock = std::scoped_lock(m_PipelineMutex);
+			return m_Pipelines.at(identifier).m_Pipeline;
+		}
+
 		void VulkanRasterizingPipeline::setupDefaults(const RasterizingPipelineSpecification& specification)
 		{
 			OPTICK_EVENT();
@@ -600,13 +959,64 @@ namespace Flint
 			m_DynamicStateCreateInfo.flags = 0;
 			m_DynamicStateCreateInfo.dynamicStateCount = static_cast<uint32_t>(m_DynamicStates.size());
 			m_DynamicStateCreateInfo.pDynamicStates = m_DynamicStates.data();
+
+			// Specialization constants. The named constants are resolved to their IDs, and a later value replaces an earlier one with the same ID.
+			const auto& reflectedConstants = getProgram()->as<VulkanRasterizingProgram>()->getSpecializationConstants();
+			std::map<uint32_t, uint32_t> specializationValues;
+			for (const auto& constant : specification.m_SpecializationConstants)
+			{
+				auto constantID = constant.m_ConstantID;
+				auto constantSize = static_cast<uint32_t>(sizeof(uint32_t));
+				if (!constant.m_Name.empty())
+				{
+					const auto itr = reflectedConstants.find(constant.m_Name);
+					if (itr == reflectedConstants.end())
+						throw BackendError("The program does not have a specialization constant with the given name!");
+
+					constantID = itr->second.m_ConstantID;
+					constantSize = itr->second.m_Size;
+				}
+				else
+				{
+					const auto itr = std::find_if(reflectedConstants.begin(), reflectedConstants.end(), [constantID](const auto& reflected) { return reflected.second.m_ConstantID == constantID; });
+					if (itr != reflectedConstants.end())
+						constantSize = itr->second.m_Size;
+				}
+
+				if (constantSize != sizeof(uint32_t))
+					throw BackendError("Only 32-bit specialization constants are supported!");
+
+				specializationValues[constantID] = constant.m_Value;
+			}
+
+			for (const auto [constantID, value] : specializationValues)
+			{
+				auto& entry = m_SpecializationMapEntries.emplace_back();
+				entry.constantID = constantID;
+				entry.offset = static_cast<uint32_t>(sizeof(uint32_t) * m_SpecializationData.size());
+				entry.size = sizeof(uint32_t);
+
+				m_SpecializationData.emplace_back(value);
+			}
+
+			if (!m_SpecializationMapEntries.empty())
+			{
+				m_SpecializationInfo.mapEntryCount = static_cast<uint32_t>(m_SpecializationMapEntries.size());
+				m_SpecializationInfo.pMapEntries = m_SpecializationMapEntries.data();
+				m_SpecializationInfo.dataSize = sizeof(uint32_t) * m_SpecializationData.size();
+				m_SpecializationInfo.pData = m_SpecializationData.data();
+
+				// Constants which a stage does not use are ignored, so all the stages can share the same info.
+				for (auto& stage : m_ShaderStageCreateInfo)
+					stage.pSpecializationInfo = &m_SpecializationInfo;
+			}
 		}
 
 		VkPipeline VulkanRasterizingPipeline::createVariation(VkPipelineVertexInputStateCreateInfo&& inputState, VkPipelineCache cache)
 		{
 			OPTICK_EVENT();
 
-			// Resolve viewport state.
+			// Resolve viewport state. These are ignored if the viewport and scissor are dynamic.
 			VkRect2D rect2D = {};
 			rect2D.extent.width = m_pRasterizer->getWidth();
 			rect2D.extent.height = m_pRasterizer->getHeight();
@@ -657,6 +1067,408 @@ namespace Flint
 			return pipeline;
 		}
 
+		void VulkanRasterizingPipeline::compileVariations(const std::vector<uint64_t>& identifiers)
+		{
+			OPTICK_EVENT();
+
+			WorkerGroup().parallelFor(identifiers.size(), [this, &identifiers](uint64_t i)
+				{
+					const auto identifier = identifiers[i];
+
+					// The entries are never removed and their input state is not changed after they are registered, so the pointer stays valid and we
+					// only need to lock when touching the map or the handles.
+					const Pipeline* pPipeline = nullptr;
+					{
+						[[maybe_unused]] const auto lock = std::scoped_lock(m_PipelineMutex);
+						pPipeline = &m_Pipelines.at(identifier);
+					}
+
+					VkPipelineVertexInputStateCreateInfo inputState = {};
+					inputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+					inputState.flags = 0;
+					inputState.pNext = nullptr;
+					inputState.vertexBindingDescriptionCount = static_cast<uint32_t>(pPipeline->m_InputBindings.size());
+					inputState.pVertexBindingDescriptions = pPipeline->m_InputBindings.data();
+					inputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(pPipeline->m_InputAttributes.size());
+					inputState.pVertexAttributeDescriptions = pPipeline->m_InputAttributes.data();
+
+					// The pipeline cache is internally synchronized, so all the variations can be compiled using it at the same time.
+					const auto pipeline = createVariation(std::move(inputState), m_PipelineCache);
+
+					[[maybe_unused]] const auto lock = std::scoped_lock(m_PipelineMutex);
+					m_Pipelines.at(identifier).m_Pipeline = pipeline;
+				}
+			);
+
+			// Save the cache so a crash later on does not lose it.
+			saveCache(m_Identifier, m_PipelineCache);
+		}
+
+		void VulkanRasterizingPipeline::warmUp()
+		{
+			OPTICK_EVENT();
+
+			if (!m_pCacheHandler)
+				return;
+
+			std::vector<std::byte> manifest;
+			{
+				[[maybe_unused]] const auto lock = std::scoped_lock(m_CacheMutex);
+				manifest = m_pCacheHandler->load(m_ManifestIdentifier);
+			}
+
+			// The manifest contains the variation count, followed by the binding count, attribute count, bindings and attributes of each variation.
+			// Reading stops at the first variation which does not fit, so a truncated manifest still warms up the variations before it.
+			auto pCurrent = manifest.data();
+			const auto pEnd = manifest.data() + manifest.size();
+			const auto read = [&pCurrent, pEnd](void* pData, uint64_t size)
+			{
+				if (static_cast<uint64_t>(pEnd - pCurrent) < size)
+					return false;
+
+				std::copy_n(pCurrent, size, static_cast<std::byte*>(pData));
+				pCurrent += size;
+				return true;
+			};
+
+			uint32_t variationCount = 0;
+			if (!read(&variationCount, sizeof(uint32_t)))
+				return;
+
+			std::vector<uint64_t> variations;
+			for (uint32_t i = 0; i < variationCount; i++)
+			{
+				uint32_t counts[2] = {};
+				if (!read(counts, sizeof(counts)))
+					break;
+
+				const auto bindingsSize = sizeof(VkVertexInputBindingDescription) * counts[0];
+				const auto attributesSize = sizeof(VkVertexInputAttributeDescription) * counts[1];
+				if (static_cast<uint64_t>(pEnd - pCurrent) < bindingsSize + attributesSize)
+					break;
+
+				Pipeline pipeline = {};
+				pipeline.m_InputBindings.resize(counts[0]);
+				pipeline.m_InputAttributes.resize(counts[1]);
+				read(pipeline.m_InputBindings.data(), bindingsSize);
+				read(pipeline.m_InputAttributes.data(), attributesSize);
+
+				const auto hash = GetVariationHash(pipeline.m_InputBindings, pipeline.m_InputAttributes);
+
+				[[maybe_unused]] const auto lock = std::scoped_lock(m_PipelineMutex);
+				if (!m_Pipelines.contains(hash))
+				{
+					m_Pipelines[hash] = std::move(pipeline);
+					variations.emplace_back(hash);
+				}
+			}
+
+			if (variations.empty())
+				return;
+
+			m_CompilationTasks.emplace_back(std::async(std::launch::async, [this, variations = std::move(variations)]
+				{
+					compileVariations(variations);
+					m_HasCompiledVariations = true;
+				}
+			));
+		}
+
+		void VulkanRasterizingPipeline::saveManifest() const
+		{
+			OPTICK_EVENT();
+
+			if (!m_pCacheHandler)
+				return;
+
+			std::vector<std::byte> manifest;
+			const auto write = [&manifest](const void* pData, uint64_t size)
+			{
+				const auto pBytes = static_cast<const std::byte*>(pData);
+				manifest.insert(manifest.end(), pBytes, pBytes + size);
+			};
+
+			{
+				[[maybe_unused]] const auto lock = std::scoped_lock(m_PipelineMutex);
+
+				const auto variationCount = static_cast<uint32_t>(m_Pipelines.size());
+				write(&variationCount, sizeof(uint32_t));
+
+				for (const auto& [hash, pipeline] : m_Pipelines)
+				{
+					const uint32_t counts[2] = { static_cast<uint32_t>(pipeline.m_InputBindings.size()), static_cast<uint32_t>(pipeline.m_InputAttributes.size()) };
+					write(counts, sizeof(counts));
+					write(pipeline.m_InputBindings.data(), sizeof(VkVertexInputBindingDescription) * pipeline.m_InputBindings.size());
+					write(pipeline.m_InputAttributes.data(), sizeof(VkVertexInputAttributeDescription) * pipeline.m_InputAttributes.size());
+				}
+			}
+
+			[[maybe_unused]] const auto lock = std::scoped_lock(m_CacheMutex);
+			m_pCacheHandler->store(m_ManifestIdentifier, manifest);
+		}
+
+		void VulkanRasterizingPipeline::updateIndirectDraws(uint32_t frameIndex)
+		{
+			OPTICK_EVENT();
+
+			auto& indirectDraws = m_IndirectDraws[frameIndex];
+			const auto version = m_DrawVersion.load();
+			if (indirectDraws.m_Version == version)
+				return;
+
+			indirectDraws.m_Version = version;
+
+			// Group the draws of all the meshes by the state they need to be bound.
+			std::vector<DrawBatch> batches;
+			std::vector<std::vector<VkDrawIndexedIndirectCommand>> batchCommands;
+			std::vector<std::vector<IndirectDrawData>> batchDrawData;
+			std::unordered_map<uint64_t, uint64_t> batchIndices;
+
+			for (uint32_t e = 0; e < m_pDrawEntries.size(); e++)
+			{
+				const auto pEntry = static_cast<const VulkanRasterizingDrawEntry*>(m_pDrawEntries[e].get());
+				const auto pStaticModel = pEntry->getEntity()->as<VulkanStaticModel>();
+				const auto instanceCount = pEntry->getInstanceCount();
+				if (instanceCount == 0)
+					continue;
+
+				const auto pVertexStorage = &pStaticModel->getVertexStorage();
+				const auto indexBuffer = pStaticModel->getIndexBufferHandle();
+
+				const auto& meshDrawers = pEntry->getMeshDrawers();
+				for (uint32_t i = 0; i < meshDrawers.size(); i++)
+				{
+					const auto& meshDrawer = meshDrawers[i];
+					const auto& mesh = pStaticModel->getMeshes()[i];
+
+					// Skip the meshes whose variation is still being compiled. The draw version changes once it's ready.
+					if (getPipelineHandle(meshDrawer.m_PipelineHash) == VK_NULL_HANDLE)
+						continue;
+
+					const XXH64_hash_t hashes[] = {
+						meshDrawer.m_PipelineHash,
+						meshDrawer.m_ResourceHash,
+						XXH64(meshDrawer.m_DynamicOffsets.data(), sizeof(uint32_t) * meshDrawer.m_DynamicOffsets.size(), 0),
+						XXH64(meshDrawer.m_Constants.data(), meshDrawer.m_Constants.size(), 0),
+						XXH64(&pVertexStorage, sizeof(pVertexStorage), 0),
+						XXH64(&indexBuffer, sizeof(indexBuffer), 0),
+						EnumToInt(mesh.m_IndexType)
+					};
+
+					const auto [itr, isNew] = batchIndices.try_emplace(static_cast<uint64_t>(XXH64(hashes, sizeof(hashes), 0)), batches.size());
+					if (isNew)
+					{
+						auto& batch = batches.emplace_back();
+						batch.m_DynamicOffsets = meshDrawer.m_DynamicOffsets;
+						batch.m_Constants = meshDrawer.m_Constants;
+						batch.m_pVertexStorage = pVertexStorage;
+						batch.m_IndexBuffer = indexBuffer;
+						batch.m_IndexType = mesh.m_IndexType;
+						batch.m_PipelineHash = meshDrawer.m_PipelineHash;
+						batch.m_ResourceHash = meshDrawer.m_ResourceHash;
+
+						batchCommands.emplace_back();
+						batchDrawData.emplace_back();
+					}
+
+					auto& commands = batchCommands[itr->second];
+					auto& drawData = batchDrawData[itr->second];
+					const auto addDraw = [&](const StaticMesh::LevelOfDetail& levelOfDetail, uint64_t firstInstance, uint64_t count, uint8_t level)
+					{
+						auto& command = commands.emplace_back();
+						command.indexCount = static_cast<uint32_t>(levelOfDetail.m_IndexCount);
+						command.instanceCount = static_cast<uint32_t>(count);
+						command.firstIndex = static_cast<uint32_t>(mesh.m_IndexOffset + levelOfDetail.m_IndexOffset);
+						command.vertexOffset = static_cast<int32_t>(mesh.m_VertexOffset);
+						command.firstInstance = static_cast<uint32_t>(firstInstance);
+
+						drawData.emplace_back(e, i, static_cast<uint32_t>(firstInstance), level);
+					};
+
+					// Draw the consecutive instances which use the same level of detail together.
+					if (meshDrawer.m_InstanceLevels.empty())
+					{
+						addDraw(StaticMesh::LevelOfDetail(0, mesh.m_IndexCount), 0, instanceCount, 0);
+						continue;
+					}
+
+					for (uint64_t first = 0; first < meshDrawer.m_InstanceLevels.size();)
+					{
+						const auto level = meshDrawer.m_InstanceLevels[first];
+
+						uint64_t last = first + 1;
+						while (last < meshDrawer.m_InstanceLevels.size() && meshDrawer.m_InstanceLevels[last] == level)
+							last++;
+
+						addDraw(mesh.m_LevelsOfDetail[level], first, last - first, level);
+						first = last;
+					}
+				}
+			}
+
+			// Order the batches by their pipeline and resources so we switch them as few times as possible when recording.
+			std::vector<uint64_t> order(batches.size());
+			std::iota(order.begin(), order.end(), 0);
+			std::sort(order.begin(), order.end(), [&batches](uint64_t lhs, uint64_t rhs)
+				{
+					return std::tie(batches[lhs].m_PipelineHash, batches[lhs].m_ResourceHash) < std::tie(batches[rhs].m_PipelineHash, batches[rhs].m_ResourceHash);
+				}
+			);
+
+			std::vector<VkDrawIndexedIndirectCommand> commands;
+			std::vector<IndirectDrawData> drawData;
+			indirectDraws.m_Batches.clear();
+			indirectDraws.m_Batches.reserve(batches.size());
+			for (const auto index : order)
+			{
+				auto& batch = indirectDraws.m_Batches.emplace_back(std::move(batches[index]));
+				batch.m_FirstDraw = commands.size();
+				batch.m_DrawCount = batchCommands[index].size();
+
+				commands.insert(commands.end(), batchCommands[index].begin(), batchCommands[index].end());
+				drawData.insert(drawData.end(), batchDrawData[index].begin(), batchDrawData[index].end());
+			}
+
+			// Upload the commands and the draw data. The buffers are only recreated if they are too small. These buffers are only used by this frame, which
+			// has already finished executing.
+			const auto uploadBuffer = [this](std::shared_ptr<VulkanBuffer>& pBuffer, const void* pData, uint64_t size)
+			{
+				if (size == 0)
+					return;
+
+				if (!pBuffer || pBuffer->getSize() < size)
+				{
+					if (pBuffer)
+						pBuffer->terminate();
+
+					pBuffer = std::static_pointer_cast<VulkanBuffer>(getDevice().createBuffer(size, BufferUsage::Indirect));
+				}
+
+				pBuffer->copyFrom(static_cast<const std::byte*>(pData), size);
+			};
+
+			uploadBuffer(indirectDraws.m_pCommandBuffer, commands.data(), commands.size() * sizeof(VkDrawIndexedIndirectCommand));
+			uploadBuffer(indirectDraws.m_pDrawDataBuffer, drawData.data(), drawData.size() * sizeof(IndirectDrawData));
+
+			if (!isCulling())
+				return;
+
+			// Create a culling item for each instance of each command. Each batch reserves space for all of it's instances in the culled buffers, since
+			// each visible instance is drawn using it's own command. A single indirect draw is limited by the device, so the batch's culled commands are
+			// split into chunks which have their own draw counts.
+			const auto maxDrawCount = static_cast<uint64_t>(getDevice().as<VulkanDevice>()->getPhysicalDeviceProperties().limits.maxDrawIndirectCount);
+
+			std::vector<CullingItem> items;
+			uint64_t countSlots = 0;
+			for (auto& batch : indirectDraws.m_Batches)
+			{
+				batch.m_FirstCulledDraw = items.size();
+				batch.m_FirstCountSlot = countSlots;
+
+				for (uint64_t d = batch.m_FirstDraw; d < batch.m_FirstDraw + batch.m_DrawCount; d++)
+				{
+					const auto& data = drawData[d];
+					const auto pEntry = m_pDrawEntries[data.m_EntryIndex].get();
+					const auto& mesh = pEntry->getEntity()->as<VulkanStaticModel>()->getMeshes()[data.m_MeshIndex];
+
+					for (uint32_t i = data.m_FirstInstance; i < data.m_FirstInstance + commands[d].instanceCount; i++)
+					{
+						const auto& instance = pEntry->getDrawInstances()[i];
+						const auto scale = std::max({ instance.m_Scale.x, instance.m_Scale.y, instance.m_Scale.z });
+
+						const auto chunk = (items.size() - batch.m_FirstCulledDraw) / maxDrawCount;
+
+						// The rotation is not applied to the bounding sphere, so we use a sphere around the instance's origin which contains it at any rotation.
+						auto& item = items.emplace_back();
+						item.m_BoundingSphere = glm::vec4(instance.m_Position, (glm::length(mesh.m_BoundingCenter) + mesh.m_BoundingRadius) * scale);
+						item.m_Draw = static_cast<uint32_t>(d);
+						item.m_Instance = i;
+						item.m_Batch = static_cast<uint32_t>(batch.m_FirstCountSlot + chunk);
+						item.m_FirstOutput = static_cast<uint32_t>(batch.m_FirstCulledDraw + chunk * maxDrawCount);
+					}
+				}
+
+				batch.m_CulledDrawCount = items.size() - batch.m_FirstCulledDraw;
+				countSlots += (batch.m_CulledDrawCount + maxDrawCount - 1) / maxDrawCount;
+			}
+
+			m_pCullingPass->update(frameIndex, items, static_cast<uint32_t>(countSlots), indirectDraws.m_pCommandBuffer.get(), indirectDraws.m_pDrawDataBuffer.get());
+		}
+
+		void VulkanRasterizingPipeline::issueIndirectDrawCalls(const VulkanCommandBuffers& commandBuffers, uint32_t frameIndex) const
+		{
+			OPTICK_EVENT();
+
+			const auto& indirectDraws = m_IndirectDraws[frameIndex];
+			if (indirectDraws.m_Batches.empty())
+				return;
+
+			const auto pProgram = getProgram()->as<VulkanRasterizingProgram>();
+			const auto& vertexInputs = pProgram->getVertexInputs();
+			const auto hasDescriptors = !pProgram->getLayoutBindings().empty();
+			const auto maxDrawCount = static_cast<uint64_t>(getDevice().as<VulkanDevice>()->getPhysicalDeviceProperties().limits.maxDrawIndirectCount);
+
+			// The bindless descriptor set is shared by all the meshes so we only need to bind it once.
+			if (pProgram->usesBindless())
+				commandBuffers.bindBindlessDescriptor(this);
+
+			// Only bind the state which changes between two batches.
+			const DrawBatch* pPreviousBatch = nullptr;
+			const auto culling = isCulling();
+			for (const auto& batch : indirectDraws.m_Batches)
+			{
+				if (!pPreviousBatch || pPreviousBatch->m_pVertexStorage != batch.m_pVertexStorage)
+					commandBuffers.bindVertexBuffers(*batch.m_pVertexStorage, vertexInputs);
+
+				if (!pPreviousBatch || pPreviousBatch->m_IndexBuffer != batch.m_IndexBuffer || pPreviousBatch->m_IndexType != batch.m_IndexType)
+					commandBuffers.bindIndexBuffer(batch.m_IndexBuffer, batch.m_IndexType);
+
+				if (!pPreviousBatch || pPreviousBatch->m_PipelineHash != batch.m_PipelineHash)
+					commandBuffers.bindRasterizingPipeline(getPipelineHandle(batch.m_PipelineHash));
+
+				if (hasDescriptors)
+					commandBuffers.bindDescriptor(this, getDescriptorSetManager().getDescriptorSet(batch.m_ResourceHash, frameIndex), batch.m_DynamicOffsets);
+
+				if (const auto range = pProgram->getPushConstantRange(batch.m_Constants.size()); range.size > 0)
+					commandBuffers.pushConstants(this, batch.m_Constants.data() + range.offset, range.size, range.offset);
+
+				// The culled commands are drawn using the draw counts the culling shader wrote for each chunk of the batch.
+				if (culling)
+				{
+					uint64_t countSlot = batch.m_FirstCountSlot;
+					for (uint64_t first = 0; first < batch.m_CulledDrawCount; first += maxDrawCount)
+					{
+						const auto offset = (batch.m_FirstCulledDraw + first) * sizeof(VkDrawIndexedIndirectCommand);
+						commandBuffers.drawIndexedIndirectCount(m_pCullingPass->getCommandBuffer(frameIndex)->getBuffer(), offset, m_pCullingPass->getCountBuffer(frameIndex)->getBuffer(), countSlot * sizeof(uint32_t), std::min(maxDrawCount, batch.m_CulledDrawCount - first));
+						countSlot++;
+					}
+				}
+
+				// The draw count of a single indirect draw is limited by the device.
+				else
+				{
+					for (uint64_t first = 0; first < batch.m_DrawCount; first += maxDrawCount)
+					{
+						const auto offset = (batch.m_FirstDraw + first) * sizeof(VkDrawIndexedIndirectCommand);
+						commandBuffers.drawIndexedIndirect(indirectDraws.m_pCommandBuffer->getBuffer(), offset, std::min(maxDrawCount, batch.m_DrawCount - first));
+					}
+				}
+
+				pPreviousBatch = &batch;
+			}
+		}
+
+		bool VulkanRasterizingPipeline::isDrawnIndirectly() const
+		{
+			return !m_DrawDataOffset && getDevice().as<VulkanDevice>()->isMultiDrawIndirectSupported();
+		}
+
+		bool VulkanRasterizingPipeline::isCulling() const
+		{
+			// Draw indirect count is only enabled if multi draw indirect is supported.
+			return m_pCullingPass && isDrawnIndirectly() && getDevice().as<VulkanDevice>()->isDrawIndirectCountSupported();
+		}
+
 		void VulkanRasterizingPipeline::worker()
 		{
 			OPTICK_THREAD("Rasterizing Pipeline Worker");
@@ -33,10 +33,13 @@ namespace Flint
 
 			std::vector<std::byte> buffer;
 
-			// Load the cache if possible.
+			// Load the cache if possible. Data created by another device or driver version are discarded.
 			if (m_pCacheHandler)
 				buffer = m_pCacheHandler->load(identifier);
 
+			if (!getDevicePointerAs<VulkanDevice>()->isPipelineCacheCompatible(buffer))
+				buffer.clear();
+
 			// Create the pipeline cache.
 			VkPipelineCacheCreateInfo createInfo = {};
 			createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
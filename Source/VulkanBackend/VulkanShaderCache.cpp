@@ -0,0 +1,624 @@
+// Copyright 2021-2022 Dhiraj Wishal
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Flint/VulkanBackend/VulkanShaderCache.hpp"
+#include "Flint/VulkanBackend/VulkanDevice.hpp"
+#include "Flint/VulkanBackend/VulkanMacros.hpp"
+
+#include <Optick.h>
+#include <spirv_reflect.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace /* anonymous */
+{
+	constexpr uint32_t ReflectionCacheVersion = 1;
+
+	/**
+	 * Validate the reflection result.
+	 *
+	 * @param result The reflection result.
+	 */
+	void ValidateReflection(const SpvReflectResult result)
+	{
+		switch (result)
+		{
+		case SPV_REFLECT_RESULT_SUCCESS:										return;
+		case SPV_REFLECT_RESULT_NOT_READY:										spdlog::error("Shader not ready!"); break;
+		case SPV_REFLECT_RESULT_ERROR_PARSE_FAILED:								spdlog::error("Shader parse failed!"); break;
+		case SPV_REFLECT_RESULT_ERROR_ALLOC_FAILED:								spdlog::error("Shader allocation failed!"); break;
+		case SPV_REFLECT_RESULT_ERROR_RANGE_EXCEEDED:							spdlog::error("Shader range exceeded!"); break;
+		case SPV_REFLECT_RESULT_ERROR_NULL_POINTER:								spdlog::error("Shader null pointer!"); break;
+		case SPV_REFLECT_RESULT_ERROR_INTERNAL_ERROR:							spdlog::error("Shader internal reflection error!"); break;
+		case SPV_REFLECT_RESULT_ERROR_COUNT_MISMATCH:							spdlog::error("Shader count mismatch!"); break;
+		case SPV_REFLECT_RESULT_ERROR_ELEMENT_NOT_FOUND:						spdlog::error("Shader element not found!"); break;
+		case SPV_REFLECT_RESULT_ERROR_SPIRV_INVALID_CODE_SIZE:					spdlog::error("Shader invalid SPIRV code size!"); break;
+		case SPV_REFLECT_RESULT_ERROR_SPIRV_INVALID_MAGIC_NUMBER:				spdlog::error("Shader invalid SPIRV magic number!"); break;
+		case SPV_REFLECT_RESULT_ERROR_SPIRV_UNEXPECTED_EOF:						spdlog::error("Shader SPIRV unexpected end of file (EOF)!"); break;
+		case SPV_REFLECT_RESULT_ERROR_SPIRV_INVALID_ID_REFERENCE:				spdlog::error("Shader invalid SPIRV ID reference!"); break;
+		case SPV_REFLECT_RESULT_ERROR_SPIRV_SET_NUMBER_OVERFLOW:				spdlog::error("Shader invalid SPIRV descriptor set number overflow!"); break;
+		case SPV_REFLECT_RESULT_ERROR_SPIRV_INVALID_STORAGE_CLASS:				spdlog::error("Shader invalid SPIRV storage class!"); break;
+		case SPV_REFLECT_RESULT_ERROR_SPIRV_RECURSION:							spdlog::error("Shader invalid SPIRV recursion!"); break;
+		case SPV_REFLECT_RESULT_ERROR_SPIRV_INVALID_INSTRUCTION:				spdlog::error("Shader invalid SPIRV instruction!"); break;
+		case SPV_REFLECT_RESULT_ERROR_SPIRV_UNEXPECTED_BLOCK_DATA:				spdlog::error("Shader invalid SPIRV block data!"); break;
+		case SPV_REFLECT_RESULT_ERROR_SPIRV_INVALID_BLOCK_MEMBER_REFERENCE:		spdlog::error("Shader invalid SPIRV block member reference!"); break;
+		case SPV_REFLECT_RESULT_ERROR_SPIRV_INVALID_ENTRY_POINT:				spdlog::error("Shader invalid SPIRV entry point!"); break;
+		case SPV_REFLECT_RESULT_ERROR_SPIRV_INVALID_EXECUTION_MODE:				spdlog::error("Shader invalid SPIRV execution mode!"); break;
+		default:																spdlog::error("Unknown reflection error!");
+		}
+	}
+
+	/**
+	 * Get the descriptor type from the reflection type.
+	 *
+	 * @param type The reflection type.
+	 * @return The descriptor type.
+	 */
+	VkDescriptorType GetDescriptorType(SpvReflectDescriptorType type)
+	{
+		switch (type)
+		{
+		case SPV_REFLECT_DESCRIPTOR_TYPE_SAMPLER:								return VK_DESCRIPTOR_TYPE_SAMPLER;
+		case SPV_REFLECT_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:				return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		case SPV_REFLECT_DESCRIPTOR_TYPE_SAMPLED_IMAGE:							return VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+		case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_IMAGE:							return VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:					return VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+		case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:					return VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+		case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER:						return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER:						return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:				return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:				return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+		case SPV_REFLECT_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:						return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+		case SPV_REFLECT_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:			return VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+		default:																spdlog::error("Invalid resource type!"); return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		}
+	}
+
+	/**
+	 * Get the Vulkan format from the reflection format.
+	 *
+	 * @param format The reflection format.
+	 * @return The Vulkan format.
+	 */
+	VkFormat GetFormat(SpvReflectFormat format)
+	{
+		// Thankfully the SPIRV-Reflect format is the same as the Vulkan format so we can simply static cast it.
+		return static_cast<VkFormat>(format);
+	}
+
+	/**
+	 * Reflect the named specialization constants of a shader.
+	 * The instructions are walked directly since we need the ID, name and type of each constant.
+	 *
+	 * @param code The SPIR-V code.
+	 * @return The specialization constants.
+	 */
+	std::vector<Flint::Backend::ShaderReflection::SpecializationConstant> ReflectSpecializationConstants(const std::vector<uint32_t>& code)
+	{
+		constexpr uint64_t HeaderSize = 5;
+		constexpr uint32_t OpName = 5;
+		constexpr uint32_t OpTypeBool = 20;
+		constexpr uint32_t OpTypeInt = 21;
+		constexpr uint32_t OpTypeFloat = 22;
+		constexpr uint32_t OpSpecConstantTrue = 48;
+		constexpr uint32_t OpSpecConstantFalse = 49;
+		constexpr uint32_t OpSpecConstant = 50;
+		constexpr uint32_t OpDecorate = 71;
+		constexpr uint32_t DecorationSpecId = 1;
+
+		std::unordered_map<uint32_t, std::string> names;
+		std::unordered_map<uint32_t, uint32_t> typeSizes;
+		std::unordered_map<uint32_t, uint32_t> constantTypes;
+		std::unordered_map<uint32_t, uint32_t> constantIDs;
+
+		for (uint64_t i = HeaderSize; i < code.size();)
+		{
+			const auto wordCount = code[i] >> 16;
+			const auto opCode = code[i] & 0xffff;
+			if (wordCount == 0 || i + wordCount > code.size())
+				break;
+
+			const auto pOperands = code.data() + i + 1;
+			switch (opCode)
+			{
+			case OpName:
+				if (wordCount >= 3)
+				{
+					const auto pName = reinterpret_cast<const char*>(pOperands + 1);
+					names[pOperands[0]] = std::string(pName, std::find(pName, pName + sizeof(uint32_t) * (wordCount - 2), '\0'));
+				}
+				break;
+
+			case OpTypeBool:
+				if (wordCount >= 2)
+					typeSizes[pOperands[0]] = sizeof(VkBool32);
+				break;
+
+			case OpTypeInt:
+			case OpTypeFloat:
+				if (wordCount >= 3)
+					typeSizes[pOperands[0]] = pOperands[1] / 8;
+				break;
+
+			case OpSpecConstantTrue:
+			case OpSpecConstantFalse:
+			case OpSpecConstant:
+				if (wordCount >= 3)
+					constantTypes[pOperands[1]] = pOperands[0];
+				break;
+
+			case OpDecorate:
+				if (wordCount >= 4 && pOperands[1] == DecorationSpecId)
+					constantIDs[pOperands[0]] = pOperands[2];
+				break;
+
+			default:
+				break;
+			}
+
+			i += wordCount;
+		}
+
+		std::vector<Flint::Backend::ShaderReflection::SpecializationConstant> constants;
+		for (const auto [resultID, constantID] : constantIDs)
+		{
+			const auto name = names.find(resultID);
+			const auto type = constantTypes.find(resultID);
+			if (name == names.end() || name->second.empty() || type == constantTypes.end())
+				continue;
+
+			auto& constant = constants.emplace_back();
+			constant.m_Name = name->second;
+			constant.m_ConstantID = constantID;
+			constant.m_Size = typeSizes.contains(type->second) ? typeSizes.at(type->second) : sizeof(uint32_t);
+		}
+
+		return constants;
+	}
+
+	/**
+	 * Reflection writer structure.
+	 * This appends the values to a byte buffer, in the order they are written.
+	 */
+	struct ReflectionWriter final
+	{
+		/**
+		 * Write a trivially copyable value.
+		 *
+		 * @tparam Type The value type.
+		 * @param value The value to write.
+		 */
+		template<class Type>
+		void write(const Type& value)
+		{
+			const auto pBegin = reinterpret_cast<const std::byte*>(&value);
+			m_Bytes.insert(m_Bytes.end(), pBegin, pBegin + sizeof(Type));
+		}
+
+		/**
+		 * Write a vector of trivially copyable values, prefixed by it's size.
+		 *
+		 * @tparam Type The value type.
+		 * @param values The values to write.
+		 */
+		template<class Type>
+		void writeVector(const std::vector<Type>& values)
+		{
+			write(static_cast<uint32_t>(values.size()));
+
+			const auto pBegin = reinterpret_cast<const std::byte*>(values.data());
+			m_Bytes.insert(m_Bytes.end(), pBegin, pBegin + sizeof(Type) * values.size());
+		}
+
+		/**
+		 * Write a string, prefixed by it's size.
+		 *
+		 * @param string The string to write.
+		 */
+		void writeString(const std::string& string)
+		{
+			write(static_cast<uint32_t>(string.size()));
+
+			const auto pBegin = reinterpret_cast<const std::byte*>(string.data());
+			m_Bytes.insert(m_Bytes.end(), pBegin, pBegin + string.size());
+		}
+
+		std::vector<std::byte> m_Bytes;
+	};
+
+	/**
+	 * Reflection reader structure.
+	 * This reads the values in the order they were written by the reflection writer. Each read fails instead of reading past the end of the data.
+	 */
+	struct ReflectionReader final
+	{
+		/**
+		 * Read a trivially copyable value.
+		 *
+		 * @tparam Type The value type.
+		 * @param value The value to read to.
+		 * @return Whether or not the value was read.
+		 */
+		template<class Type>
+		[[nodiscard]] bool read(Type& value)
+		{
+			if (m_Bytes.size() - m_Offset < sizeof(Type))
+				return false;
+
+			std::memcpy(&value, m_Bytes.data() + m_Offset, sizeof(Type));
+			m_Offset += sizeof(Type);
+			return true;
+		}
+
+		/**
+		 * Read a vector of trivially copyable values.
+		 *
+		 * @tparam Type The value type.
+		 * @param values The vector to read to.
+		 * @return Whether or not the values were read.
+		 */
+		template<class Type>
+		[[nodiscard]] bool readVector(std::vector<Type>& values)
+		{
+			uint32_t count = 0;
+			if (!read(count) || count > (m_Bytes.size() - m_Offset) / sizeof(Type))
+				return false;
+
+			values.resize(count);
+			std::memcpy(values.data(), m_Bytes.data() + m_Offset, sizeof(Type) * count);
+			m_Offset += sizeof(Type) * count;
+			return true;
+		}
+
+		/**
+		 * Read a string.
+		 *
+		 * @param string The string to read to.
+		 * @return Whether or not the string was read.
+		 */
+		[[nodiscard]] bool readString(std::string& string)
+		{
+			uint32_t size = 0;
+			if (!read(size) || size > m_Bytes.size() - m_Offset)
+				return false;
+
+			string.assign(reinterpret_cast<const char*>(m_Bytes.data() + m_Offset), size);
+			m_Offset += size;
+			return true;
+		}
+
+		const std::vector<std::byte>& m_Bytes;
+		uint64_t m_Offset = 0;
+	};
+
+	/**
+	 * Serialize a shader reflection.
+	 *
+	 * @param reflection The reflection.
+	 * @param stage The shader stage.
+	 * @return The serialized bytes.
+	 */
+	std::vector<std::byte> SerializeReflection(const Flint::Backend::ShaderReflection& reflection, VkShaderStageFlagBits stage)
+	{
+		ReflectionWriter writer;
+		writer.write(ReflectionCacheVersion);
+		writer.write(stage);
+		writer.write(reflection.m_WorkGroupSize);
+		writer.writeVector(reflection.m_VertexInputs);
+		writer.writeVector(reflection.m_InstanceInputs);
+
+		writer.write(static_cast<uint32_t>(reflection.m_Bindings.size()));
+		for (const auto& binding : reflection.m_Bindings)
+		{
+			writer.writeString(binding.m_Name);
+			writer.write(binding.m_Set);
+			writer.write(binding.m_Binding);
+			writer.write(binding.m_Count);
+			writer.write(binding.m_Type);
+		}
+
+		writer.write(static_cast<uint32_t>(reflection.m_PushConstantBlocks.size()));
+		for (const auto& block : reflection.m_PushConstantBlocks)
+		{
+			writer.write(block.m_Offset);
+			writer.write(block.m_Size);
+			writer.write(static_cast<uint32_t>(block.m_Members.size()));
+			for (const auto& member : block.m_Members)
+			{
+				writer.writeString(member.m_Name);
+				writer.write(member.m_Offset);
+				writer.write(member.m_Size);
+			}
+		}
+
+		writer.write(static_cast<uint32_t>(reflection.m_SpecializationConstants.size()));
+		for (const auto& constant : reflection.m_SpecializationConstants)
+		{
+			writer.writeString(constant.m_Name);
+			writer.write(constant.m_ConstantID);
+			writer.write(constant.m_Size);
+		}
+
+		return std::move(writer.m_Bytes);
+	}
+
+	/**
+	 * Deserialize a shader reflection.
+	 *
+	 * @param bytes The serialized bytes.
+	 * @param stage The shader stage.
+	 * @param reflection The reflection to deserialize to.
+	 * @return Whether or not the bytes contained a valid reflection of the same version and stage.
+	 */
+	bool DeserializeReflection(const std::vector<std::byte>& bytes, VkShaderStageFlagBits stage, Flint::Backend::ShaderReflection& reflection)
+	{
+		ReflectionReader reader{ bytes };
+
+		uint32_t version = 0;
+		VkShaderStageFlagBits storedStage = {};
+		if (!reader.read(version) || version != ReflectionCacheVersion || !reader.read(storedStage) || storedStage != stage)
+			return false;
+
+		if (!reader.read(reflection.m_WorkGroupSize) || !reader.readVector(reflection.m_VertexInputs) || !reader.readVector(reflection.m_InstanceInputs))
+			return false;
+
+		uint32_t bindingCount = 0;
+		if (!reader.read(bindingCount))
+			return false;
+
+		for (uint32_t i = 0; i < bindingCount; i++)
+		{
+			auto& binding = reflection.m_Bindings.emplace_back();
+			if (!reader.readString(binding.m_Name) || !reader.read(binding.m_Set) || !reader.read(binding.m_Binding) || !reader.read(binding.m_Count) || !reader.read(binding.m_Type))
+				return false;
+		}
+
+		uint32_t blockCount = 0;
+		if (!reader.read(blockCount))
+			return false;
+
+		for (uint32_t i = 0; i < blockCount; i++)
+		{
+			auto& block = reflection.m_PushConstantBlocks.emplace_back();
+
+			uint32_t memberCount = 0;
+			if (!reader.read(block.m_Offset) || !reader.read(block.m_Size) || !reader.read(memberCount))
+				return false;
+
+			for (uint32_t j = 0; j < memberCount; j++)
+			{
+				auto& member = block.m_Members.emplace_back();
+				if (!reader.readString(member.m_Name) || !reader.read(member.m_Offset) || !reader.read(member.m_Size))
+					return false;
+			}
+		}
+
+		uint32_t constantCount = 0;
+		if (!reader.read(constantCount))
+			return false;
+
+		for (uint32_t i = 0; i < constantCount; i++)
+		{
+			auto& constant = reflection.m_SpecializationConstants.emplace_back();
+			if (!reader.readString(constant.m_Name) || !reader.read(constant.m_ConstantID) || !reader.read(constant.m_Size))
+				return false;
+		}
+
+		return reader.m_Offset == bytes.size();
+	}
+
+	/**
+	 * Reflect a shader.
+	 *
+	 * @param shader The shader code.
+	 * @param stage The shader stage.
+	 * @return The shader reflection.
+	 */
+	Flint::Backend::ShaderReflection ReflectShader(const Flint::Backend::ShaderCode& shader, VkShaderStageFlagBits stage)
+	{
+		OPTICK_EVENT();
+
+		const auto& shaderCode = shader.get();
+		Flint::Backend::ShaderReflection reflection = {};
+
+		SpvReflectShaderModule reflectionModule = {};
+		ValidateReflection(spvReflectCreateShaderModule(shaderCode.size() * sizeof(uint32_t), shaderCode.data(), &reflectionModule));
+
+		// Resolve shader inputs.
+		if (stage == VK_SHADER_STAGE_VERTEX_BIT)
+		{
+			uint32_t variableCount = 0;
+			ValidateReflection(spvReflectEnumerateInputVariables(&reflectionModule, &variableCount, nullptr));
+
+			std::vector<SpvReflectInterfaceVariable*> pInputs(variableCount);
+			ValidateReflection(spvReflectEnumerateInputVariables(&reflectionModule, &variableCount, pInputs.data()));
+
+			// Iterate through the attributes and load them.
+			for (auto& pResource : pInputs)
+			{
+				if (pResource->format == SpvReflectFormat::SPV_REFLECT_FORMAT_UNDEFINED || pResource->built_in != -1)
+					continue;
+
+				// Store the input as a vertex input if the location is in the vertex attribute range. 
+				if (pResource->location < Flint::EnumToInt(Flint::VertexAttribute::Max))
+				{
+					auto& input = reflection.m_VertexInputs.emplace_back();
+					input.m_Components = std::max(pResource->type_description->traits.numeric.vector.component_count, 1u);
+					input.m_Attribute = static_cast<Flint::VertexAttribute>(pResource->location);
+				}
+
+				// If not and if the location is within the instance attribute range, it's considered to be an instance input.
+				else if (pResource->location < Flint::EnumToInt(Flint::InstanceAttribute::Max))
+				{
+					auto& input = reflection.m_InstanceInputs.emplace_back();
+					input.m_Components = std::max(pResource->type_description->traits.numeric.vector.component_count, 1u);
+					input.m_Attribute = static_cast<Flint::InstanceAttribute>(pResource->location);
+				}
+
+				//  Else we throw an error.
+				else
+					throw Flint::BackendError("Invalid Vertex shader input found!");
+			}
+		}
+
+		// Resolve the work group size.
+		else if (stage == VK_SHADER_STAGE_COMPUTE_BIT)
+		{
+			const auto pEntryPoint = spvReflectGetEntryPoint(&reflectionModule, "main");
+			if (!pEntryPoint)
+				throw Flint::BackendError("The compute shader does not have a main entry point!");
+
+			reflection.m_WorkGroupSize[0] = std::max(pEntryPoint->local_size.x, 1u);
+			reflection.m_WorkGroupSize[1] = std::max(pEntryPoint->local_size.y, 1u);
+			reflection.m_WorkGroupSize[2] = std::max(pEntryPoint->local_size.z, 1u);
+		}
+
+		// Load all the layout bindings.
+		{
+			uint32_t variableCount = 0;
+			ValidateReflection(spvReflectEnumerateDescriptorBindings(&reflectionModule, &variableCount, nullptr));
+
+			std::vector<SpvReflectDescriptorBinding*> pBindings(variableCount);
+			ValidateReflection(spvReflectEnumerateDescriptorBindings(&reflectionModule, &variableCount, pBindings.data()));
+
+			for (const auto& pResource : pBindings)
+			{
+				auto& binding = reflection.m_Bindings.emplace_back();
+				binding.m_Name = pResource->name ? pResource->name : "";
+				binding.m_Set = pResource->set;
+				binding.m_Binding = pResource->binding;
+				binding.m_Count = pResource->count;
+				binding.m_Type = GetDescriptorType(pResource->descriptor_type);
+			}
+		}
+
+		// Resolve push constants.
+		{
+			uint32_t variableCount = 0;
+			ValidateReflection(spvReflectEnumeratePushConstantBlocks(&reflectionModule, &variableCount, nullptr));
+
+			std::vector<SpvReflectBlockVariable*> pPushConstants(variableCount);
+			ValidateReflection(spvReflectEnumeratePushConstantBlocks(&reflectionModule, &variableCount, pPushConstants.data()));
+
+			for (const auto& resource : pPushConstants)
+			{
+				auto& block = reflection.m_PushConstantBlocks.emplace_back();
+				block.m_Offset = resource->offset;
+				block.m_Size = resource->size;
+
+				for (uint32_t i = 0; i < resource->member_count; i++)
+				{
+					const auto& member = resource->members[i];
+					if (member.name)
+						block.m_Members.emplace_back(member.name, member.absolute_offset, member.size);
+				}
+			}
+		}
+
+		spvReflectDestroyShaderModule(&reflectionModule);
+
+		// Resolve specialization constants.
+		reflection.m_SpecializationConstants = ReflectSpecializationConstants(shaderCode);
+
+		return reflection;
+	}
+}
+
+namespace Flint
+{
+	namespace Backend
+	{
+		void VulkanShaderCache::destroy()
+		{
+			OPTICK_EVENT();
+
+			[[maybe_unused]] const auto lock = std::scoped_lock(m_Mutex);
+			for (const auto& [hash, shaderModule] : m_Modules)
+				m_Device.getDeviceTable().vkDestroyShaderModule(m_Device.getLogicalDevice(), shaderModule.m_Module, nullptr);
+
+			m_Modules.clear();
+			m_Reflections.clear();
+		}
+
+		std::shared_ptr<const ShaderReflection> VulkanShaderCache::getReflection(const ShaderCode& shader, VkShaderStageFlagBits stage)
+		{
+			OPTICK_EVENT();
+
+			const auto hash = shader.getHash();
+			{
+				[[maybe_unused]] const auto lock = std::scoped_lock(m_Mutex);
+				if (const auto itr = m_Reflections.find(hash); itr != m_Reflections.end())
+					return itr->second;
+			}
+
+			// Try loading the reflection stored by a previous session, and reflect the shader if there isn't a valid one.
+			const auto pCacheHandler = m_Device.getShaderCacheHandler();
+			auto pReflection = std::make_shared<ShaderReflection>();
+
+			bool isCached = false;
+			if (pCacheHandler)
+			{
+				[[maybe_unused]] const auto lock = std::scoped_lock(m_HandlerMutex);
+				isCached = DeserializeReflection(pCacheHandler->load(hash), stage, *pReflection);
+			}
+
+			if (!isCached)
+			{
+				*pReflection = ReflectShader(shader, stage);
+
+				if (pCacheHandler)
+				{
+					[[maybe_unused]] const auto lock = std::scoped_lock(m_HandlerMutex);
+					pCacheHandler->store(hash, SerializeReflection(*pReflection, stage));
+				}
+			}
+
+			// Another program might have reflected the same shader in the meantime, in which case we use theirs.
+			[[maybe_unused]] const auto lock = std::scoped_lock(m_Mutex);
+			return m_Reflections.try_emplace(hash, std::move(pReflection)).first->second;
+		}
+
+		VkShaderModule VulkanShaderCache::acquireModule(const ShaderCode& shader)
+		{
+			OPTICK_EVENT();
+
+			[[maybe_unused]] const auto lock = std::scoped_lock(m_Mutex);
+			if (const auto itr = m_Modules.find(shader.getHash()); itr != m_Modules.end())
+			{
+				itr->second.m_ReferenceCount++;
+				return itr->second.m_Module;
+			}
+
+			VkShaderModuleCreateInfo createInfo = {};
+			createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+			createInfo.flags = 0;
+			createInfo.pNext = nullptr;
+			createInfo.codeSize = shader.getSize() * sizeof(uint32_t);
+			createInfo.pCode = shader.get().data();
+
+			VkShaderModule shaderModule = VK_NULL_HANDLE;
+			FLINT_VK_ASSERT(m_Device.getDeviceTable().vkCreateShaderModule(m_Device.getLogicalDevice(), &createInfo, nullptr, &shaderModule), "Failed to create the shader module!");
+
+			m_Modules[shader.getHash()] = ShaderModule{ shaderModule, 1 };
+			return shaderModule;
+		}
+
+		void VulkanShaderCache::releaseModule(uint64_t hash)
+		{
+			OPTICK_EVENT();
+
+			[[maybe_unused]] const auto lock = std::scoped_lock(m_Mutex);
+			const auto itr = m_Modules.find(hash);
+			if (itr == m_Modules.end())
+				return;
+
+			if (--itr->second.m_ReferenceCount == 0)
+			{
+				m_Device.getDeviceTable().vkDestroyShaderModule(m_Device.getLogicalDevice(), itr->second.m_Module, nullptr);
+				m_Modules.erase(itr);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -4,51 +4,76 @@
 #include "Flint/VulkanBackend/VulkanStaticModel.hpp"
 #include "Flint/VulkanBackend/VulkanMacros.hpp"
 #include "Flint/VulkanBackend/VulkanTexture2D.hpp"
+#include "Flint/VulkanBackend/VulkanCommandBuffers.hpp"
+
+#include "Flint/Backend/VertexQuantization.hpp"
+#include "Flint/Backend/MeshOptimizer.hpp"
+#include "Flint/Backend/CookedStaticModel.hpp"
+#include "Flint/Backend/GLTFLoader.hpp"
 
 #include "Flint/Core/Errors/AssetError.hpp"
-#include "Flint/Core/Containers/Bytes.hpp"
+#include "Flint/Core/Containers/MappedFile.hpp"
+#include "Flint/Core/Containers/WorkerGroup.hpp"
 
 #include <Optick.h>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
+#include <spdlog/spdlog.h>
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
 
+#include <algorithm>
 #include <atomic>
-#include <future>
+#include <cstring>
+#include <limits>
+#include <numeric>
 #include <sstream>
 
 namespace /* anonymous */
 {
 	/**
-	 * Static mesh storage structure.
-	 * This container temporarily stores all the static mesh's data.
+	 * Invalid attribute offset.
+	 * Attributes which are not in the interleaved vertex layout have this as their offset.
 	 */
-	struct StaticMeshStorage final
-	{
-		std::array<std::shared_ptr<Flint::Backend::VulkanBuffer>, AI_MAX_NUMBER_OF_TEXTURECOORDS> m_pTextureBuffers{ nullptr };
-		std::array<std::shared_ptr<Flint::Backend::VulkanBuffer>, AI_MAX_NUMBER_OF_COLOR_SETS> m_pColorBuffers{ nullptr };
+	constexpr uint32_t InvalidAttributeOffset = -1;
 
-		std::shared_ptr<Flint::Backend::VulkanBuffer> m_pNormalBuffer = nullptr;
-		std::shared_ptr<Flint::Backend::VulkanBuffer> m_pPositionBuffer = nullptr;
-		std::shared_ptr<Flint::Backend::VulkanBuffer> m_pTangentBuffer = nullptr;
-		std::shared_ptr<Flint::Backend::VulkanBuffer> m_pBiTangentBuffer = nullptr;
-	};
+	/**
+	 * The maximum number of levels of detail of a mesh, including the full mesh.
+	 */
+	constexpr uint8_t MaxLevelsOfDetail = 5;
+
+	/**
+	 * The minimum number of indices a level of detail can have.
+	 */
+	constexpr uint64_t MinLevelOfDetailIndices = 64 * 3;
+
+	/**
+	 * The maximum simplification error of a single level of detail, relative to the mesh's bounding radius.
+	 */
+	constexpr float MaxLevelOfDetailError = 0.05f;
 
 	/**
 	 * Get the Vulkan format from the attribute.
 	 *
 	 * @param attribute The attribute to get the format from.
+	 * @param profile The vertex format profile.
 	 * @return The format.
 	 */
-	VkFormat GetAttributeFormat(Flint::VertexAttribute attribute)
+	VkFormat GetAttributeFormat(Flint::VertexAttribute attribute, Flint::VertexFormatProfile profile)
 	{
+		const bool isQuantized = profile == Flint::VertexFormatProfile::Quantized;
+
 		switch (attribute)
 		{
 		case Flint::VertexAttribute::Position:
+			return isQuantized ? VK_FORMAT_R16G16B16A16_UNORM : VK_FORMAT_R32G32B32_SFLOAT;
+
 		case Flint::VertexAttribute::Normal:
 		case Flint::VertexAttribute::Tangent:
 		case Flint::VertexAttribute::BiTangent:
-			return VK_FORMAT_R32G32B32_SFLOAT;
+			return isQuantized ? VK_FORMAT_R16G16_SNORM : VK_FORMAT_R32G32B32_SFLOAT;
 
 		case Flint::VertexAttribute::Color0:
 		case Flint::VertexAttribute::Color1:
@@ -58,7 +83,7 @@ namespace /* anonymous */
 		case Flint::VertexAttribute::Color5:
 		case Flint::VertexAttribute::Color6:
 		case Flint::VertexAttribute::Color7:
-			return VK_FORMAT_R32G32B32A32_SFLOAT;
+			return isQuantized ? VK_FORMAT_R8G8B8A8_UNORM : VK_FORMAT_R32G32B32A32_SFLOAT;
 
 		case Flint::VertexAttribute::Texture0:
 		case Flint::VertexAttribute::Texture1:
@@ -68,13 +93,283 @@ namespace /* anonymous */
 		case Flint::VertexAttribute::Texture5:
 		case Flint::VertexAttribute::Texture6:
 		case Flint::VertexAttribute::Texture7:
-			return VK_FORMAT_R32G32_SFLOAT;
+			return isQuantized ? VK_FORMAT_R16G16_SFLOAT : VK_FORMAT_R32G32_SFLOAT;
 
 		default:
 			throw Flint::BackendError("Invalid attribute type!");
 		}
 	}
 
+	/**
+	 * Get the stride of an attribute.
+	 *
+	 * @param attribute The attribute to get the stride of.
+	 * @param profile The vertex format profile.
+	 * @return The stride in bytes.
+	 */
+	uint8_t GetAttributeStride(Flint::VertexAttribute attribute, Flint::VertexFormatProfile profile)
+	{
+		switch (GetAttributeFormat(attribute, profile))
+		{
+		case VK_FORMAT_R32G32B32_SFLOAT:
+			return sizeof(aiVector3D);
+
+		case VK_FORMAT_R32G32B32A32_SFLOAT:
+			return sizeof(aiColor4D);
+
+		case VK_FORMAT_R32G32_SFLOAT:
+			return sizeof(aiVector2D);
+
+		case VK_FORMAT_R16G16B16A16_UNORM:
+			return sizeof(uint16_t) * 4;
+
+		default:
+			return sizeof(uint32_t);
+		}
+	}
+
+	/**
+	 * Vertex source structure.
+	 * This points to the vertex data of a single mesh, independent of what it was loaded with. Each attribute is stored as tightly packed floats, with 3 components
+	 * per position, normal, tangent and bi-tangent, 4 per color and at least 2 per texture coordinate.
+	 */
+	struct VertexSource final
+	{
+		std::array<float*, Flint::EnumToInt(Flint::VertexAttribute::Max)> m_pAttributes = {};	// This is nullptr if the attribute is not present.
+		std::array<uint8_t, Flint::EnumToInt(Flint::VertexAttribute::Max)> m_ComponentCounts = {};
+		uint64_t m_VertexCount = 0;
+	};
+
+	/**
+	 * Get the vertex source of an Assimp mesh.
+	 *
+	 * @param pMesh The Assimp mesh pointer.
+	 * @return The vertex source.
+	 */
+	VertexSource GetVertexSource(aiMesh* pMesh)
+	{
+		VertexSource source;
+		source.m_VertexCount = pMesh->mNumVertices;
+
+		const auto setAttribute = [&source](Flint::VertexAttribute attribute, float* pData, uint8_t components)
+		{
+			source.m_pAttributes[Flint::EnumToInt(attribute)] = pData;
+			source.m_ComponentCounts[Flint::EnumToInt(attribute)] = components;
+		};
+
+		if (pMesh->HasPositions())
+			setAttribute(Flint::VertexAttribute::Position, &pMesh->mVertices->x, 3);
+
+		if (pMesh->HasNormals())
+			setAttribute(Flint::VertexAttribute::Normal, &pMesh->mNormals->x, 3);
+
+		if (pMesh->HasTangentsAndBitangents())
+		{
+			setAttribute(Flint::VertexAttribute::Tangent, &pMesh->mTangents->x, 3);
+			setAttribute(Flint::VertexAttribute::BiTangent, &pMesh->mBitangents->x, 3);
+		}
+
+		// Assimp stores the texture coordinates as 3D vectors.
+		for (uint8_t c = 0; c < 8; c++)
+		{
+			if (pMesh->HasVertexColors(c))
+				setAttribute(static_cast<Flint::VertexAttribute>(Flint::EnumToInt(Flint::VertexAttribute::Color0) + c), &pMesh->mColors[c]->r, 4);
+
+			if (pMesh->HasTextureCoords(c))
+				setAttribute(static_cast<Flint::VertexAttribute>(Flint::EnumToInt(Flint::VertexAttribute::Texture0) + c), &pMesh->mTextureCoords[c]->x, 3);
+		}
+
+		return source;
+	}
+
+	/**
+	 * Check if a glTF primitive contains a given attribute.
+	 * Tangents are generated if the primitive has normals and texture coordinates, and bi-tangents are derived from the normals and tangents.
+	 *
+	 * @param primitive The glTF primitive.
+	 * @param attribute The attribute to check.
+	 * @return Whether the attribute is present or not.
+	 */
+	bool HasAttribute(const Flint::Backend::GLTF::Primitive& primitive, Flint::VertexAttribute attribute)
+	{
+		const auto hasAccessor = [&primitive](Flint::VertexAttribute attribute) { return primitive.m_Attributes[Flint::EnumToInt(attribute)].isValid(); };
+		const bool canGenerateTangents = hasAccessor(Flint::VertexAttribute::Normal) && hasAccessor(Flint::VertexAttribute::Texture0);
+
+		switch (attribute)
+		{
+		case Flint::VertexAttribute::Tangent:
+			return hasAccessor(Flint::VertexAttribute::Tangent) || canGenerateTangents;
+
+		case Flint::VertexAttribute::BiTangent:
+			return (hasAccessor(Flint::VertexAttribute::Tangent) && hasAccessor(Flint::VertexAttribute::Normal)) || canGenerateTangents;
+
+		default:
+			return hasAccessor(attribute);
+		}
+	}
+
+	/**
+	 * Copy a single attribute of a mesh to the destination memory.
+	 *
+	 * @param source The mesh's vertex source.
+	 * @param attribute The attribute to copy.
+	 * @param pDestination The destination memory pointer.
+	 * @param destinationStride The number of bytes between two consecutive elements in the destination memory.
+	 */
+	void CopyAttribute(const VertexSource& source, Flint::VertexAttribute attribute, std::byte* pDestination, uint32_t destinationStride)
+	{
+		const auto index = Flint::EnumToInt(attribute);
+		const auto stride = GetAttributeStride(attribute, Flint::VertexFormatProfile::Full);
+		const auto sourceStride = source.m_ComponentCounts[index] * sizeof(float);
+		const auto pSource = reinterpret_cast<const std::byte*>(source.m_pAttributes[index]);
+
+		// If the data are tightly packed, we can copy everything at once.
+		if (destinationStride == stride && sourceStride == stride)
+		{
+			std::copy_n(pSource, source.m_VertexCount * stride, pDestination);
+			return;
+		}
+
+		// Else we only copy the components we need, which also drops the third component of Assimp's texture coordinates.
+		for (uint64_t v = 0; v < source.m_VertexCount; v++)
+			std::copy_n(pSource + v * sourceStride, stride, pDestination + v * destinationStride);
+	}
+
+	/**
+	 * Quantize a single attribute of a mesh to the destination memory.
+	 *
+	 * @param source The mesh's vertex source.
+	 * @param attribute The attribute to quantize.
+	 * @param pDestination The destination memory pointer.
+	 * @param destinationStride The number of bytes between two consecutive elements in the destination memory.
+	 * @param minimum The minimum corner of the mesh's bounding box.
+	 * @param maximum The maximum corner of the mesh's bounding box.
+	 */
+	void QuantizeAttribute(const VertexSource& source, Flint::VertexAttribute attribute, std::byte* pDestination, uint32_t destinationStride, const std::array<float, 3>& minimum, const std::array<float, 3>& maximum)
+	{
+		const auto index = Flint::EnumToInt(attribute);
+		const auto pSource = source.m_pAttributes[index];
+
+		switch (attribute)
+		{
+		case Flint::VertexAttribute::Position:
+			Flint::Backend::VertexQuantization::QuantizePositions(pSource, source.m_VertexCount, minimum, maximum, pDestination, destinationStride);
+			break;
+
+		case Flint::VertexAttribute::Normal:
+		case Flint::VertexAttribute::Tangent:
+		case Flint::VertexAttribute::BiTangent:
+			Flint::Backend::VertexQuantization::EncodeOctahedral(pSource, source.m_VertexCount, pDestination, destinationStride);
+			break;
+
+		default:
+			if (index >= Flint::EnumToInt(Flint::VertexAttribute::Texture0))
+				Flint::Backend::VertexQuantization::ConvertToHalf2(pSource, source.m_VertexCount, source.m_ComponentCounts[index], pDestination, destinationStride);
+			else
+				Flint::Backend::VertexQuantization::ConvertToUnorm8x4(pSource, source.m_VertexCount, pDestination, destinationStride);
+
+			break;
+		}
+	}
+
+	/**
+	 * Remap the elements of an array.
+	 *
+	 * @param pArray The array to remap.
+	 * @param components The number of floats in a single element.
+	 * @param remapTable The remap table. The new index of the element i is table[i].
+	 */
+	void RemapArray(float* pArray, uint32_t components, const std::vector<uint32_t>& remapTable)
+	{
+		const auto elements = std::vector<float>(pArray, pArray + remapTable.size() * components);
+
+		for (uint32_t i = 0; i < remapTable.size(); i++)
+			std::copy_n(elements.data() + i * components, components, pArray + static_cast<uint64_t>(remapTable[i]) * components);
+	}
+
+	/**
+	 * Remap all the vertex attributes of a mesh.
+	 *
+	 * @param source The mesh's vertex source.
+	 * @param remapTable The remap table. The new index of the vertex i is table[i].
+	 */
+	void RemapVertices(const VertexSource& source, const std::vector<uint32_t>& remapTable)
+	{
+		OPTICK_EVENT();
+
+		for (uint8_t a = 0; a < Flint::EnumToInt(Flint::VertexAttribute::Max); a++)
+		{
+			if (source.m_pAttributes[a])
+				RemapArray(source.m_pAttributes[a], source.m_ComponentCounts[a], remapTable);
+		}
+	}
+
+	/**
+	 * Generate the tangents and bi-tangents of a mesh from it's texture coordinates.
+	 * The per-triangle tangent frames are accumulated to the vertices, and orthogonalized against the vertex normals.
+	 *
+	 * @param indices The triangle list indices.
+	 * @param pPositions The vertex positions. Each position is 3 floats.
+	 * @param pNormals The vertex normals. Each normal is 3 floats.
+	 * @param pTextureCoordinates The vertex texture coordinates. Each coordinate is 2 floats.
+	 * @param vertexCount The number of vertices.
+	 * @param pTangents The tangent storage. Each tangent is 3 floats.
+	 * @param pBiTangents The bi-tangent storage. Each bi-tangent is 3 floats.
+	 */
+	void GenerateTangents(const std::vector<uint32_t>& indices, const float* pPositions, const float* pNormals, const float* pTextureCoordinates, uint64_t vertexCount, float* pTangents, float* pBiTangents)
+	{
+		OPTICK_EVENT();
+
+		std::vector<glm::vec3> tangents(vertexCount);
+		std::vector<glm::vec3> biTangents(vertexCount);
+
+		const auto getPosition = [pPositions](uint32_t index) { return glm::vec3(pPositions[index * 3], pPositions[index * 3 + 1], pPositions[index * 3 + 2]); };
+		const auto getCoordinate = [pTextureCoordinates](uint32_t index) { return glm::vec2(pTextureCoordinates[index * 2], pTextureCoordinates[index * 2 + 1]); };
+
+		for (uint64_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			const auto a = indices[i], b = indices[i + 1], c = indices[i + 2];
+
+			const auto firstEdge = getPosition(b) - getPosition(a);
+			const auto secondEdge = getPosition(c) - getPosition(a);
+			const auto firstDelta = getCoordinate(b) - getCoordinate(a);
+			const auto secondDelta = getCoordinate(c) - getCoordinate(a);
+
+			// Skip the triangles with degenerate texture coordinates.
+			const auto determinant = firstDelta.x * secondDelta.y - secondDelta.x * firstDelta.y;
+			if (std::abs(determinant) < std::numeric_limits<float>::epsilon())
+				continue;
+
+			const auto tangent = (firstEdge * secondDelta.y - secondEdge * firstDelta.y) / determinant;
+			const auto biTangent = (secondEdge * firstDelta.x - firstEdge * secondDelta.x) / determinant;
+
+			for (const auto index : { a, b, c })
+			{
+				tangents[index] += tangent;
+				biTangents[index] += biTangent;
+			}
+		}
+
+		for (uint64_t v = 0; v < vertexCount; v++)
+		{
+			const auto normal = glm::vec3(pNormals[v * 3], pNormals[v * 3 + 1], pNormals[v * 3 + 2]);
+
+			// Gram-Schmidt orthogonalize the frame. Vertices without a valid frame get an arbitrary one perpendicular to the normal.
+			auto tangent = tangents[v] - normal * glm::dot(normal, tangents[v]);
+			if (glm::dot(tangent, tangent) < std::numeric_limits<float>::epsilon())
+				tangent = std::abs(normal.x) < 0.9f ? glm::cross(normal, glm::vec3(1.0f, 0.0f, 0.0f)) : glm::cross(normal, glm::vec3(0.0f, 1.0f, 0.0f));
+
+			tangent = glm::normalize(tangent);
+
+			auto biTangent = glm::cross(normal, tangent);
+			if (glm::dot(biTangent, biTangents[v]) < 0.0f)
+				biTangent = -biTangent;
+
+			std::copy_n(&tangent.x, 3, pTangents + v * 3);
+			std::copy_n(&biTangent.x, 3, pBiTangents + v * 3);
+		}
+	}
+
 	/**
 	 * GEt the texture path from the material.
 	 *
@@ -96,101 +391,169 @@ namespace /* anonymous */
 	}
 
 	/**
-	 * Load the static mesh data from the aiMesh.
+	 * Generate the levels of detail of a mesh.
+	 * Each level is simplified from the previous one to half of its triangles, until either the maximum level count is reached, the error gets too large
+	 * or the mesh cannot be simplified any further.
 	 *
-	 * @param pMesh The Assimp mesh pointer.
-	 * @param pScene th Assimp scene pointer.
-	 * @param mesh The mesh to load the data to.
-	 * @param meshStorage The mesh storage to load all the data to.
-	 * @param device The device to load the data to.
-	 * @param vertexOffset The vertex offset of the current mesh.
-	 * @param indices The index storage.
-	 * @param indicesMutex The mutex used to lock the index storage.
-	 * @param basePath The base path to load the assets from.
+	 * @param source The mesh's vertex source. The positions must be present.
+	 * @param mesh The mesh to store the levels in. The bounding radius must be set.
+	 * @param indices The mesh's indices. The levels' indices are appended to it.
 	 */
-	void LoadStaticMesh(const aiMesh* pMesh, const aiScene* pScene, Flint::Backend::StaticMesh& mesh, StaticMeshStorage& meshStorage, Flint::Backend::VulkanDevice& device, uint64_t vertexOffset, std::vector<uint32_t>& indices, std::mutex& indicesMutex, const std::filesystem::path& basePath)
+	void GenerateLevelsOfDetail(const VertexSource& source, Flint::Backend::StaticMesh& mesh, std::vector<uint32_t>& indices)
 	{
 		OPTICK_EVENT();
 
-		mesh.m_Name = pMesh->mName.C_Str();
-		mesh.m_VertexCount = pMesh->mNumVertices;
-		mesh.m_VertexOffset = vertexOffset;
+		const auto pPositions = source.m_pAttributes[Flint::EnumToInt(Flint::VertexAttribute::Position)];
+		const auto maximumError = mesh.m_BoundingRadius * MaxLevelOfDetailError;
 
-		// Load the normals if possible.
-		if (pMesh->HasNormals())
+		auto previousIndices = indices;
+		float previousError = 0.0f;
+		for (uint8_t level = 1; level < MaxLevelsOfDetail; level++)
 		{
-			auto& normalData = mesh.m_VertexData[EnumToInt(Flint::VertexAttribute::Normal)];
+			const auto targetIndexCount = previousIndices.size() / 6 * 3;
+			if (targetIndexCount < MinLevelOfDetailIndices)
+				break;
 
-			normalData.m_Stride = sizeof(aiVector3D);
-			normalData.m_Size = pMesh->mNumVertices * sizeof(aiVector3D);
-			meshStorage.m_pNormalBuffer = std::static_pointer_cast<Flint::Backend::VulkanBuffer>(device.createBuffer(normalData.m_Size, Flint::BufferUsage::Staging, reinterpret_cast<const std::byte*>(pMesh->mNormals)));
-		}
+			float error = 0.0f;
+			auto levelIndices = Flint::Backend::MeshOptimizer::Simplify(previousIndices, pPositions, source.m_VertexCount, targetIndexCount, maximumError, &error);
 
-		// Load the positions if possible.
-		if (pMesh->HasPositions())
-		{
-			auto& vertexData = mesh.m_VertexData[EnumToInt(Flint::VertexAttribute::Position)];
+			// Stop if the level does not reduce enough triangles to be worth it.
+			if (levelIndices.size() * 4 > previousIndices.size() * 3)
+				break;
+
+			Flint::Backend::MeshOptimizer::OptimizeVertexCache(levelIndices, source.m_VertexCount);
+
+			// The levels are simplified from each other, so the errors accumulate.
+			previousError += error;
+			mesh.m_LevelsOfDetail.emplace_back(indices.size(), levelIndices.size(), previousError);
 
-			vertexData.m_Stride = sizeof(aiVector3D);
-			vertexData.m_Size = pMesh->mNumVertices * sizeof(aiVector3D);
-			meshStorage.m_pPositionBuffer = std::static_pointer_cast<Flint::Backend::VulkanBuffer>(device.createBuffer(vertexData.m_Size, Flint::BufferUsage::Staging, reinterpret_cast<const std::byte*>(pMesh->mVertices)));
+			indices.insert(indices.end(), levelIndices.begin(), levelIndices.end());
+			previousIndices = std::move(levelIndices);
 		}
+	}
 
-		// Load the tangents and bi-tangents if possible.
-		if (pMesh->HasTangentsAndBitangents())
+	/**
+	 * Load the static mesh data from a vertex source.
+	 * The mesh is optimized before copying the vertex data, which reorders the source's vertices in place.
+	 *
+	 * @param source The mesh's vertex source.
+	 * @param isTriangleList Whether the indices form a triangle list. Only triangle lists are optimized.
+	 * @param mesh The mesh to load the data to.
+	 * @param pAttributeMemory The mapped staging memory of each attribute. The mesh's data are written at it's vertex offset.
+	 * @param vertexStride The interleaved vertex stride. This is 0 if each attribute is stored separately.
+	 * @param profile The vertex format profile.
+	 * @param vertexOffset The vertex offset of the current mesh.
+	 * @param indices The mesh's indices. The levels of detail are appended to it.
+	 */
+	void LoadStaticMesh(const VertexSource& source, bool isTriangleList, Flint::Backend::StaticMesh& mesh, const std::array<std::byte*, Flint::EnumToInt(Flint::VertexAttribute::Max)>& pAttributeMemory, uint32_t vertexStride, Flint::VertexFormatProfile profile, uint64_t vertexOffset, std::vector<uint32_t>& indices)
+	{
+		OPTICK_EVENT();
+
+		const auto pPositions = source.m_pAttributes[Flint::EnumToInt(Flint::VertexAttribute::Position)];
+
+		mesh.m_VertexCount = source.m_VertexCount;
+		mesh.m_VertexOffset = vertexOffset;
+
+		// Optimize the mesh for the post-transform vertex cache, overdraw and vertex fetch. Only triangle lists can be optimized.
+		if (isTriangleList && !indices.empty())
 		{
-			// Load the tangent data.
-			auto& tangentData = mesh.m_VertexData[EnumToInt(Flint::VertexAttribute::Tangent)];
+			mesh.m_UnoptimizedCacheStatistics = Flint::Backend::MeshOptimizer::AnalyzeVertexCache(indices, source.m_VertexCount);
 
-			tangentData.m_Stride = sizeof(aiVector3D);
-			tangentData.m_Size = pMesh->mNumVertices * sizeof(aiVector3D);
-			meshStorage.m_pTangentBuffer = std::static_pointer_cast<Flint::Backend::VulkanBuffer>(device.createBuffer(tangentData.m_Size, Flint::BufferUsage::Staging, reinterpret_cast<const std::byte*>(pMesh->mTangents)));
+			Flint::Backend::MeshOptimizer::OptimizeVertexCache(indices, source.m_VertexCount);
 
-			// Load the bi-tangent data.
-			auto& biTangentData = mesh.m_VertexData[EnumToInt(Flint::VertexAttribute::BiTangent)];
+			if (pPositions)
+				Flint::Backend::MeshOptimizer::OptimizeOverdraw(indices, pPositions, source.m_VertexCount);
 
-			biTangentData.m_Stride = sizeof(aiVector3D);
-			biTangentData.m_Size = pMesh->mNumVertices * sizeof(aiVector3D);
-			meshStorage.m_pBiTangentBuffer = std::static_pointer_cast<Flint::Backend::VulkanBuffer>(device.createBuffer(biTangentData.m_Size, Flint::BufferUsage::Staging, reinterpret_cast<const std::byte*>(pMesh->mBitangents)));
+			RemapVertices(source, Flint::Backend::MeshOptimizer::OptimizeVertexFetch(indices, source.m_VertexCount));
+
+			mesh.m_CacheStatistics = Flint::Backend::MeshOptimizer::AnalyzeVertexCache(indices, source.m_VertexCount);
+
+			// Partition the optimized triangles into meshlets so they can be culled and drawn separately.
+			if (pPositions)
+				mesh.m_Meshlets = Flint::Backend::MeshOptimizer::BuildMeshlets(indices, pPositions, source.m_VertexCount);
 		}
 
-		// Load the texture coordinates if possible.
-		for (uint32_t t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; t++)
+		// Compute the bounding sphere, and the dequantization transform if we need to quantize the positions.
+		std::array<float, 3> minimum = {};
+		std::array<float, 3> maximum = {};
+		if (pPositions)
 		{
-			if (pMesh->HasTextureCoords(t))
-			{
-				auto& textureData = mesh.m_VertexData[EnumToInt(Flint::VertexAttribute::Texture0) + t];
-
-				// We have to do this step to make sure that we are only loading the important 2D data, not the 3D storage.
-				std::vector<aiVector2D> textureCoordinates;
-				textureCoordinates.reserve(pMesh->mNumVertices);
+			Flint::Backend::VertexQuantization::ComputeBounds(pPositions, source.m_VertexCount, minimum, maximum);
 
-				std::for_each_n(pMesh->mTextureCoords[t], pMesh->mNumVertices, [&textureCoordinates](const aiVector3D& vec) mutable { textureCoordinates.emplace_back(vec.x, vec.y); });
+			const auto minimumCorner = glm::vec3(minimum[0], minimum[1], minimum[2]);
+			const auto maximumCorner = glm::vec3(maximum[0], maximum[1], maximum[2]);
+			mesh.m_BoundingCenter = (minimumCorner + maximumCorner) * 0.5f;
+			mesh.m_BoundingRadius = glm::length(maximumCorner - minimumCorner) * 0.5f;
 
-				textureData.m_Stride = sizeof(aiVector2D);
-				textureData.m_Size = pMesh->mNumVertices * sizeof(aiVector2D);
-				meshStorage.m_pTextureBuffers[t] = std::static_pointer_cast<Flint::Backend::VulkanBuffer>(device.createBuffer(textureData.m_Size, Flint::BufferUsage::Staging, reinterpret_cast<const std::byte*>(textureCoordinates.data())));
+			if (profile == Flint::VertexFormatProfile::Quantized)
+			{
+				mesh.m_PositionOffset = minimumCorner;
+				mesh.m_PositionScale = maximumCorner - minimumCorner;
 			}
 		}
 
-		// Load the vertex colors if possible.
-		for (uint32_t c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; c++)
+		// Generate the levels of detail. Their indices are appended to the full mesh's indices.
+		mesh.m_IndexCount = indices.size();
+		mesh.m_LevelsOfDetail.emplace_back(0, indices.size(), 0.0f);
+
+		if (isTriangleList && pPositions && !indices.empty())
+			GenerateLevelsOfDetail(source, mesh, indices);
+
+		// Copy the vertex attributes to the mesh's slice of the staging memory.
+		for (uint8_t i = 0; i < Flint::EnumToInt(Flint::VertexAttribute::Max); i++)
 		{
-			if (pMesh->HasVertexColors(c))
+			if (!pAttributeMemory[i])
+				continue;
+
+			const auto attribute = static_cast<Flint::VertexAttribute>(i);
+			const auto stride = GetAttributeStride(attribute, profile);
+			const auto destinationStride = vertexStride > 0 ? vertexStride : stride;
+			const auto pDestination = pAttributeMemory[i] + vertexOffset * destinationStride;
+
+			// If the mesh does not have the attribute, we clear it's elements so that the other meshes' data are kept aligned to their vertex offsets.
+			if (!source.m_pAttributes[i])
 			{
-				auto& colorData = mesh.m_VertexData[Flint::EnumToInt(Flint::VertexAttribute::Color0) + c];
+				for (uint64_t v = 0; v < source.m_VertexCount; v++)
+					std::fill_n(pDestination + v * destinationStride, stride, std::byte(0));
 
-				colorData.m_Stride = sizeof(aiColor4D);
-				colorData.m_Size = pMesh->mNumVertices * sizeof(aiColor4D);
-				meshStorage.m_pColorBuffers[c] = std::static_pointer_cast<Flint::Backend::VulkanBuffer>(device.createBuffer(colorData.m_Size, Flint::BufferUsage::Staging, reinterpret_cast<const std::byte*>(pMesh->mColors[c])));
+				continue;
 			}
+
+			auto& attributeData = mesh.m_VertexData[i];
+			attributeData.m_Stride = static_cast<uint8_t>(destinationStride);
+			attributeData.m_Size = source.m_VertexCount * destinationStride;
+
+			if (profile == Flint::VertexFormatProfile::Quantized)
+				QuantizeAttribute(source, attribute, pDestination, destinationStride, minimum, maximum);
+			else
+				CopyAttribute(source, attribute, pDestination, destinationStride);
 		}
+	}
+
+	/**
+	 * Load the static mesh data from the aiMesh.
+	 *
+	 * @param pMesh The Assimp mesh pointer.
+	 * @param pScene th Assimp scene pointer.
+	 * @param mesh The mesh to load the data to.
+	 * @param pAttributeMemory The mapped staging memory of each attribute. The mesh's data are written at it's vertex offset.
+	 * @param vertexStride The interleaved vertex stride. This is 0 if each attribute is stored separately.
+	 * @param profile The vertex format profile.
+	 * @param vertexOffset The vertex offset of the current mesh.
+	 * @param indices The mesh's index storage.
+	 * @param basePath The base path to load the assets from.
+	 */
+	void LoadAssimpMesh(aiMesh* pMesh, const aiScene* pScene, Flint::Backend::StaticMesh& mesh, const std::array<std::byte*, Flint::EnumToInt(Flint::VertexAttribute::Max)>& pAttributeMemory, uint32_t vertexStride, Flint::VertexFormatProfile profile, uint64_t vertexOffset, std::vector<uint32_t>& indices, const std::filesystem::path& basePath)
+	{
+		OPTICK_EVENT();
+
+		mesh.m_Name = pMesh->mName.C_Str();
 
 		// Load the index data if possible.
+		// The indices are relative to the mesh's vertex offset, so the ones of small meshes can later be stored as 16-bit indices.
 		if (pMesh->HasFaces())
 		{
-			[[maybe_unused]] const auto lock = std::scoped_lock(indicesMutex);
-			mesh.m_IndexOffset = indices.size();
+			indices.reserve(pMesh->mNumFaces * 3);
 
 			for (uint32_t f = 0; f < pMesh->mNumFaces; f++)
 			{
@@ -199,10 +562,10 @@ namespace /* anonymous */
 				for (uint32_t index = 0; index < face.mNumIndices; index++)
 					indices.emplace_back(face.mIndices[index]);
 			}
-
-			mesh.m_IndexCount = indices.size() - mesh.m_IndexOffset;
 		}
 
+		LoadStaticMesh(GetVertexSource(pMesh), pMesh->mPrimitiveTypes == aiPrimitiveType_TRIANGLE, mesh, pAttributeMemory, vertexStride, profile, vertexOffset, indices);
+
 		// Load the materials.
 		const auto pMaterial = pScene->mMaterials[pMesh->mMaterialIndex];
 
@@ -220,36 +583,147 @@ namespace /* anonymous */
 	}
 
 	/**
-	 * Save the integer value as bytes.
+	 * Load the static mesh data from a glTF primitive.
+	 * The accessors are decoded straight from the mapped buffers, and the vertices are used as they are, without welding them.
 	 *
-	 * @param bytes The bytes to save in.
-	 * @param value The value to store.
+	 * @param document The glTF document.
+	 * @param primitive The glTF primitive.
+	 * @param mesh The mesh to load the data to.
+	 * @param pAttributeMemory The mapped staging memory of each attribute. The mesh's data are written at it's vertex offset.
+	 * @param vertexStride The interleaved vertex stride. This is 0 if each attribute is stored separately.
+	 * @param profile The vertex format profile.
+	 * @param vertexOffset The vertex offset of the current mesh.
+	 * @param indices The mesh's index storage.
 	 */
-	void SaveToBytes(std::vector<std::byte>& bytes, uint64_t value)
+	void LoadGLTFPrimitive(const Flint::Backend::GLTF::Document& document, const Flint::Backend::GLTF::Primitive& primitive, Flint::Backend::StaticMesh& mesh, const std::array<std::byte*, Flint::EnumToInt(Flint::VertexAttribute::Max)>& pAttributeMemory, uint32_t vertexStride, Flint::VertexFormatProfile profile, uint64_t vertexOffset, std::vector<uint32_t>& indices)
 	{
-		//bytes.emplace_back(value >> 56);
-		//bytes.emplace_back(value >> 48);
-		//bytes.emplace_back(value >> 40);
-		//bytes.emplace_back(value >> 32);
-		//bytes.emplace_back(value >> 24);
-		//bytes.emplace_back(value >> 16);
-		//bytes.emplace_back(value >> 8);
-		//bytes.emplace_back(value >> 0);
+		OPTICK_EVENT();
+
+		mesh.m_Name = primitive.m_Name;
+
+		const auto vertexCount = primitive.m_Attributes[Flint::EnumToInt(Flint::VertexAttribute::Position)].m_Count;
+
+		// Load the indices. Non-indexed primitives use a sequential index for each vertex.
+		if (primitive.m_Indices.isValid())
+		{
+			indices.resize(primitive.m_Indices.m_Count);
+			Flint::Backend::GLTF::DecodeIndices(primitive.m_Indices, indices.data());
+
+			if (std::any_of(indices.begin(), indices.end(), [vertexCount](uint32_t index) { return index >= vertexCount; }))
+				throw Flint::AssetError("The glTF asset contains an index which is out of the vertex range!");
+		}
+		else
+		{
+			indices.resize(vertexCount);
+			std::iota(indices.begin(), indices.end(), 0);
+		}
+
+		// Decode the attributes to floats.
+		std::array<std::vector<float>, Flint::EnumToInt(Flint::VertexAttribute::Max)> attributes;
+		VertexSource source;
+		source.m_VertexCount = vertexCount;
+
+		const auto decodeAttribute = [&primitive, &attributes, &source, vertexCount](Flint::VertexAttribute attribute, uint8_t components, float fillValue = 0.0f)
+		{
+			const auto index = Flint::EnumToInt(attribute);
+			attributes[index].resize(vertexCount * components);
+			source.m_pAttributes[index] = attributes[index].data();
+			source.m_ComponentCounts[index] = components;
+
+			if (primitive.m_Attributes[index].isValid())
+				Flint::Backend::GLTF::DecodeAccessor(primitive.m_Attributes[index], attributes[index].data(), components, fillValue);
+		};
+
+		for (uint8_t a = 0; a < Flint::EnumToInt(Flint::VertexAttribute::Max); a++)
+		{
+			const auto attribute = static_cast<Flint::VertexAttribute>(a);
+			if (!HasAttribute(primitive, attribute))
+				continue;
+
+			switch (attribute)
+			{
+			case Flint::VertexAttribute::Tangent:
+			case Flint::VertexAttribute::BiTangent:
+				decodeAttribute(attribute, 3);
+				break;
+
+			default:
+				if (a >= Flint::EnumToInt(Flint::VertexAttribute::Texture0))
+					decodeAttribute(attribute, 2);
+				else if (a >= Flint::EnumToInt(Flint::VertexAttribute::Color0))
+					decodeAttribute(attribute, 4, 1.0f);
+				else
+					decodeAttribute(attribute, 3);
+
+				break;
+			}
+		}
+
+		// The bi-tangents are derived from the normals and the tangents' handedness, and the tangents are generated if the primitive does not have them.
+		const auto pNormals = source.m_pAttributes[Flint::EnumToInt(Flint::VertexAttribute::Normal)];
+		const auto pTangents = source.m_pAttributes[Flint::EnumToInt(Flint::VertexAttribute::Tangent)];
+		const auto pBiTangents = source.m_pAttributes[Flint::EnumToInt(Flint::VertexAttribute::BiTangent)];
+		const auto& tangentAccessor = primitive.m_Attributes[Flint::EnumToInt(Flint::VertexAttribute::Tangent)];
+
+		if (tangentAccessor.isValid() && pBiTangents)
+		{
+			std::vector<float> handedTangents(vertexCount * 4);
+			Flint::Backend::GLTF::DecodeAccessor(tangentAccessor, handedTangents.data(), 4, 1.0f);
+
+			for (uint64_t v = 0; v < vertexCount; v++)
+			{
+				const auto normal = glm::vec3(pNormals[v * 3], pNormals[v * 3 + 1], pNormals[v * 3 + 2]);
+				const auto tangent = glm::vec3(handedTangents[v * 4], handedTangents[v * 4 + 1], handedTangents[v * 4 + 2]);
+				const auto biTangent = glm::cross(normal, tangent) * handedTangents[v * 4 + 3];
+
+				std::copy_n(&biTangent.x, 3, pBiTangents + v * 3);
+			}
+		}
+		else if (!tangentAccessor.isValid() && pTangents)
+		{
+			GenerateTangents(indices, source.m_pAttributes[Flint::EnumToInt(Flint::VertexAttribute::Position)], pNormals, source.m_pAttributes[Flint::EnumToInt(Flint::VertexAttribute::Texture0)], vertexCount, pTangents, pBiTangents);
+		}
+
+		LoadStaticMesh(source, true, mesh, pAttributeMemory, vertexStride, profile, vertexOffset, indices);
+
+		// Get the texture paths.
+		if (primitive.m_Material == Flint::Backend::GLTF::InvalidIndex)
+			return;
+
+		const auto& material = document.getMaterials()[primitive.m_Material];
+		mesh.m_TexturePaths[Flint::EnumToInt(Flint::Backend::TextureType::BaseColor)] = material.m_BaseColorTexture;
+		mesh.m_TexturePaths[Flint::EnumToInt(Flint::Backend::TextureType::Metalness)] = material.m_MetallicRoughnessTexture;
+		mesh.m_TexturePaths[Flint::EnumToInt(Flint::Backend::TextureType::Roughness)] = material.m_MetallicRoughnessTexture;
+		mesh.m_TexturePaths[Flint::EnumToInt(Flint::Backend::TextureType::ColorSheen)] = material.m_SheenColorTexture;
+		mesh.m_TexturePaths[Flint::EnumToInt(Flint::Backend::TextureType::RoughnessSheen)] = material.m_SheenRoughnessTexture;
+		mesh.m_TexturePaths[Flint::EnumToInt(Flint::Backend::TextureType::ColorClearCoat)] = material.m_ClearCoatTexture;
+		mesh.m_TexturePaths[Flint::EnumToInt(Flint::Backend::TextureType::RoughnessClearCoat)] = material.m_ClearCoatRoughnessTexture;
+		mesh.m_TexturePaths[Flint::EnumToInt(Flint::Backend::TextureType::NormalClearCoat)] = material.m_ClearCoatNormalTexture;
+		mesh.m_TexturePaths[Flint::EnumToInt(Flint::Backend::TextureType::Transmission)] = material.m_TransmissionTexture;
+		mesh.m_TexturePaths[Flint::EnumToInt(Flint::Backend::TextureType::VolumeThickness)] = material.m_ThicknessTexture;
 	}
+
 }
 
 namespace Flint
 {
 	namespace Backend
 	{
-		VulkanStaticModel::VulkanStaticModel(const std::shared_ptr<VulkanDevice>& pDevice, std::filesystem::path&& assetFile)
+		VulkanStaticModel::VulkanStaticModel(const std::shared_ptr<VulkanDevice>& pDevice, std::filesystem::path&& assetFile, VertexMemoryType memoryType /*= VertexMemoryType::Exclusive*/, std::vector<VertexInput>&& vertexLayout /*= {}*/, VertexFormatProfile formatProfile /*= VertexFormatProfile::Full*/)
 			: StaticModel(pDevice, std::move(assetFile))
-			, m_VertexStorage(pDevice)
+			, m_VertexLayout(std::move(vertexLayout))
+			, m_MemoryType(memoryType)
+			, m_FormatProfile(formatProfile)
 		{
 			OPTICK_EVENT();
 
-			// Load the data from the file.
-			loadData();
+			// Load the data from the file. Cooked models can be loaded directly, glTF assets are loaded natively if they only use the supported features,
+			// and everything else goes through the importer.
+			const auto extension = m_AssetPath.extension();
+			if (extension == CookedStaticModel::Extension)
+				loadCookedData();
+			else if ((extension != ".gltf" && extension != ".glb") || !loadGLTFData())
+				loadData();
 
 			// Make sure to set the object as valid.
 			validate();
@@ -264,37 +738,133 @@ namespace Flint
 		{
 			OPTICK_EVENT();
 
-			m_VertexStorage.terminate();
-			m_pIndexBuffer->terminate();
+			// Return the ranges to the geometry pool.
+			auto& pool = getDevice().as<VulkanDevice>()->getGeometryPool();
+			pool.freeVertices(m_VertexRange);
+			pool.freeIndices(m_IndexRange);
+
 			invalidate();
 		}
 
 		std::vector<std::byte> VulkanStaticModel::compile() const
 		{
-			// The format is as follows.
-			// Special characters: 'F', 'L', 'I', 'N', 'T'  - 5 bytes.
-			// Hash value: 8 bytes.
-			// 
-			// The next comes the payload.
-			// Mesh count: 8 bytes.
-			// 
-			// Position data size: 8 bytes.
-			// Position data.
-			// [This format for all the other vertex attributes, same for index data]
+			OPTICK_EVENT();
+
+			CookedStaticModel::Header header;
+			header.m_MeshCount = static_cast<uint32_t>(m_Meshes.size());
+			header.m_MemoryType = EnumToInt(m_MemoryType);
+			header.m_FormatProfile = EnumToInt(m_FormatProfile);
+			header.m_VertexStride = m_VertexStride;
+			header.m_AttributeOffsets = m_AttributeOffsets;
+
+			// The header is written last, after the hash is computed.
+			auto bytes = std::vector<std::byte>(sizeof(CookedStaticModel::Header));
+			const auto appendBlob = [&bytes](const void* pData, uint64_t size)
+			{
+				bytes.resize((bytes.size() + CookedStaticModel::BlobAlignment - 1) & ~(CookedStaticModel::BlobAlignment - 1));
+
+				const auto blob = CookedStaticModel::Blob(bytes.size(), size);
+				bytes.insert(bytes.end(), static_cast<const std::byte*>(pData), static_cast<const std::byte*>(pData) + size);
+
+				return blob;
+			};
+
+			// The model's ranges of the geometry pool's buffers are read back through a staging buffer, and are stored as they are.
+			const auto appendBuffer = [this, &appendBlob](const VulkanBuffer* pBuffer, uint64_t offset, uint64_t size)
+			{
+				auto pStagingBuffer = getDevicePointer()->createBuffer(size, BufferUsage::Staging);
 
-			const uint64_t hashValue = 0;
-			Bytes bytes;
+				auto vCommandBuffer = VulkanCommandBuffers(getDevicePointerAs<VulkanDevice>());
+				vCommandBuffer.begin();
+				vCommandBuffer.copyBuffer(pBuffer->getBuffer(), size, offset, pStagingBuffer->as<VulkanBuffer>()->getBuffer(), 0);
+				vCommandBuffer.end();
+				vCommandBuffer.submitTransfer();
+				vCommandBuffer.finishExecution();
 
-			// Set the special characters.
-			bytes.insert("FLINT");
+				const auto blob = appendBlob(pStagingBuffer->mapMemory(), size);
+				pStagingBuffer->unmapMemory();
+				pStagingBuffer->terminate();
 
-			// Insert the hash value.
-			bytes.insert(hashValue);
+				return blob;
+			};
 
-			// Insert the mesh count.
-			bytes.insert(m_Meshes.size());
+			const bool isInterleaved = m_MemoryType == VertexMemoryType::Interleaved;
+			const auto attributeCount = isInterleaved ? 1 : EnumToInt(VertexAttribute::Max);
+			for (uint8_t a = 0; a < attributeCount; a++)
+			{
+				const auto attribute = static_cast<VertexAttribute>(a);
+				const auto size = m_VertexRange.m_VertexCount * getBufferStride(attribute);
+				if ((isInterleaved || m_UsedAttributes[a]) && size > 0)
+					header.m_AttributeBlobs[a] = appendBuffer(m_VertexRange.m_pStorage->getBuffer(attribute), m_VertexRange.m_Offsets[a], size);
+			}
+
+			if (m_IndexRange.m_Size > 0)
+				header.m_IndexBlob = appendBuffer(m_IndexRange.m_pBuffer, m_IndexRange.m_Offset, m_IndexRange.m_Size);
+
+			// Setup the mesh table, and collect the levels of detail, meshlets and the strings.
+			std::vector<CookedStaticModel::MeshEntry> meshEntries(m_Meshes.size());
+			std::vector<CookedStaticModel::LevelOfDetailEntry> levelsOfDetail;
+			std::vector<Meshlet> meshlets;
+			std::string strings;
+
+			const auto appendString = [&strings](const std::string& string)
+			{
+				const auto range = CookedStaticModel::Range(strings.size(), string.size());
+				strings.append(string);
+
+				return range;
+			};
+
+			for (uint64_t i = 0; i < m_Meshes.size(); i++)
+			{
+				const auto& mesh = m_Meshes[i];
+				auto& entry = meshEntries[i];
+
+				// The offsets are stored relative to the model's ranges, since the ranges will be different when the cooked model is loaded.
+				for (uint8_t a = 0; a < EnumToInt(VertexAttribute::Max); a++)
+				{
+					const auto& attributeData = mesh.m_VertexData[a];
+					const auto offset = attributeData.m_Stride > 0 ? attributeData.m_Offset - m_VertexRange.m_Offsets[isInterleaved ? 0 : a] : 0;
+					entry.m_VertexData[a] = CookedStaticModel::AttributeEntry(attributeData.m_Stride, attributeData.m_Stride > 0 ? attributeData.m_Size : 0, offset);
+				}
+
+				for (uint8_t t = 0; t < EnumToInt(TextureType::Max); t++)
+					entry.m_TexturePaths[t] = appendString(mesh.m_TexturePaths[t].string());
+
+				entry.m_Name = appendString(mesh.m_Name);
 
-			return bytes.getStorage();
+				entry.m_PositionOffset = { mesh.m_PositionOffset.x, mesh.m_PositionOffset.y, mesh.m_PositionOffset.z };
+				entry.m_PositionScale = { mesh.m_PositionScale.x, mesh.m_PositionScale.y, mesh.m_PositionScale.z };
+				entry.m_BoundingCenter = { mesh.m_BoundingCenter.x, mesh.m_BoundingCenter.y, mesh.m_BoundingCenter.z };
+				entry.m_BoundingRadius = mesh.m_BoundingRadius;
+
+				entry.m_VertexCount = mesh.m_VertexCount;
+				entry.m_VertexOffset = mesh.m_VertexOffset - m_VertexRange.m_FirstVertex;
+				entry.m_IndexOffset = mesh.m_IndexOffset - m_IndexRange.m_Offset / (mesh.m_IndexType == IndexType::Uint16 ? sizeof(uint16_t) : sizeof(uint32_t));
+				entry.m_IndexCount = mesh.m_IndexCount;
+				entry.m_IndexType = EnumToInt(mesh.m_IndexType);
+
+				entry.m_UnoptimizedCacheStatistics = mesh.m_UnoptimizedCacheStatistics;
+				entry.m_CacheStatistics = mesh.m_CacheStatistics;
+
+				entry.m_LevelsOfDetail = CookedStaticModel::Range(levelsOfDetail.size(), mesh.m_LevelsOfDetail.size());
+				for (const auto& levelOfDetail : mesh.m_LevelsOfDetail)
+					levelsOfDetail.emplace_back(levelOfDetail.m_IndexOffset, levelOfDetail.m_IndexCount, levelOfDetail.m_Error);
+
+				entry.m_Meshlets = CookedStaticModel::Range(meshlets.size(), mesh.m_Meshlets.size());
+				meshlets.insert(meshlets.end(), mesh.m_Meshlets.begin(), mesh.m_Meshlets.end());
+			}
+
+			header.m_MeshTable = appendBlob(meshEntries.data(), meshEntries.size() * sizeof(CookedStaticModel::MeshEntry));
+			header.m_LevelOfDetailTable = appendBlob(levelsOfDetail.data(), levelsOfDetail.size() * sizeof(CookedStaticModel::LevelOfDetailEntry));
+			header.m_MeshletTable = appendBlob(meshlets.data(), meshlets.size() * sizeof(Meshlet));
+			header.m_StringBlob = appendBlob(strings.data(), strings.size());
+
+			// Finally hash the content and write the header.
+			header.m_ContentHash = static_cast<uint64_t>(XXH64(bytes.data() + sizeof(CookedStaticModel::Header), bytes.size() - sizeof(CookedStaticModel::Header), 0));
+			std::memcpy(bytes.data(), &header, sizeof(CookedStaticModel::Header));
+
+			return bytes;
 		}
 
 		std::vector<VkVertexInputBindingDescription> VulkanStaticModel::getInputBindingDescriptions(const StaticMesh& mesh, const std::vector<VertexInput>& inputs) const
@@ -303,6 +873,17 @@ namespace Flint
 
 			std::vector<VkVertexInputBindingDescription> descriptions;
 
+			// If the data are interleaved, we only have a single binding.
+			if (m_MemoryType == VertexMemoryType::Interleaved)
+			{
+				auto& description = descriptions.emplace_back();
+				description.stride = m_VertexStride;
+				description.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+				description.binding = 0;
+
+				return descriptions;
+			}
+
 			// Iterate over the vertex data and get the binding descriptions.
 			uint32_t binding = 0;
 			for (const auto input : inputs)
@@ -328,6 +909,25 @@ namespace Flint
 
 			std::vector<VkVertexInputAttributeDescription> descriptions;
 
+			// If the data are interleaved, all the attributes are in the same binding at their packed offsets.
+			if (m_MemoryType == VertexMemoryType::Interleaved)
+			{
+				for (const auto input : inputs)
+				{
+					const auto i = EnumToInt(input.m_Attribute);
+					if (m_AttributeOffsets[i] == InvalidAttributeOffset)
+						throw BackendError("The vertex input is not present in the interleaved vertex layout!");
+
+					auto& description = descriptions.emplace_back();
+					description.offset = m_AttributeOffsets[i];
+					description.format = GetAttributeFormat(input.m_Attribute, m_FormatProfile);
+					description.location = i;
+					description.binding = 0;
+				}
+
+				return descriptions;
+			}
+
 			// Iterate over the vertex data and get the binding descriptions.
 			uint32_t binding = 0;
 			for (const auto input : inputs)
@@ -338,7 +938,7 @@ namespace Flint
 				{
 					auto& description = descriptions.emplace_back();
 					description.offset = 0;
-					description.format = GetAttributeFormat(input.m_Attribute);
+					description.format = GetAttributeFormat(input.m_Attribute, m_FormatProfile);
 					description.location = i;
 					description.binding = binding++;
 				}
@@ -369,58 +969,456 @@ namespace Flint
 
 			const auto basePath = m_AssetPath.parent_path();
 
-			std::mutex indicesMutex;
-			std::vector<uint32_t> indices;
-			auto meshStorages = std::vector<StaticMeshStorage>(pScene->mNumMeshes);
+			auto meshIndices = std::vector<std::vector<uint32_t>>(pScene->mNumMeshes);
 			m_Meshes.resize(pScene->mNumMeshes);
 
-			// Load the meshes.
+			// Compute the vertex offsets of all the meshes and find the attributes used by the scene.
+			std::vector<uint64_t> vertexOffsets(pScene->mNumMeshes);
+			std::array<bool, EnumToInt(VertexAttribute::Max)> usedAttributes = {};
+
+			uint64_t vertexCount = 0;
+			for (uint32_t i = 0; i < pScene->mNumMeshes; i++)
 			{
-				std::vector<std::future<void>> meshFutures;
-				meshFutures.reserve(pScene->mNumMeshes);
+				const auto pMesh = pScene->mMeshes[i];
 
-				uint64_t vertexOffset = 0;
-				for (uint32_t i = 0; i < pScene->mNumMeshes; i++)
+				vertexOffsets[i] = vertexCount;
+				vertexCount += pMesh->mNumVertices;
+
+				const auto source = GetVertexSource(pMesh);
+				for (uint8_t a = 0; a < EnumToInt(VertexAttribute::Max); a++)
+					usedAttributes[a] |= source.m_pAttributes[a] != nullptr;
+			}
+
+			std::array<std::byte*, EnumToInt(VertexAttribute::Max)> pAttributeMemory = {};
+			auto pStagingBuffers = createStagingBuffers(usedAttributes, vertexCount, pAttributeMemory);
+
+			// Load the meshes on a bounded group of workers. The vertex offsets are computed up front, so each mesh writes to it's own slice of the staging
+			// buffers and it's own index vector. This needs no synchronization and the layout does not depend on the order the meshes are loaded in.
+			WorkerGroup().parallelFor(pScene->mNumMeshes, [this, pScene, &vertexOffsets, &pAttributeMemory, &meshIndices, &basePath](uint64_t i)
 				{
-					meshFutures.emplace_back(
-						std::async(
-							std::launch::async,
-							[this, pScene, i, vertexOffset, &indices, basePath, &indicesMutex, &meshStorages]
-							{
-								OPTICK_THREAD("Static Mesh Loader");
-								LoadStaticMesh(pScene->mMeshes[i], pScene, m_Meshes[i], meshStorages[i], *getDevice().as<VulkanDevice>(), vertexOffset, indices, indicesMutex, basePath);
-							})
-					);
-
-					vertexOffset += pScene->mMeshes[i]->mNumVertices;
+					OPTICK_THREAD("Static Mesh Loader");
+					LoadAssimpMesh(pScene->mMeshes[i], pScene, m_Meshes[i], pAttributeMemory, m_VertexStride, m_FormatProfile, vertexOffsets[i], meshIndices[i], basePath);
 				}
+			);
+
+			auto vCommandBuffer = VulkanCommandBuffers(getDevicePointerAs<VulkanDevice>());
+			uploadData(vCommandBuffer, pStagingBuffers, meshIndices);
+		}
+
+		bool VulkanStaticModel::loadGLTFData()
+		{
+			OPTICK_EVENT();
+
+			const auto document = GLTF::Document(m_AssetPath);
+
+			if (!document.isSupported())
+			{
+				spdlog::info("Loading {} using the importer. {}", m_AssetPath.filename().string(), document.getUnsupportedFeature());
+				return false;
 			}
 
-			// Now we can copy the vertex data.
-			for (uint32_t i = 0; i < meshStorages.size(); i++)
+			const auto& primitives = document.getPrimitives();
+			auto meshIndices = std::vector<std::vector<uint32_t>>(primitives.size());
+			m_Meshes.resize(primitives.size());
+
+			// Compute the vertex offsets of all the meshes and find the attributes used by the document.
+			std::vector<uint64_t> vertexOffsets(primitives.size());
+			std::array<bool, EnumToInt(VertexAttribute::Max)> usedAttributes = {};
+
+			uint64_t vertexCount = 0;
+			for (uint64_t i = 0; i < primitives.size(); i++)
 			{
+				vertexOffsets[i] = vertexCount;
+				vertexCount += primitives[i].m_Attributes[EnumToInt(VertexAttribute::Position)].m_Count;
+
+				for (uint8_t a = 0; a < EnumToInt(VertexAttribute::Max); a++)
+					usedAttributes[a] |= HasAttribute(primitives[i], static_cast<VertexAttribute>(a));
+			}
+
+			std::array<std::byte*, EnumToInt(VertexAttribute::Max)> pAttributeMemory = {};
+			auto pStagingBuffers = createStagingBuffers(usedAttributes, vertexCount, pAttributeMemory);
+
+			// Decode the primitives straight from the mapped buffers, the same way the imported meshes are loaded.
+			WorkerGroup().parallelFor(primitives.size(), [this, &document, &primitives, &vertexOffsets, &pAttributeMemory, &meshIndices](uint64_t i)
+				{
+					OPTICK_THREAD("Static Mesh Loader");
+					LoadGLTFPrimitive(document, primitives[i], m_Meshes[i], pAttributeMemory, m_VertexStride, m_FormatProfile, vertexOffsets[i], meshIndices[i]);
+				}
+			);
+
+			auto vCommandBuffer = VulkanCommandBuffers(getDevicePointerAs<VulkanDevice>());
+			uploadData(vCommandBuffer, pStagingBuffers, meshIndices);
+			return true;
+		}
+
+		std::array<std::shared_ptr<Buffer>, EnumToInt(VertexAttribute::Max)> VulkanStaticModel::createStagingBuffers(const std::array<bool, EnumToInt(VertexAttribute::Max)>& usedAttributes, uint64_t vertexCount, std::array<std::byte*, EnumToInt(VertexAttribute::Max)>& pAttributeMemory)
+		{
+			OPTICK_EVENT();
+
+			// If the data are interleaved, we only need a single buffer, else we need one per attribute.
+			std::array<std::shared_ptr<Buffer>, EnumToInt(VertexAttribute::Max)> pStagingBuffers = {};
+			if (m_MemoryType == VertexMemoryType::Interleaved)
+			{
+				setupInterleavedLayout(usedAttributes);
+
+				if (m_VertexStride > 0 && vertexCount > 0)
+				{
+					pStagingBuffers[0] = getDevice().createBuffer(vertexCount * m_VertexStride, BufferUsage::Staging);
+					const auto pMemory = pStagingBuffers[0]->mapMemory();
+
+					for (uint8_t a = 0; a < EnumToInt(VertexAttribute::Max); a++)
+					{
+						if (m_AttributeOffsets[a] != InvalidAttributeOffset)
+							pAttributeMemory[a] = pMemory + m_AttributeOffsets[a];
+					}
+				}
+			}
+			else
+			{
+				for (uint8_t a = 0; a < EnumToInt(VertexAttribute::Max); a++)
+				{
+					if (usedAttributes[a] && vertexCount > 0)
+					{
+						pStagingBuffers[a] = getDevice().createBuffer(vertexCount * GetAttributeStride(static_cast<VertexAttribute>(a), m_FormatProfile), BufferUsage::Staging);
+						pAttributeMemory[a] = pStagingBuffers[a]->mapMemory();
+					}
+				}
+			}
+
+			return pStagingBuffers;
+		}
+
+		void VulkanStaticModel::allocateVertexRange(const std::array<bool, EnumToInt(VertexAttribute::Max)>& usedAttributes, uint64_t vertexCount)
+		{
+			OPTICK_EVENT();
+
+			// All the strides of the format profile are used even if the asset does not have the attribute, so the models share the same arena.
+			std::array<uint32_t, EnumToInt(VertexAttribute::Max)> strides = {};
+			for (uint8_t a = 0; a < EnumToInt(VertexAttribute::Max); a++)
+				strides[a] = getBufferStride(static_cast<VertexAttribute>(a));
+
+			m_UsedAttributes = usedAttributes;
+			m_VertexRange = getDevice().as<VulkanDevice>()->getGeometryPool().allocateVertices(m_MemoryType, strides, usedAttributes, vertexCount);
+		}
+
+		uint32_t VulkanStaticModel::getBufferStride(VertexAttribute attribute) const
+		{
+			return m_MemoryType == VertexMemoryType::Interleaved ? m_VertexStride : GetAttributeStride(attribute, m_FormatProfile);
+		}
+
+		void VulkanStaticModel::uploadData(VulkanCommandBuffers& vCommandBuffer, const std::array<std::shared_ptr<Buffer>, EnumToInt(VertexAttribute::Max)>& pStagingBuffers, const std::vector<std::vector<uint32_t>>& meshIndices)
+		{
+			OPTICK_EVENT();
+
+			// Report the vertex cache statistics of the optimized meshes. This is only useful when tuning the optimizer, so it's a debug message.
+			if (spdlog::should_log(spdlog::level::debug))
+			{
+				VertexCacheStatistics unoptimizedStatistics;
+				VertexCacheStatistics optimizedStatistics;
+				for (const auto& mesh : m_Meshes)
+				{
+					unoptimizedStatistics.m_CacheMisses += mesh.m_UnoptimizedCacheStatistics.m_CacheMisses;
+					unoptimizedStatistics.m_TriangleCount += mesh.m_UnoptimizedCacheStatistics.m_TriangleCount;
+					unoptimizedStatistics.m_VertexCount += mesh.m_UnoptimizedCacheStatistics.m_VertexCount;
+
+					optimizedStatistics.m_CacheMisses += mesh.m_CacheStatistics.m_CacheMisses;
+					optimizedStatistics.m_TriangleCount += mesh.m_CacheStatistics.m_TriangleCount;
+					optimizedStatistics.m_VertexCount += mesh.m_CacheStatistics.m_VertexCount;
+				}
+
+				spdlog::debug("Optimized the meshes of {}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}.", m_AssetPath.filename().string(), unoptimizedStatistics.getACMR(), optimizedStatistics.getACMR(), unoptimizedStatistics.getATVR(), optimizedStatistics.getATVR());
+			}
+
+			// Now we can allocate the vertex range from the geometry pool once and copy all the data using a single transfer.
+			std::array<bool, EnumToInt(VertexAttribute::Max)> usedAttributes = {};
+			for (uint8_t a = 0; a < EnumToInt(VertexAttribute::Max); a++)
+				usedAttributes[a] = pStagingBuffers[a] != nullptr;
+
+			uint64_t vertexCount = 0;
+			for (const auto& mesh : m_Meshes)
+				vertexCount = std::max(vertexCount, mesh.m_VertexOffset + mesh.m_VertexCount);
+
+			allocateVertexRange(usedAttributes, vertexCount);
+			vCommandBuffer.begin();
+
+			for (uint8_t a = 0; a < EnumToInt(VertexAttribute::Max); a++)
+			{
+				const auto& pStagingBuffer = pStagingBuffers[a];
+				if (!pStagingBuffer)
+					continue;
+
+				pStagingBuffer->unmapMemory();
+				m_VertexRange.m_pStorage->insertBatched(&vCommandBuffer, static_cast<VertexAttribute>(a), pStagingBuffer.get(), m_VertexRange.m_Offsets[a]);
+			}
+
+			// Set the offsets of the attributes in each mesh, and move the vertex offsets to the model's range.
+			const bool isInterleaved = m_MemoryType == VertexMemoryType::Interleaved;
+			for (auto& mesh : m_Meshes)
+			{
+				for (uint8_t a = 0; a < EnumToInt(VertexAttribute::Max); a++)
+				{
+					auto& attributeData = mesh.m_VertexData[a];
+					if (attributeData.m_Stride == 0)
+						continue;
+
+					if (isInterleaved)
+						attributeData.m_Offset = m_VertexRange.m_Offsets[0] + mesh.m_VertexOffset * m_VertexStride + m_AttributeOffsets[a];
+					else
+						attributeData.m_Offset = m_VertexRange.m_Offsets[a] + mesh.m_VertexOffset * attributeData.m_Stride;
+				}
+
+				mesh.m_VertexOffset += m_VertexRange.m_FirstVertex;
+			}
+
+			// Compute the index offsets. Meshes with less than 65535 vertices use 16-bit indices (the maximum value is reserved for primitive restart).
+			// Each mesh's indices start at a 4 byte aligned offset so that the offset is a multiple of both index sizes.
+			uint64_t indexBufferSize = 0;
+			for (uint32_t i = 0; i < m_Meshes.size(); i++)
+			{
+				auto& mesh = m_Meshes[i];
+				mesh.m_IndexType = mesh.m_VertexCount < std::numeric_limits<uint16_t>::max() ? IndexType::Uint16 : IndexType::Uint32;
+
+				// The index data contains all the levels of detail of the mesh.
+				const uint64_t indexSize = mesh.m_IndexType == IndexType::Uint16 ? sizeof(uint16_t) : sizeof(uint32_t);
+				mesh.m_IndexOffset = indexBufferSize / indexSize;
+				indexBufferSize += (meshIndices[i].size() * indexSize + 3) & ~static_cast<uint64_t>(3);
+			}
+
+			// Finally, pack the index data to a staging buffer, and copy it to the model's index range within the same transfer.
+			auto pIndexData = getDevice().createBuffer(indexBufferSize, BufferUsage::Staging);
+			const auto pIndexMemory = pIndexData->mapMemory();
+			for (uint32_t i = 0; i < m_Meshes.size(); i++)
+			{
+				const auto& mesh = m_Meshes[i];
+				const auto& indices = meshIndices[i];
+
+				if (mesh.m_IndexType == IndexType::Uint16)
+					VertexQuantization::NarrowIndices(indices.data(), indices.size(), reinterpret_cast<uint16_t*>(pIndexMemory) + mesh.m_IndexOffset);
+				else
+					std::copy_n(indices.data(), indices.size(), reinterpret_cast<uint32_t*>(pIndexMemory) + mesh.m_IndexOffset);
+			}
+
+			pIndexData->unmapMemory();
+
+			m_IndexRange = getDevice().as<VulkanDevice>()->getGeometryPool().allocateIndices(indexBufferSize);
+			m_IndexRange.m_pBuffer->copyFromBatched(&vCommandBuffer, pIndexData.get(), 0, m_IndexRange.m_Offset);
+
+			// The range is 4 byte aligned so it's a multiple of both index sizes.
+			for (auto& mesh : m_Meshes)
+				mesh.m_IndexOffset += m_IndexRange.m_Offset / (mesh.m_IndexType == IndexType::Uint16 ? sizeof(uint16_t) : sizeof(uint32_t));
+
+			// Submit the copies.
+			vCommandBuffer.end();
+			vCommandBuffer.submitTransfer();
+			vCommandBuffer.finishExecution();
+		}
+
+		void VulkanStaticModel::loadCookedData()
+		{
+			OPTICK_EVENT();
+
+			const auto file = MappedFile(m_AssetPath);
+			if (file.getSize() < sizeof(CookedStaticModel::Header))
+				throw AssetError("The cooked static model file is too small!");
+
+			CookedStaticModel::Header header;
+			std::memcpy(&header, file.getData(), sizeof(CookedStaticModel::Header));
+
+			// Validate the header and the content.
+			if (header.m_Magic != CookedStaticModel::Magic)
+				throw AssetError("The file is not a cooked static model!");
+
+			if (header.m_Version != CookedStaticModel::Version)
+				throw AssetError("The cooked static model was compiled using an unsupported version!");
+
+			if (header.m_MemoryType != EnumToInt(m_MemoryType) || header.m_FormatProfile != EnumToInt(m_FormatProfile))
+				throw AssetError("The cooked static model was compiled using a different vertex memory type or format profile!");
+
+			if (header.m_ContentHash != static_cast<uint64_t>(XXH64(file.getData() + sizeof(CookedStaticModel::Header), file.getSize() - sizeof(CookedStaticModel::Header), 0)))
+				throw AssetError("The cooked static model is corrupted!");
+
+			const auto getBlob = [&file](const CookedStaticModel::Blob& blob)
+			{
+				if (blob.m_Offset > file.getSize() || blob.m_Size > file.getSize() - blob.m_Offset)
+					throw AssetError("The cooked static model contains an invalid blob!");
+
+				return file.getData() + blob.m_Offset;
+			};
+
+			if (header.m_MeshTable.m_Size != header.m_MeshCount * sizeof(CookedStaticModel::MeshEntry))
+				throw AssetError("The cooked static model contains an invalid mesh table!");
+
+			m_VertexStride = header.m_VertexStride;
+			m_AttributeOffsets = header.m_AttributeOffsets;
+
+			// Allocate the ranges from the geometry pool. Every attribute blob contains the data of all the vertices.
+			std::array<bool, EnumToInt(VertexAttribute::Max)> usedAttributes = {};
+			uint64_t vertexCount = 0;
+			for (uint8_t a = 0; a < EnumToInt(VertexAttribute::Max); a++)
+			{
+				const auto& blob = header.m_AttributeBlobs[a];
+				if (blob.m_Size == 0)
+					continue;
+
+				const auto stride = getBufferStride(static_cast<VertexAttribute>(a));
+				if (stride == 0 || blob.m_Size % stride != 0 || (vertexCount > 0 && blob.m_Size / stride != vertexCount))
+					throw AssetError("The cooked static model contains an invalid vertex blob!");
+
+				usedAttributes[a] = true;
+				vertexCount = blob.m_Size / stride;
+			}
+
+			allocateVertexRange(usedAttributes, vertexCount);
+			m_IndexRange = getDevice().as<VulkanDevice>()->getGeometryPool().allocateIndices(header.m_IndexBlob.m_Size);
+
+			// Copy the vertex and index blobs straight to the staging buffers, and upload them using a single transfer.
+			auto vCommandBuffer = VulkanCommandBuffers(getDevicePointerAs<VulkanDevice>());
+			vCommandBuffer.begin();
+
+			std::array<std::shared_ptr<Buffer>, EnumToInt(VertexAttribute::Max)> pStagingBuffers = {};
+			for (uint8_t a = 0; a < EnumToInt(VertexAttribute::Max); a++)
+			{
+				const auto& blob = header.m_AttributeBlobs[a];
+				if (blob.m_Size == 0)
+					continue;
+
+				pStagingBuffers[a] = getDevice().createBuffer(blob.m_Size, BufferUsage::Staging, getBlob(blob));
+				m_VertexRange.m_pStorage->insertBatched(&vCommandBuffer, static_cast<VertexAttribute>(a), pStagingBuffers[a].get(), m_VertexRange.m_Offsets[a]);
+			}
+
+			std::shared_ptr<Buffer> pIndexData = nullptr;
+			if (header.m_IndexBlob.m_Size > 0)
+			{
+				pIndexData = getDevice().createBuffer(header.m_IndexBlob.m_Size, BufferUsage::Staging, getBlob(header.m_IndexBlob));
+				m_IndexRange.m_pBuffer->copyFromBatched(&vCommandBuffer, pIndexData.get(), 0, m_IndexRange.m_Offset);
+			}
+
+			vCommandBuffer.end();
+			vCommandBuffer.submitTransfer();
+
+			// Setup the meshes while the data are being transferred.
+			const auto pMeshEntries = getBlob(header.m_MeshTable);
+			const auto pLevelsOfDetail = getBlob(header.m_LevelOfDetailTable);
+			const auto pMeshlets = getBlob(header.m_MeshletTable);
+			const auto pStrings = reinterpret_cast<const char*>(getBlob(header.m_StringBlob));
+
+			const auto getRange = [](const CookedStaticModel::Range& range, const CookedStaticModel::Blob& blob, uint64_t elementSize)
+			{
+				if (range.m_First > blob.m_Size / elementSize || range.m_Count > blob.m_Size / elementSize - range.m_First)
+					throw AssetError("The cooked static model contains an invalid range!");
+
+				return range.m_First * elementSize;
+			};
+
+			const auto getString = [&getRange, &header, pStrings](const CookedStaticModel::Range& range)
+			{
+				return std::string(pStrings + getRange(range, header.m_StringBlob, 1), range.m_Count);
+			};
+
+			// The meshes are drawn using these, so they must stay within the vertex and index data of the model.
+			const auto validateElements = [](uint64_t first, uint64_t count, uint64_t elementCount)
+			{
+				if (first > elementCount || count > elementCount - first)
+					throw AssetError("The cooked static model contains an invalid mesh!");
+			};
+
+			const bool isInterleaved = m_MemoryType == VertexMemoryType::Interleaved;
+
+			m_Meshes.resize(header.m_MeshCount);
+			for (uint32_t i = 0; i < header.m_MeshCount; i++)
+			{
+				CookedStaticModel::MeshEntry entry;
+				std::memcpy(&entry, pMeshEntries + i * sizeof(CookedStaticModel::MeshEntry), sizeof(CookedStaticModel::MeshEntry));
+
 				auto& mesh = m_Meshes[i];
-				const auto& storage = meshStorages[i];
+				for (uint8_t a = 0; a < EnumToInt(VertexAttribute::Max); a++)
+				{
+					const auto& attributeEntry = entry.m_VertexData[a];
+					auto& attributeData = mesh.m_VertexData[a];
+					attributeData.m_Stride = static_cast<uint8_t>(attributeEntry.m_Stride);
+					attributeData.m_Size = attributeEntry.m_Size;
+					attributeData.m_Offset = attributeEntry.m_Stride > 0 ? m_VertexRange.m_Offsets[isInterleaved ? 0 : a] + attributeEntry.m_Offset : 0;
+				}
+
+				for (uint8_t t = 0; t < EnumToInt(TextureType::Max); t++)
+				{
+					if (entry.m_TexturePaths[t].m_Count > 0)
+						mesh.m_TexturePaths[t] = getString(entry.m_TexturePaths[t]);
+				}
+
+				mesh.m_Name = getString(entry.m_Name);
+
+				mesh.m_PositionOffset = glm::vec3(entry.m_PositionOffset[0], entry.m_PositionOffset[1], entry.m_PositionOffset[2]);
+				mesh.m_PositionScale = glm::vec3(entry.m_PositionScale[0], entry.m_PositionScale[1], entry.m_PositionScale[2]);
+				mesh.m_BoundingCenter = glm::vec3(entry.m_BoundingCenter[0], entry.m_BoundingCenter[1], entry.m_BoundingCenter[2]);
+				mesh.m_BoundingRadius = entry.m_BoundingRadius;
 
-				mesh.m_VertexData[EnumToInt(VertexAttribute::Position)].m_Offset = m_VertexStorage.insert(VertexAttribute::Position, storage.m_pPositionBuffer.get());
-				mesh.m_VertexData[EnumToInt(VertexAttribute::Normal)].m_Offset = m_VertexStorage.insert(VertexAttribute::Normal, storage.m_pNormalBuffer.get());
-				mesh.m_VertexData[EnumToInt(VertexAttribute::Tangent)].m_Offset = m_VertexStorage.insert(VertexAttribute::Tangent, storage.m_pTangentBuffer.get());
-				mesh.m_VertexData[EnumToInt(VertexAttribute::BiTangent)].m_Offset = m_VertexStorage.insert(VertexAttribute::BiTangent, storage.m_pBiTangentBuffer.get());
+				if (entry.m_IndexType > EnumToInt(IndexType::Uint32))
+					throw AssetError("The cooked static model contains an invalid mesh!");
 
-				for (uint32_t t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; t++)
-					mesh.m_VertexData[EnumToInt(Flint::VertexAttribute::Texture0) + t].m_Offset = m_VertexStorage.insert(static_cast<Flint::VertexAttribute>(EnumToInt(Flint::VertexAttribute::Texture0) + t), storage.m_pTextureBuffers[t].get());
+				const auto indexSize = entry.m_IndexType == EnumToInt(IndexType::Uint16) ? sizeof(uint16_t) : sizeof(uint32_t);
+				validateElements(entry.m_VertexOffset, entry.m_VertexCount, vertexCount);
+				validateElements(entry.m_IndexOffset, entry.m_IndexCount, header.m_IndexBlob.m_Size / indexSize);
+
+				mesh.m_VertexCount = entry.m_VertexCount;
+				mesh.m_VertexOffset = m_VertexRange.m_FirstVertex + entry.m_VertexOffset;
+				mesh.m_IndexType = static_cast<IndexType>(entry.m_IndexType);
+				mesh.m_IndexOffset = m_IndexRange.m_Offset / (mesh.m_IndexType == IndexType::Uint16 ? sizeof(uint16_t) : sizeof(uint32_t)) + entry.m_IndexOffset;
+				mesh.m_IndexCount = entry.m_IndexCount;
+
+				mesh.m_UnoptimizedCacheStatistics = entry.m_UnoptimizedCacheStatistics;
+				mesh.m_CacheStatistics = entry.m_CacheStatistics;
+
+				const auto levelOffset = getRange(entry.m_LevelsOfDetail, header.m_LevelOfDetailTable, sizeof(CookedStaticModel::LevelOfDetailEntry));
+				mesh.m_LevelsOfDetail.resize(entry.m_LevelsOfDetail.m_Count);
+				for (uint64_t l = 0; l < entry.m_LevelsOfDetail.m_Count; l++)
+				{
+					CookedStaticModel::LevelOfDetailEntry levelEntry;
+					std::memcpy(&levelEntry, pLevelsOfDetail + levelOffset + l * sizeof(CookedStaticModel::LevelOfDetailEntry), sizeof(CookedStaticModel::LevelOfDetailEntry));
+					validateElements(levelEntry.m_IndexOffset, levelEntry.m_IndexCount, header.m_IndexBlob.m_Size / indexSize - entry.m_IndexOffset);
+
+					mesh.m_LevelsOfDetail[l] = StaticMesh::LevelOfDetail(levelEntry.m_IndexOffset, levelEntry.m_IndexCount, levelEntry.m_Error);
+				}
 
-				for (uint32_t c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; c++)
-					mesh.m_VertexData[EnumToInt(Flint::VertexAttribute::Color0) + c].m_Offset = m_VertexStorage.insert(static_cast<Flint::VertexAttribute>(EnumToInt(Flint::VertexAttribute::Color0) + c), storage.m_pColorBuffers[c].get());
+				const auto meshletOffset = getRange(entry.m_Meshlets, header.m_MeshletTable, sizeof(Meshlet));
+				mesh.m_Meshlets.resize(entry.m_Meshlets.m_Count);
+				std::memcpy(mesh.m_Meshlets.data(), pMeshlets + meshletOffset, entry.m_Meshlets.m_Count * sizeof(Meshlet));
 			}
 
-			// Finally, copy the index data to a staging buffer, and copy it to the final index buffer.
-			auto pIndexData = getDevice().createBuffer(indices.size() * sizeof(uint32_t), BufferUsage::Staging, reinterpret_cast<const std::byte*>(indices.data()));
+			vCommandBuffer.finishExecution();
+		}
+
+		void VulkanStaticModel::setupInterleavedLayout(const std::array<bool, EnumToInt(VertexAttribute::Max)>& usedAttributes)
+		{
+			OPTICK_EVENT();
+
+			m_AttributeOffsets.fill(InvalidAttributeOffset);
+			m_VertexStride = 0;
+
+			const auto packAttribute = [this](VertexAttribute attribute)
+			{
+				auto& offset = m_AttributeOffsets[EnumToInt(attribute)];
+				if (offset != InvalidAttributeOffset)
+					return;
 
-			m_pIndexBuffer = std::static_pointer_cast<VulkanBuffer>(getDevice().createBuffer(pIndexData->getSize(), BufferUsage::Index));
-			m_pIndexBuffer->copyFrom(pIndexData.get(), 0, 0);
+				offset = m_VertexStride;
+				m_VertexStride += GetAttributeStride(attribute, m_FormatProfile);
+			};
 
-			// TODO: Export everything to our own optimized binary.
+			// If a layout is not specified, we pack all the attributes used by the asset.
+			if (m_VertexLayout.empty())
+			{
+				for (uint8_t a = 0; a < EnumToInt(VertexAttribute::Max); a++)
+				{
+					if (usedAttributes[a])
+						packAttribute(static_cast<VertexAttribute>(a));
+				}
+			}
+			else
+			{
+				for (const auto input : m_VertexLayout)
+					packAttribute(input.m_Attribute);
+			}
 		}
 	}
 }
\ No newline at end of file
@@ -141,6 +141,10 @@ namespace Flint
 
 			FLINT_VK_ASSERT(pDevice->getDeviceTable().vkCreateSampler(pDevice->getLogicalDevice(), &createInfo, nullptr, &m_Sampler), "Failed to create the sampler!");
 
+			// Register the sampler in the bindless descriptor if possible.
+			if (pDevice->isBindlessSupported())
+				m_BindlessIndex = pDevice->getBindlessDescriptor()->registerSampler(m_Sampler);
+
 			validate();
 		}
 
@@ -153,6 +157,9 @@ namespace Flint
 		{
 			OPTICK_EVENT();
 
+			if (m_BindlessIndex != InvalidBindlessIndex)
+				getDevice().as<VulkanDevice>()->getBindlessDescriptor()->release(BindlessResourceType::Sampler, m_BindlessIndex);
+
 			getDevice().as<VulkanDevice>()->getDeviceTable().vkDestroySampler(getDevice().as<VulkanDevice>()->getLogicalDevice(), m_Sampler, nullptr);
 			invalidate();
 		}
@@ -34,6 +34,10 @@ namespace Flint
 
 			FLINT_VK_ASSERT(pDevice->getDeviceTable().vkCreateImageView(pDevice->getLogicalDevice(), &createInfo, nullptr, &m_ImageView), "Failed to create the image view!");
 
+			// Register the view in the bindless descriptor if it can be sampled.
+			if (pDevice->isBindlessSupported() && pTexture->getImageUsage() & ImageUsage::Graphics)
+				m_BindlessIndex = pDevice->getBindlessDescriptor()->registerImage(m_ImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
 			validate();
 		}
 
@@ -46,6 +50,9 @@ namespace Flint
 		{
 			OPTICK_EVENT();
 
+			if (m_BindlessIndex != InvalidBindlessIndex)
+				getDevice().as<VulkanDevice>()->getBindlessDescriptor()->release(BindlessResourceType::SampledImage, m_BindlessIndex);
+
 			getDevice().as<VulkanDevice>()->getDeviceTable().vkDestroyImageView(getDevice().as<VulkanDevice>()->getLogicalDevice(), m_ImageView, nullptr);
 			invalidate();
 		}
@@ -12,8 +12,8 @@ namespace Flint
 {
 	namespace Backend
 	{
-		VulkanVertexStorage::VulkanVertexStorage(const std::shared_ptr<VulkanDevice>& pDevice)
-			: VertexStorage(pDevice)
+		VulkanVertexStorage::VulkanVertexStorage(const std::shared_ptr<VulkanDevice>& pDevice, VertexMemoryType memoryType /*= VertexMemoryType::Exclusive*/)
+			: VertexStorage(pDevice, memoryType)
 		{
 			validate();
 		}
@@ -49,7 +49,7 @@ namespace Flint
 			if (!pStaggingBuffer)
 				return 0;
 
-			return m_pBuffers[EnumToInt(attribute)].apply([this, pStaggingBuffer](std::shared_ptr<VulkanBuffer>& pOldBuffer)
+			return m_pBuffers[getBufferIndex(attribute)].apply([this, pStaggingBuffer](std::shared_ptr<VulkanBuffer>& pOldBuffer)
 				{
 					uint64_t offset = 0;
 
@@ -85,5 +85,53 @@ namespace Flint
 				}
 			);
 		}
+
+		uint64_t VulkanVertexStorage::reserve(VertexAttribute attribute, uint64_t size)
+		{
+			OPTICK_EVENT();
+
+			// Skip if we don't have anything to reserve.
+			if (size == 0)
+				return 0;
+
+			return m_pBuffers[getBufferIndex(attribute)].apply([this, size](std::shared_ptr<VulkanBuffer>& pOldBuffer)
+				{
+					uint64_t offset = 0;
+
+					// If a buffer already exists, we need to move the content from the old buffer to the new one. If not let's just create a new one.
+					if (pOldBuffer)
+					{
+						offset = pOldBuffer->getSize();
+
+						auto pNewBuffer = std::static_pointer_cast<VulkanBuffer>(getDevice().createBuffer(offset + size, BufferUsage::Vertex));
+						pNewBuffer->copyFrom(pOldBuffer.get());
+
+						pOldBuffer = std::move(pNewBuffer);
+					}
+					else
+						pOldBuffer = std::static_pointer_cast<VulkanBuffer>(getDevice().createBuffer(size, BufferUsage::Vertex));
+
+					return offset;
+				}
+			);
+		}
+
+		void VulkanVertexStorage::insertBatched(VulkanCommandBuffers* pCommandBuffer, VertexAttribute attribute, const Buffer* pStaggingBuffer, uint64_t offset)
+		{
+			OPTICK_EVENT();
+
+			// Skip if we don't have anything to copy.
+			if (!pStaggingBuffer)
+				return;
+
+			m_pBuffers[getBufferIndex(attribute)].apply([pCommandBuffer, pStaggingBuffer, offset](std::shared_ptr<VulkanBuffer>& pBuffer)
+				{
+					if (!pBuffer)
+						throw BackendError("Cannot insert data without reserving the space first!");
+
+					pBuffer->copyFromBatched(pCommandBuffer, pStaggingBuffer, 0, offset);
+				}
+			);
+		}
 	}
 }
\ No newline at end of file